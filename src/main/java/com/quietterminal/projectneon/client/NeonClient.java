@@ -11,9 +11,11 @@ import java.time.Duration;
 import java.util.List;
 import java.util.Optional;
 import java.util.concurrent.CopyOnWriteArrayList;
+import java.util.concurrent.atomic.AtomicInteger;
 import java.util.concurrent.atomic.AtomicReference;
 import java.util.function.BiConsumer;
 import java.util.function.Consumer;
+import java.util.function.Supplier;
 import java.util.logging.Level;
 import java.util.logging.Logger;
 
@@ -29,6 +31,14 @@ public class NeonClient implements AutoCloseable, Lifecycle {
         LoggerConfig.configureLogger(logger);
     }
 
+    /**
+     * Retry denies answered per connect attempt; a relay that keeps rejecting
+     * echoed cookies is treated as a plain deny.
+     */
+    private static final int MAX_COOKIE_RETRIES = 2;
+
+    private final Supplier<? extends Transport> transportFactory;
+    private final boolean canReopenTransport;
     private NeonSocket socket;
     private final NeonConfig config;
     private final String name;
@@ -36,7 +46,11 @@ public class NeonClient implements AutoCloseable, Lifecycle {
     private Byte clientId;
     private Integer sessionId;
     private Long sessionToken;
-    private short nextSequence = 0;
+    private final AtomicInteger nextSequence = new AtomicInteger();
+    private volatile byte headerVersion = PacketHeader.VERSION;
+    private volatile long connectionId = 0;
+    private final PathMtuDiscovery pathMtu;
+    private long nextProbeId = -1;
 
     private boolean autoPing = true;
     private long pingIntervalMs;
@@ -48,6 +62,7 @@ public class NeonClient implements AutoCloseable, Lifecycle {
     private BiConsumer<Byte, Byte> unhandledPacketCallback;
     private BiConsumer<Byte, Byte> wrongDestinationCallback;
     private Consumer<Byte> disconnectCallback;
+    private volatile GameMessageRings messageRings;
 
     private final AtomicReference<Lifecycle.State> lifecycleState = new AtomicReference<>(Lifecycle.State.CREATED);
     private final List<Lifecycle.StateChangeListener> stateChangeListeners = new CopyOnWriteArrayList<>();
@@ -66,6 +81,35 @@ public class NeonClient implements AutoCloseable, Lifecycle {
      * Creates a client with custom configuration.
      */
     public NeonClient(String name, NeonConfig config) throws IOException {
+        this(name, config, null, null);
+    }
+
+    /**
+     * Creates a client that reaches the relay over the given bound transport, which it
+     * takes ownership of and closes on close(). A closed transport cannot be reopened, so
+     * {@link #reconnect(int)} is unsupported; use the factory constructor to reconnect.
+     *
+     * @param transport the transport, or null to open a UDP socket on an ephemeral port
+     * @since 1.3
+     */
+    public NeonClient(String name, NeonConfig config, Transport transport) throws IOException {
+        this(name, config, transport, null);
+    }
+
+    /**
+     * Creates a client that obtains its transport from a factory. The factory is called
+     * once now and again for every reconnect attempt after the previous transport was
+     * closed, and must return a new bound transport each time.
+     *
+     * @param transportFactory supplies fresh transports
+     * @since 1.3
+     */
+    public NeonClient(String name, NeonConfig config, Supplier<? extends Transport> transportFactory) throws IOException {
+        this(name, config, null, requireFactory(transportFactory));
+    }
+
+    private NeonClient(String name, NeonConfig config, Transport transport,
+                       Supplier<? extends Transport> transportFactory) throws IOException {
         if (config == null) {
             throw new IllegalArgumentException("config cannot be null");
         }
@@ -73,10 +117,34 @@ public class NeonClient implements AutoCloseable, Lifecycle {
 
         this.name = name;
         this.config = config;
-        this.socket = new NeonSocket(config);
+        this.transportFactory = transportFactory;
+        this.canReopenTransport = transport == null;
+        this.socket = transport != null ? new NeonSocket(transport, config) : openSocket();
         this.socket.setBlocking(true);
         this.socket.setSoTimeout(config.getClientSocketTimeoutMs());
         this.pingIntervalMs = config.getClientPingIntervalMs();
+        this.pathMtu = config.isPathMtuDiscoveryEnabled() ? PathMtuDiscovery.fromConfig(config) : null;
+    }
+
+    private static Supplier<? extends Transport> requireFactory(Supplier<? extends Transport> transportFactory) {
+        if (transportFactory == null) {
+            throw new IllegalArgumentException("transportFactory cannot be null");
+        }
+        return transportFactory;
+    }
+
+    /**
+     * Opens a socket on a transport from the factory, or on a new UDP socket without one.
+     */
+    private NeonSocket openSocket() throws IOException {
+        if (transportFactory == null) {
+            return new NeonSocket(config);
+        }
+        Transport transport = transportFactory.get();
+        if (transport == null || transport.isClosed()) {
+            throw new IOException("Transport factory did not supply an open transport");
+        }
+        return new NeonSocket(transport, config);
     }
 
     /**
@@ -98,12 +166,16 @@ public class NeonClient implements AutoCloseable, Lifecycle {
         socket.setSoTimeout(config.getClientConnectionTimeoutMs());
 
         PacketPayload.ConnectRequest request = new PacketPayload.ConnectRequest(
-            PacketHeader.VERSION, name, sessionId, 0
-        );
-        NeonPacket packet = NeonPacket.create(
-            PacketType.CONNECT_REQUEST, nextSequence++, (byte) 0, (byte) 1, request
+            (byte) config.getMaxHeaderVersion(), name, sessionId, 0
         );
+        KeyExchange keyExchange = null;
+        if (SessionCipher.Suite.fromConfigName(config.getSessionEncryption()) != null) {
+            keyExchange = new KeyExchange();
+            request = request.withKeyShare(keyExchange.publicKey());
+        }
+        NeonPacket packet = frame(PacketType.CONNECT_REQUEST, (byte) 0, (byte) 1, request);
         socket.sendPacket(packet, relayAddr);
+        int cookieRetries = 0;
 
         try {
             while (true) {
@@ -111,13 +183,20 @@ public class NeonClient implements AutoCloseable, Lifecycle {
                 if (received == null) continue;
 
                 if (received.packet().payload() instanceof PacketPayload.ConnectAccept accept) {
+                    if (keyExchange != null && !installSessionCipher(keyExchange, accept)) {
+                        return false;
+                    }
                     this.clientId = accept.assignedClientId();
                     this.sessionId = accept.sessionId();
                     this.sessionToken = accept.sessionToken();
+                    if (received.packet().isV2()) {
+                        this.connectionId = received.packet().headerV2().connectionId();
+                    }
 
-                    NeonPacket confirmation = NeonPacket.create(
-                        PacketType.CONNECT_ACCEPT, nextSequence++, clientId, (byte) 0, accept
+                    PacketPayload.ConnectAccept echo = new PacketPayload.ConnectAccept(
+                        accept.assignedClientId(), accept.sessionId(), accept.sessionToken()
                     );
+                    NeonPacket confirmation = frame(PacketType.CONNECT_ACCEPT, clientId, (byte) 0, echo);
                     socket.sendPacket(confirmation, relayAddr);
 
                     socket.setSoTimeout(config.getClientSocketTimeoutMs());
@@ -127,6 +206,12 @@ public class NeonClient implements AutoCloseable, Lifecycle {
                 }
 
                 if (received.packet().payload() instanceof PacketPayload.ConnectDeny deny) {
+                    if (deny.isRetry() && cookieRetries++ < MAX_COOKIE_RETRIES) {
+                        NeonPacket retry = frame(PacketType.CONNECT_REQUEST, (byte) 0, (byte) 1,
+                            request.withRetryCookie(deny.retryCookie()));
+                        socket.sendPacket(retry, relayAddr);
+                        continue;
+                    }
                     logger.log(Level.WARNING, "Connection denied: {0} [SessionID={1}, ClientName={2}]",
                         new Object[]{deny.reason(), sessionId, name});
                     return false;
@@ -138,11 +223,37 @@ public class NeonClient implements AutoCloseable, Lifecycle {
         }
     }
 
+    /**
+     * Opens the session key from the host's accept and installs the cipher on the socket.
+     *
+     * @return false if the host did not agree to encrypt the session or the key is invalid
+     */
+    private boolean installSessionCipher(KeyExchange keyExchange, PacketPayload.ConnectAccept accept) {
+        if (accept.keyShare().length == 0) {
+            logger.log(Level.WARNING, "Host did not enable encryption [SessionID={0}]", accept.sessionId());
+            return false;
+        }
+        try {
+            socket.setSessionCipher(keyExchange.openAcceptShare(
+                accept.keyShare(), accept.sessionId(), accept.assignedClientId()));
+            return true;
+        } catch (IllegalArgumentException e) {
+            logger.log(Level.WARNING, "Invalid session key from host: {0} [SessionID={1}]",
+                new Object[]{e.getMessage(), accept.sessionId()});
+            return false;
+        }
+    }
+
     /**
      * Processes incoming packets. Should be called regularly in the game loop.
      * Returns the number of packets processed.
      */
     public int processPackets() throws IOException {
+        GameMessageRings rings = messageRings;
+        if (rings != null && clientId != null) {
+            rings.drainOutgoing(this::sendRingMessage);
+        }
+
         int count = 0;
         while (true) {
             try {
@@ -164,6 +275,10 @@ public class NeonClient implements AutoCloseable, Lifecycle {
             }
         }
 
+        if (pathMtu != null && clientId != null) {
+            probePathMtu();
+        }
+
         return count;
     }
 
@@ -185,6 +300,12 @@ public class NeonClient implements AutoCloseable, Lifecycle {
                 }
             }
             case PacketPayload.SessionConfig config -> {
+                if (config.hasFlag(PacketPayload.SessionConfig.FLAG_CHECKSUM)) {
+                    socket.setChecksumEnabled(true);
+                }
+                if (config.version() == PacketHeaderV2.VERSION && this.config.getMaxHeaderVersion() >= PacketHeaderV2.VERSION) {
+                    headerVersion = PacketHeaderV2.VERSION;
+                }
                 if (sessionConfigCallback != null) {
                     sessionConfigCallback.accept(config.version(), config.tickRate(), config.maxPacketSize());
                 }
@@ -198,12 +319,21 @@ public class NeonClient implements AutoCloseable, Lifecycle {
             case PacketPayload.Ping ping -> {
                 sendPong(ping.timestamp());
             }
+            case PacketPayload.MtuProbe probe -> {
+                if (pathMtu != null && header.packetType() == PacketType.PONG.getValue()) {
+                    pathMtu.onProbeConfirmed(probe.probeId());
+                }
+            }
             case PacketPayload.DisconnectNotice ignored -> {
                 if (disconnectCallback != null) {
                     disconnectCallback.accept(header.clientId());
                 }
             }
             default -> {
+                GameMessageRings rings = messageRings;
+                if (rings != null) {
+                    rings.deliver(header.packetType(), header.clientId(), packet.payload().toBytes());
+                }
                 if (unhandledPacketCallback != null) {
                     unhandledPacketCallback.accept(header.packetType(), header.clientId());
                 }
@@ -220,30 +350,168 @@ public class NeonClient implements AutoCloseable, Lifecycle {
         }
         long timestamp = System.currentTimeMillis();
         PacketPayload.Ping ping = new PacketPayload.Ping(timestamp);
-        NeonPacket packet = NeonPacket.create(
-            PacketType.PING, nextSequence++, clientId, (byte) 1, ping
-        );
+        NeonPacket packet = frame(PacketType.PING, clientId, (byte) 1, ping);
         socket.sendPacket(packet, relayAddr);
     }
 
+    /**
+     * Sends a game packet. The relay forwards it to {@code destinationId}, or to every other
+     * session member when the destination is 0. Safe to call from any thread.
+     *
+     * <p>With path MTU discovery enabled the payload must fit {@link #getMaxPayloadSize()}:
+     * datagrams are sent with the don't-fragment bit, so a larger one would be dropped on
+     * the path rather than fragmented.
+     *
+     * @param packetType a game packet type, {@code 0x10} or above
+     * @throws PayloadSizeEnforcer.PayloadSizeException if the payload exceeds the path MTU
+     */
+    public void sendGamePacket(byte packetType, byte destinationId, byte[] payload) throws IOException {
+        if (payload == null) {
+            throw new IllegalArgumentException("payload cannot be null");
+        }
+        sendGamePacket(packetType, destinationId, payload, 0, payload.length);
+    }
+
+    /**
+     * Sends {@code length} bytes of {@code buffer} starting at {@code offset} as a game packet.
+     * The bytes are copied straight into the outgoing datagram.
+     */
+    public void sendGamePacket(byte packetType, byte destinationId, byte[] buffer, int offset, int length) throws IOException {
+        if (clientId == null) {
+            throw new IllegalStateException("Not connected");
+        }
+        if ((packetType & 0xFF) < PacketType.GAME_PACKET.getValue()) {
+            throw new IllegalArgumentException("Game packet types start at 0x10, got: " + packetType);
+        }
+        if (pathMtu != null && length > getMaxPayloadSize()) {
+            throw new PayloadSizeEnforcer.PayloadSizeException(String.format(
+                "Payload too large: %d bytes (maximum: %d)", length, getMaxPayloadSize()));
+        }
+        int sequence = nextSequence.getAndIncrement();
+        byte[] data;
+        if (headerVersion == PacketHeaderV2.VERSION) {
+            PacketHeaderV2 headerV2 = PacketHeaderV2.create(
+                packetType, sequence, clientId & 0xFF, destinationId & 0xFF
+            ).withConnectionId(connectionId);
+            data = NeonPacket.encode(null, headerV2, buffer, offset, length);
+        } else {
+            PacketHeader header = PacketHeader.create(packetType, (short) sequence, clientId, destinationId);
+            data = NeonPacket.encode(header, null, buffer, offset, length);
+        }
+        socket.sendEncoded(data, relayAddr);
+    }
+
+    /**
+     * Attaches rings through which an engine sends and receives game packets without a call
+     * per message. Outgoing messages are sent from {@link #processPackets()}; every received
+     * game packet is appended to the incoming ring in addition to the unhandled packet callback.
+     *
+     * @param rings the rings, or null to detach
+     */
+    public void setMessageRings(GameMessageRings rings) {
+        this.messageRings = rings;
+    }
+
+    /**
+     * Sends one message drained from the outgoing ring, dropping it if it exceeds the path
+     * MTU so one oversized message does not stall the rest of the ring.
+     */
+    private void sendRingMessage(byte packetType, byte destinationId, byte[] buffer, int offset, int length)
+            throws IOException {
+        try {
+            sendGamePacket(packetType, destinationId, buffer, offset, length);
+        } catch (PayloadSizeEnforcer.PayloadSizeException e) {
+            logger.log(Level.WARNING, "Dropped outgoing ring message: {0}", e.getMessage());
+        }
+    }
+
     private void sendPong(long originalTimestamp) throws IOException {
         if (clientId == null) return;
         PacketPayload.Pong pong = new PacketPayload.Pong(originalTimestamp);
-        NeonPacket packet = NeonPacket.create(
-            PacketType.PONG, nextSequence++, clientId, (byte) 1, pong
-        );
+        NeonPacket packet = frame(PacketType.PONG, clientId, (byte) 1, pong);
         socket.sendPacket(packet, relayAddr);
     }
 
     private void sendAck(short sequence) throws IOException {
         if (clientId == null) return;
         PacketPayload.Ack ack = new PacketPayload.Ack(java.util.List.of(sequence));
-        NeonPacket packet = NeonPacket.create(
-            PacketType.ACK, nextSequence++, clientId, (byte) 1, ack
-        );
+        NeonPacket packet = frame(PacketType.ACK, clientId, (byte) 1, ack);
         socket.sendPacket(packet, relayAddr);
     }
 
+    /**
+     * Sends the next path MTU probe if one is due. The probe is a PING padded to the
+     * probe size; it is confirmed when the host's equally sized PONG echo comes back.
+     */
+    private void probePathMtu() throws IOException {
+        long now = System.currentTimeMillis();
+        int probeSize = pathMtu.nextProbeSize(now);
+        if (probeSize == 0) {
+            return;
+        }
+
+        long probeId = nextProbeId--;
+        NeonPacket probe = frame(PacketType.PING, clientId, (byte) 1, new PacketPayload.MtuProbe(probeId, 0));
+        int overhead = (probe.isV2() ? probe.headerV2().encodedSize() : PacketHeader.HEADER_SIZE) + 8
+            + (socket.isChecksumEnabled() ? PacketChecksum.TRAILER_SIZE : 0);
+        NeonPacket padded = new NeonPacket(probe.header(),
+            new PacketPayload.MtuProbe(probeId, Math.max(0, probeSize - overhead)), probe.headerV2());
+
+        try {
+            socket.sendPacket(padded, relayAddr);
+            pathMtu.onProbeSent(probeId, now);
+        } catch (java.net.SocketException e) {
+            logger.log(Level.FINE, "Path MTU probe of {0} bytes could not be sent: {1}",
+                new Object[]{probeSize, e.getMessage()});
+            pathMtu.onProbeTooLarge();
+        }
+    }
+
+    /**
+     * Gets the largest datagram size confirmed for the path to the host, or
+     * {@link PayloadSizeEnforcer#MTU_SAFE_PAYLOAD} when path MTU discovery is disabled.
+     */
+    public int getPathMtu() {
+        return pathMtu != null ? pathMtu.getPathMtu() : PayloadSizeEnforcer.MTU_SAFE_PAYLOAD;
+    }
+
+    /**
+     * Gets the largest payload that fits in a single datagram on the path to the host,
+     * accounting for the negotiated header version and checksum trailer. Use this to
+     * decide how much game data to coalesce into one packet or when to fragment.
+     */
+    public int getMaxPayloadSize() {
+        int overhead = (headerVersion == PacketHeaderV2.VERSION ? PacketHeaderV2.MAX_FIXED_HEADER_SIZE : PacketHeader.HEADER_SIZE)
+            + (socket.isChecksumEnabled() ? PacketChecksum.TRAILER_SIZE : 0);
+        return getPathMtu() - overhead;
+    }
+
+    /**
+     * Builds an outgoing packet using the header version negotiated with the host. Version 2
+     * packets carry the relay-assigned connection id so the relay can follow address changes.
+     */
+    private NeonPacket frame(PacketType type, byte sourceId, byte destinationId, PacketPayload payload) {
+        return frame(type.getValue(), sourceId, destinationId, payload);
+    }
+
+    private NeonPacket frame(byte type, byte sourceId, byte destinationId, PacketPayload payload) {
+        int sequence = nextSequence.getAndIncrement();
+        if (headerVersion == PacketHeaderV2.VERSION) {
+            PacketHeaderV2 headerV2 = PacketHeaderV2.create(
+                type, sequence, sourceId & 0xFF, destinationId & 0xFF
+            ).withConnectionId(connectionId);
+            return new NeonPacket(headerV2.toV1(), payload, headerV2);
+        }
+        return new NeonPacket(PacketHeader.create(type, (short) sequence, sourceId, destinationId), payload);
+    }
+
+    /**
+     * Gets the header version negotiated with the host (1 until a SessionConfig selects 2).
+     */
+    public byte getHeaderVersion() {
+        return headerVersion;
+    }
+
     @Override
     public Lifecycle.State getState() {
         return lifecycleState.get();
@@ -448,7 +716,8 @@ public class NeonClient implements AutoCloseable, Lifecycle {
 
     /**
      * Attempts to reconnect to the session using the stored session token.
-     * Uses exponential backoff with configurable max attempts.
+     * Uses exponential backoff with configurable max attempts. Each attempt opens a new
+     * socket, so a client built on a single supplied transport returns false at once.
      *
      * @param maxAttempts Maximum number of reconnection attempts
      * @return true if reconnection succeeded, false otherwise
@@ -465,6 +734,13 @@ public class NeonClient implements AutoCloseable, Lifecycle {
             return false;
         }
 
+        if (!canReopenTransport) {
+            logger.log(Level.WARNING, "Cannot reconnect: the supplied transport is closed; construct the client "
+                + "with a transport factory to reconnect [SessionID={0}, ClientID={1}]",
+                new Object[]{sessionId, clientId});
+            return false;
+        }
+
         int attempt = 0;
         int delayMs = config.getClientInitialReconnectDelayMs();
 
@@ -504,8 +780,15 @@ public class NeonClient implements AutoCloseable, Lifecycle {
 
     private boolean attemptReconnect() throws IOException {
         if (socket.isClosed()) {
-            socket = new NeonSocket(config);
+            boolean checksumEnabled = socket.isChecksumEnabled();
+            SessionCipher cipher = socket.getSessionCipher();
+            socket = openSocket();
             socket.setBlocking(true);
+            socket.setChecksumEnabled(checksumEnabled);
+            socket.setSessionCipher(cipher);
+            if (pathMtu != null) {
+                pathMtu.reset();
+            }
         }
 
         socket.setSoTimeout(config.getClientConnectionTimeoutMs());
@@ -513,9 +796,7 @@ public class NeonClient implements AutoCloseable, Lifecycle {
         PacketPayload.ReconnectRequest request = new PacketPayload.ReconnectRequest(
             sessionToken, sessionId, clientId
         );
-        NeonPacket packet = NeonPacket.create(
-            PacketType.RECONNECT_REQUEST, nextSequence++, clientId, (byte) 1, request
-        );
+        NeonPacket packet = frame(PacketType.RECONNECT_REQUEST, clientId, (byte) 1, request);
         socket.sendPacket(packet, relayAddr);
 
         try {
@@ -579,9 +860,7 @@ public class NeonClient implements AutoCloseable, Lifecycle {
         if (clientId != null && relayAddr != null) {
             try {
                 PacketPayload.DisconnectNotice notice = new PacketPayload.DisconnectNotice();
-                NeonPacket packet = NeonPacket.create(
-                    PacketType.DISCONNECT_NOTICE, nextSequence++, clientId, (byte) 0, notice
-                );
+                NeonPacket packet = frame(PacketType.DISCONNECT_NOTICE, clientId, (byte) 0, notice);
                 socket.sendPacket(packet, relayAddr);
                 Thread.sleep(config.getClientDisconnectNoticeDelayMs());
             } catch (IOException e) {
@@ -0,0 +1,126 @@
+package com.quietterminal.projectneon.core;
+
+import java.net.SocketAddress;
+import java.util.Collection;
+import java.util.HashSet;
+import java.util.Set;
+
+/**
+ * Bounds the bytes sent to sources that have not proven they can receive replies.
+ *
+ * <p>Each unverified source earns {@code factor} bytes of response budget for every byte
+ * received from it, and sends beyond that budget are refused. A spoofed datagram can
+ * therefore never make the owner send more than {@code factor} times its size to the
+ * spoofed victim. Verified sources are unrestricted.
+ *
+ * <p>State is kept per {@link SourceAddressTable} slot in plain arrays. Sources that could
+ * not be interned have no budget; only an explicit verification lets traffic reach them.
+ *
+ * <p>Not thread-safe: drive it from the thread that owns the socket.
+ *
+ * @since 1.3
+ */
+public final class AmplificationLimiter {
+
+    private final int factor;
+    private final long[] budget;
+    private final boolean[] verified;
+    private final Set<SocketAddress> verifiedUntracked = new HashSet<>();
+
+    /**
+     * Creates a limiter for a source table of the given capacity.
+     *
+     * @param capacity the source table capacity
+     * @param factor bytes of budget earned per byte received
+     */
+    public AmplificationLimiter(int capacity, int factor) {
+        if (capacity <= 0) {
+            throw new IllegalArgumentException("capacity must be positive, got: " + capacity);
+        }
+        if (factor <= 0) {
+            throw new IllegalArgumentException("factor must be positive, got: " + factor);
+        }
+        this.factor = factor;
+        this.budget = new long[capacity];
+        this.verified = new boolean[capacity];
+    }
+
+    /**
+     * Credits the budget of a source for a received datagram.
+     *
+     * @param slot the source slot, or -1 if the source is not interned
+     * @param bytes the datagram size
+     */
+    public void onReceived(int slot, int bytes) {
+        if (slot >= 0 && !verified[slot]) {
+            budget[slot] += (long) bytes * factor;
+        }
+    }
+
+    /**
+     * Checks whether a datagram may be sent and charges it against the budget.
+     *
+     * @param slot the destination slot, or -1 if the destination is not interned
+     * @param address the destination address
+     * @param bytes the datagram size
+     * @return true if the datagram may be sent
+     */
+    public boolean trySend(int slot, SocketAddress address, int bytes) {
+        if (slot < 0) {
+            return verifiedUntracked.contains(address);
+        }
+        if (verified[slot]) {
+            return true;
+        }
+        if (budget[slot] < bytes) {
+            return false;
+        }
+        budget[slot] -= bytes;
+        return true;
+    }
+
+    /**
+     * Lifts the budget for a source that has proven it can receive replies.
+     *
+     * @param slot the source slot, or -1 if the source is not interned
+     * @param address the source address
+     */
+    public void markVerified(int slot, SocketAddress address) {
+        if (slot >= 0) {
+            verified[slot] = true;
+        } else {
+            verifiedUntracked.add(address);
+        }
+    }
+
+    /**
+     * Checks whether a slot has been verified.
+     */
+    public boolean isVerified(int slot) {
+        return verified[slot];
+    }
+
+    /**
+     * Gets the remaining response budget of a slot in bytes.
+     */
+    public long getBudget(int slot) {
+        return budget[slot];
+    }
+
+    /**
+     * Clears the state of a slot when it is released for reuse.
+     */
+    public void reset(int slot) {
+        budget[slot] = 0;
+        verified[slot] = false;
+    }
+
+    /**
+     * Drops verifications of non-interned sources that are no longer active.
+     *
+     * @param active the addresses to keep
+     */
+    public void retainVerified(Collection<? extends SocketAddress> active) {
+        verifiedUntracked.retainAll(active);
+    }
+}
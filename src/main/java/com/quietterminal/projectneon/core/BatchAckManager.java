@@ -11,7 +11,7 @@ import java.util.concurrent.ConcurrentLinkedQueue;
  * Collects multiple ACK sequence numbers and sends them in a single packet.
  */
 public class BatchAckManager {
-    private final NeonSocket socket;
+    private final Transport transport;
     private final SocketAddress relayAddr;
     private final byte clientId;
     private final ConcurrentLinkedQueue<Short> pendingAcks;
@@ -22,15 +22,15 @@ public class BatchAckManager {
     /**
      * Creates a batch ACK manager.
      *
-     * @param socket the socket to send ACKs through
+     * @param transport the transport to send ACKs through, usually a {@link NeonSocket}
      * @param relayAddr the relay address
      * @param clientId the client ID sending ACKs
      * @param maxBatchSize maximum number of ACKs to batch
      * @param maxBatchDelayMs maximum time to wait before flushing
      */
-    public BatchAckManager(NeonSocket socket, SocketAddress relayAddr, byte clientId,
+    public BatchAckManager(Transport transport, SocketAddress relayAddr, byte clientId,
                           int maxBatchSize, long maxBatchDelayMs) {
-        this.socket = socket;
+        this.transport = transport;
         this.relayAddr = relayAddr;
         this.clientId = clientId;
         this.maxBatchSize = maxBatchSize;
@@ -88,7 +88,7 @@ public class BatchAckManager {
             NeonPacket packet = NeonPacket.create(
                 PacketType.ACK, (short) 0, clientId, (byte) 1, ack
             );
-            socket.sendPacket(packet, relayAddr);
+            transport.sendPacket(packet, relayAddr);
             lastFlushTime = System.currentTimeMillis();
         }
 
@@ -0,0 +1,214 @@
+package com.quietterminal.projectneon.core;
+
+import java.net.InetAddress;
+import java.net.UnknownHostException;
+import java.util.Arrays;
+
+/**
+ * Allow/block lists of IPv4 and IPv6 CIDR prefixes, matched with a binary prefix trie.
+ *
+ * <p>Both lists are merged into one trie per address family and the longest matching
+ * prefix decides, so a narrower allow can carve an exception out of a wider block and
+ * vice versa. When the same prefix appears in both lists, block wins. Addresses that match
+ * no prefix are allowed if the allow list is empty, and dropped otherwise.
+ *
+ * <p>The trie lives in flat int arrays and a lookup walks at most 32 or 128 nodes without
+ * allocating, so it can run on every datagram. Instances are immutable and thread-safe;
+ * reloading a list means building a new filter and swapping the reference.
+ *
+ * @since 1.3
+ */
+public final class CidrFilter {
+
+    private static final byte NONE = 0;
+    private static final byte ALLOW = 1;
+    private static final byte BLOCK = 2;
+
+    private final Trie ipv4;
+    private final Trie ipv6;
+    private final boolean defaultAllow;
+    private final int prefixCount;
+
+    private CidrFilter(Trie ipv4, Trie ipv6, boolean defaultAllow, int prefixCount) {
+        this.ipv4 = ipv4;
+        this.ipv6 = ipv6;
+        this.defaultAllow = defaultAllow;
+        this.prefixCount = prefixCount;
+    }
+
+    /**
+     * Builds a filter from comma- or whitespace-separated CIDR lists such as
+     * {@code "10.0.0.0/8, 2001:db8::/32"}. A bare address is a full-length prefix.
+     *
+     * @param allowList prefixes to allow, may be empty
+     * @param blockList prefixes to drop, may be empty
+     * @return the filter
+     * @throws IllegalArgumentException if an entry is not a valid CIDR literal
+     */
+    public static CidrFilter parse(String allowList, String blockList) {
+        Trie ipv4 = new Trie(32);
+        Trie ipv6 = new Trie(128);
+        int allowCount = addAll(allowList, ALLOW, ipv4, ipv6);
+        int blockCount = addAll(blockList, BLOCK, ipv4, ipv6);
+        return new CidrFilter(ipv4.trim(), ipv6.trim(), allowCount == 0, allowCount + blockCount);
+    }
+
+    /**
+     * Checks whether datagrams from an address should be accepted.
+     */
+    public boolean allows(InetAddress address) {
+        return allows(address.getAddress());
+    }
+
+    /**
+     * Checks whether datagrams from a raw 4- or 16-byte address should be accepted.
+     */
+    public boolean allows(byte[] raw) {
+        return allows(raw, raw.length);
+    }
+
+    /**
+     * Checks whether datagrams from the address in the first {@code length} bytes of a
+     * buffer should be accepted.
+     *
+     * @param addr the buffer holding the address in network byte order
+     * @param length 4 for IPv4 or 16 for IPv6
+     */
+    public boolean allows(byte[] addr, int length) {
+        if ((length != 4 && length != 16) || length > addr.length) {
+            throw new IllegalArgumentException("Address length must be 4 or 16 and fit the buffer, got: " + length);
+        }
+        byte verdict = (length == 4 ? ipv4 : ipv6).match(addr);
+        return verdict == NONE ? defaultAllow : verdict == ALLOW;
+    }
+
+    /**
+     * Checks whether this filter allows everything.
+     */
+    public boolean isEmpty() {
+        return prefixCount == 0;
+    }
+
+    /**
+     * Gets the number of prefixes in both lists.
+     */
+    public int size() {
+        return prefixCount;
+    }
+
+    private static int addAll(String list, byte verdict, Trie ipv4, Trie ipv6) {
+        if (list == null || list.isBlank()) {
+            return 0;
+        }
+        int count = 0;
+        for (String entry : list.split("[,\\s]+")) {
+            if (entry.isEmpty()) {
+                continue;
+            }
+            int slash = entry.indexOf('/');
+            String literal = slash >= 0 ? entry.substring(0, slash) : entry;
+            byte[] raw = parseLiteral(literal, entry);
+            int maxBits = raw.length * 8;
+            int bits = maxBits;
+            if (slash >= 0) {
+                try {
+                    bits = Integer.parseInt(entry.substring(slash + 1));
+                } catch (NumberFormatException e) {
+                    throw new IllegalArgumentException("Invalid prefix length in CIDR entry: " + entry);
+                }
+                if (bits < 0 || bits > maxBits) {
+                    throw new IllegalArgumentException("Prefix length must be between 0 and " + maxBits + ": " + entry);
+                }
+            }
+            (raw.length == 4 ? ipv4 : ipv6).insert(raw, bits, verdict);
+            count++;
+        }
+        return count;
+    }
+
+    private static byte[] parseLiteral(String literal, String entry) {
+        if (literal.isEmpty()) {
+            throw new IllegalArgumentException("Missing address in CIDR entry: " + entry);
+        }
+        boolean ipv6 = literal.indexOf(':') >= 0;
+        for (int i = 0; i < literal.length(); i++) {
+            char c = literal.charAt(i);
+            boolean valid = ipv6 ? Character.digit(c, 16) >= 0 || c == ':' || c == '.' : (c >= '0' && c <= '9') || c == '.';
+            if (!valid) {
+                throw new IllegalArgumentException("Not an IP address literal in CIDR entry: " + entry);
+            }
+        }
+        try {
+            return InetAddress.getByName(literal).getAddress();
+        } catch (UnknownHostException e) {
+            throw new IllegalArgumentException("Not an IP address literal in CIDR entry: " + entry);
+        }
+    }
+
+    /**
+     * Binary trie over address bits. Node 0 is the root; a child index of 0 means absent.
+     */
+    private static final class Trie {
+        private final int maxBits;
+        private int[] zero = new int[16];
+        private int[] one = new int[16];
+        private byte[] verdicts = new byte[16];
+        private int nodeCount = 1;
+
+        Trie(int maxBits) {
+            this.maxBits = maxBits;
+        }
+
+        void insert(byte[] raw, int bits, byte verdict) {
+            int node = 0;
+            for (int i = 0; i < bits; i++) {
+                int[] children = bit(raw, i) == 0 ? zero : one;
+                int child = children[node];
+                if (child == 0) {
+                    child = newNode();
+                    (bit(raw, i) == 0 ? zero : one)[node] = child;
+                }
+                node = child;
+            }
+            if (verdicts[node] != BLOCK) {
+                verdicts[node] = verdict;
+            }
+        }
+
+        byte match(byte[] raw) {
+            int node = 0;
+            byte best = verdicts[0];
+            for (int i = 0; i < maxBits; i++) {
+                node = bit(raw, i) == 0 ? zero[node] : one[node];
+                if (node == 0) {
+                    break;
+                }
+                if (verdicts[node] != NONE) {
+                    best = verdicts[node];
+                }
+            }
+            return best;
+        }
+
+        Trie trim() {
+            zero = Arrays.copyOf(zero, nodeCount);
+            one = Arrays.copyOf(one, nodeCount);
+            verdicts = Arrays.copyOf(verdicts, nodeCount);
+            return this;
+        }
+
+        private int newNode() {
+            if (nodeCount == zero.length) {
+                int capacity = nodeCount * 2;
+                zero = Arrays.copyOf(zero, capacity);
+                one = Arrays.copyOf(one, capacity);
+                verdicts = Arrays.copyOf(verdicts, capacity);
+            }
+            return nodeCount++;
+        }
+
+        private static int bit(byte[] raw, int index) {
+            return (raw[index >>> 3] >>> (7 - (index & 7))) & 1;
+        }
+    }
+}
@@ -57,6 +57,7 @@ public class EventDrivenReceiver implements AutoCloseable {
     private BiConsumer<NeonPacket, SocketAddress> packetHandler;
     private Runnable timeoutHandler;
     private int selectTimeoutMs;
+    private volatile SessionCipher sessionCipher;
 
     /**
      * Creates an event-driven receiver for the given channel.
@@ -97,6 +98,16 @@ public class EventDrivenReceiver implements AutoCloseable {
         this.timeoutHandler = handler;
     }
 
+    /**
+     * Sets the session cipher used to decrypt game packets.
+     * Packets that fail authentication or replay checks are dropped.
+     *
+     * @param cipher the cipher, or null for cleartext sessions
+     */
+    public void setSessionCipher(SessionCipher cipher) {
+        this.sessionCipher = cipher;
+    }
+
     /**
      * Sets the select timeout in milliseconds.
      * The timeout handler is called each time select times out.
@@ -170,8 +181,26 @@ public class EventDrivenReceiver implements AutoCloseable {
                     continue;
                 }
 
+                byte[] raw = receiveBuffer.array();
+                PacketChecksum.Framing framing = PacketChecksum.inspect(raw, length);
+                if (framing == PacketChecksum.Framing.INVALID) {
+                    logger.log(Level.FINE, "Dropped datagram from {0}: bad magic or checksum", source);
+                    continue;
+                }
+
+                if (framing == PacketChecksum.Framing.CHECKSUMMED) {
+                    length = PacketChecksum.unsealInPlace(raw, length);
+                }
+                SessionCipher cipher = sessionCipher;
+                if (cipher != null) {
+                    length = cipher.open(raw, length);
+                    if (length < 0) {
+                        logger.log(Level.FINE, "Dropped datagram from {0}: failed decryption or replayed", source);
+                        continue;
+                    }
+                }
                 byte[] data = new byte[length];
-                receiveBuffer.get(data);
+                System.arraycopy(raw, 0, data, 0, length);
 
                 try {
                     NeonPacket packet = NeonPacket.fromBytes(data);
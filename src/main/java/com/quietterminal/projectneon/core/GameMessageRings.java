@@ -0,0 +1,125 @@
+package com.quietterminal.projectneon.core;
+
+import com.quietterminal.projectneon.util.LoggerConfig;
+
+import java.io.IOException;
+import java.util.logging.Level;
+import java.util.logging.Logger;
+
+/**
+ * A pair of {@link SpscByteRing}s that carries game messages between an engine and a
+ * client or host without a call per message.
+ *
+ * <p>The engine produces into the outgoing ring and consumes the incoming ring; the
+ * client or host drains the outgoing ring on every {@code processPackets()} call and appends
+ * each received game packet to the incoming ring. Every record is
+ * {@code [packet type][peer id][payload]}, where the peer is the destination for outgoing
+ * messages and the sender for incoming ones. Only game packet types ({@code 0x10} and above)
+ * are carried. Received packets that do not fit are dropped, as a full socket buffer would.
+ *
+ * @since 1.3
+ */
+public final class GameMessageRings {
+    private static final Logger logger;
+
+    static {
+        logger = Logger.getLogger(GameMessageRings.class.getName());
+        LoggerConfig.configureLogger(logger);
+    }
+
+    /**
+     * Bytes in front of the payload of every message record.
+     */
+    public static final int MESSAGE_HEADER_SIZE = 2;
+
+    private static final int FIRST_GAME_TYPE = 0x10;
+
+    /**
+     * Sends one drained outgoing message. The payload is a view of a buffer that is reused
+     * for the next message, so it must be consumed before {@code send} returns.
+     */
+    @FunctionalInterface
+    public interface Sender {
+        void send(byte packetType, byte destinationId, byte[] buffer, int offset, int length) throws IOException;
+    }
+
+    private final SpscByteRing outgoing;
+    private final SpscByteRing incoming;
+    private final byte[] scratch;
+    private long dropped;
+
+    /**
+     * Creates a pair from existing rings.
+     *
+     * @param outgoing the ring the engine writes messages to send into
+     * @param incoming the ring received messages are written into
+     */
+    public GameMessageRings(SpscByteRing outgoing, SpscByteRing incoming) {
+        if (outgoing == null || incoming == null) {
+            throw new IllegalArgumentException("rings cannot be null");
+        }
+        if (outgoing == incoming) {
+            throw new IllegalArgumentException("outgoing and incoming rings must differ");
+        }
+        this.outgoing = outgoing;
+        this.incoming = incoming;
+        this.scratch = new byte[outgoing.maxRecordLength()];
+    }
+
+    /**
+     * Allocates a pair of direct rings with data regions of the given size.
+     */
+    public static GameMessageRings allocate(int capacity) {
+        return new GameMessageRings(SpscByteRing.allocate(capacity), SpscByteRing.allocate(capacity));
+    }
+
+    public SpscByteRing getOutgoing() {
+        return outgoing;
+    }
+
+    public SpscByteRing getIncoming() {
+        return incoming;
+    }
+
+    /**
+     * Sends every message queued in the outgoing ring.
+     *
+     * @return the number of messages sent
+     */
+    public int drainOutgoing(Sender sender) throws IOException {
+        int count = 0;
+        int length;
+        while ((length = outgoing.poll(scratch)) >= 0) {
+            if (length < MESSAGE_HEADER_SIZE || (scratch[0] & 0xFF) < FIRST_GAME_TYPE) {
+                logger.log(Level.FINE, "Discarding malformed outgoing message of {0} bytes", length);
+                continue;
+            }
+            sender.send(scratch[0], scratch[1], scratch, MESSAGE_HEADER_SIZE, length - MESSAGE_HEADER_SIZE);
+            count++;
+        }
+        return count;
+    }
+
+    /**
+     * Appends a received game packet to the incoming ring.
+     *
+     * @return false if the packet is not a game packet or the ring is full
+     */
+    public boolean deliver(byte packetType, byte senderId, byte[] payload) {
+        if ((packetType & 0xFF) < FIRST_GAME_TYPE) {
+            return false;
+        }
+        if (!incoming.offer(packetType, senderId, payload, 0, payload.length)) {
+            dropped++;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Gets the number of received game packets dropped because the incoming ring was full.
+     */
+    public long getDroppedCount() {
+        return dropped;
+    }
+}
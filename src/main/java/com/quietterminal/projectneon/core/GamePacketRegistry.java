@@ -3,7 +3,6 @@ package com.quietterminal.projectneon.core;
 import com.quietterminal.projectneon.PublicAPI;
 
 import java.util.*;
-import java.util.concurrent.ConcurrentHashMap;
 
 /**
  * Registry for game packet types with subtype, version, and validation support.
@@ -37,13 +36,18 @@ import java.util.concurrent.ConcurrentHashMap;
  * }
  * }</pre>
  *
+ * <p>Entries are held in a 256-slot array indexed by the unsigned packet type and are
+ * replaced wholesale on registration, so readers never take a lock or box a key.
+ *
  * @since 1.1
  */
 @PublicAPI
 public final class GamePacketRegistry {
 
-    private static final Map<Byte, GamePacketDescriptor> descriptors = new ConcurrentHashMap<>();
-    private static final Map<Byte, Map<Integer, PayloadDeserializer<?>>> versionedDeserializers = new ConcurrentHashMap<>();
+    private static final int TABLE_SIZE = 256;
+    private static final Object writeLock = new Object();
+
+    private static volatile Entry[] entries = new Entry[TABLE_SIZE];
 
     private GamePacketRegistry() {
         /* No instantiation */
@@ -67,20 +71,21 @@ public final class GamePacketRegistry {
                 "Cannot register game packet for core type 0x" + Integer.toHexString(packetType & 0xFF));
         }
 
-        if (descriptors.containsKey(packetType)) {
-            GamePacketDescriptor existing = descriptors.get(packetType);
-            if (existing.getVersion() == descriptor.getVersion()) {
+        synchronized (writeLock) {
+            Entry existing = entries[packetType & 0xFF];
+            if (existing != null && existing.descriptor().getVersion() == descriptor.getVersion()) {
                 throw new IllegalStateException(
                     "Descriptor already registered for packet type 0x" + Integer.toHexString(packetType & 0xFF) +
                     " version " + descriptor.getVersion());
             }
-        }
 
-        descriptors.put(packetType, descriptor);
-        versionedDeserializers
-            .computeIfAbsent(packetType, k -> new ConcurrentHashMap<>())
-            .put(descriptor.getVersion(), deserializer);
-        PayloadRegistry.register(packetType, deserializer);
+            Map<Integer, PayloadDeserializer<?>> versions = existing != null
+                ? new HashMap<>(existing.versions())
+                : new HashMap<>();
+            versions.put(descriptor.getVersion(), deserializer);
+            publish(packetType, new Entry(descriptor, Map.copyOf(versions)));
+            PayloadRegistry.register(packetType, deserializer);
+        }
     }
 
     /**
@@ -95,14 +100,17 @@ public final class GamePacketRegistry {
     public static void registerVersion(byte packetType, int version, PayloadDeserializer<?> deserializer) {
         Objects.requireNonNull(deserializer, "deserializer cannot be null");
 
-        if (!descriptors.containsKey(packetType)) {
-            throw new IllegalArgumentException(
-                "No descriptor registered for packet type 0x" + Integer.toHexString(packetType & 0xFF));
-        }
+        synchronized (writeLock) {
+            Entry existing = entries[packetType & 0xFF];
+            if (existing == null) {
+                throw new IllegalArgumentException(
+                    "No descriptor registered for packet type 0x" + Integer.toHexString(packetType & 0xFF));
+            }
 
-        versionedDeserializers
-            .computeIfAbsent(packetType, k -> new ConcurrentHashMap<>())
-            .put(version, deserializer);
+            Map<Integer, PayloadDeserializer<?>> versions = new HashMap<>(existing.versions());
+            versions.put(version, deserializer);
+            publish(packetType, new Entry(existing.descriptor(), Map.copyOf(versions)));
+        }
     }
 
     /**
@@ -112,10 +120,14 @@ public final class GamePacketRegistry {
      * @return true if the type was registered and removed
      */
     public static boolean unregister(byte packetType) {
-        boolean removed = descriptors.remove(packetType) != null;
-        versionedDeserializers.remove(packetType);
-        PayloadRegistry.unregister(packetType);
-        return removed;
+        synchronized (writeLock) {
+            boolean removed = entries[packetType & 0xFF] != null;
+            if (removed) {
+                publish(packetType, null);
+            }
+            PayloadRegistry.unregister(packetType);
+            return removed;
+        }
     }
 
     /**
@@ -125,7 +137,8 @@ public final class GamePacketRegistry {
      * @return the descriptor, or empty if not registered
      */
     public static Optional<GamePacketDescriptor> getDescriptor(byte packetType) {
-        return Optional.ofNullable(descriptors.get(packetType));
+        Entry entry = entries[packetType & 0xFF];
+        return entry != null ? Optional.of(entry.descriptor()) : Optional.empty();
     }
 
     /**
@@ -136,11 +149,11 @@ public final class GamePacketRegistry {
      * @return the deserializer, or empty if not registered
      */
     public static Optional<PayloadDeserializer<?>> getDeserializer(byte packetType, int version) {
-        Map<Integer, PayloadDeserializer<?>> versions = versionedDeserializers.get(packetType);
-        if (versions == null) {
+        Entry entry = entries[packetType & 0xFF];
+        if (entry == null) {
             return Optional.empty();
         }
-        return Optional.ofNullable(versions.get(version));
+        return Optional.ofNullable(entry.versions().get(version));
     }
 
     /**
@@ -150,11 +163,11 @@ public final class GamePacketRegistry {
      * @return set of registered versions, or empty set if type not registered
      */
     public static Set<Integer> getRegisteredVersions(byte packetType) {
-        Map<Integer, PayloadDeserializer<?>> versions = versionedDeserializers.get(packetType);
-        if (versions == null) {
+        Entry entry = entries[packetType & 0xFF];
+        if (entry == null) {
             return Collections.emptySet();
         }
-        return Collections.unmodifiableSet(versions.keySet());
+        return entry.versions().keySet();
     }
 
     /**
@@ -165,12 +178,12 @@ public final class GamePacketRegistry {
      * @return empty if valid, or an error message if validation failed
      */
     public static Optional<String> validatePayload(byte packetType, byte[] payload) {
-        GamePacketDescriptor descriptor = descriptors.get(packetType);
-        if (descriptor == null) {
+        Entry entry = entries[packetType & 0xFF];
+        if (entry == null) {
             return Optional.of("No descriptor registered for packet type 0x" +
                 Integer.toHexString(packetType & 0xFF));
         }
-        return descriptor.validate(payload);
+        return entry.descriptor().validate(payload);
     }
 
     /**
@@ -182,11 +195,12 @@ public final class GamePacketRegistry {
      * @return empty if valid, or an error message if validation failed
      */
     public static Optional<String> validatePayload(byte packetType, int subtype, byte[] payload) {
-        GamePacketDescriptor descriptor = descriptors.get(packetType);
-        if (descriptor == null) {
+        Entry entry = entries[packetType & 0xFF];
+        if (entry == null) {
             return Optional.of("No descriptor registered for packet type 0x" +
                 Integer.toHexString(packetType & 0xFF));
         }
+        GamePacketDescriptor descriptor = entry.descriptor();
         if (!descriptor.isValidSubtype(subtype)) {
             return Optional.of(String.format(
                 "Invalid subtype %d for packet type 0x%02X (valid range: %d-%d)",
@@ -202,7 +216,7 @@ public final class GamePacketRegistry {
      * @return true if registered
      */
     public static boolean isRegistered(byte packetType) {
-        return descriptors.containsKey(packetType);
+        return entries[packetType & 0xFF] != null;
     }
 
     /**
@@ -211,7 +225,14 @@ public final class GamePacketRegistry {
      * @return unmodifiable set of registered packet type bytes
      */
     public static Set<Byte> getRegisteredTypes() {
-        return Collections.unmodifiableSet(descriptors.keySet());
+        Entry[] snapshot = entries;
+        Set<Byte> types = new LinkedHashSet<>();
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            if (snapshot[i] != null) {
+                types.add((byte) i);
+            }
+        }
+        return Collections.unmodifiableSet(types);
     }
 
     /**
@@ -220,16 +241,24 @@ public final class GamePacketRegistry {
      * @return unmodifiable collection of all descriptors
      */
     public static Collection<GamePacketDescriptor> getAllDescriptors() {
-        return Collections.unmodifiableCollection(descriptors.values());
+        Entry[] snapshot = entries;
+        List<GamePacketDescriptor> all = new ArrayList<>();
+        for (Entry entry : snapshot) {
+            if (entry != null) {
+                all.add(entry.descriptor());
+            }
+        }
+        return Collections.unmodifiableList(all);
     }
 
     /**
      * Clears all registered game packet types.
      */
     public static void clearAll() {
-        descriptors.clear();
-        versionedDeserializers.clear();
-        PayloadRegistry.clearAll();
+        synchronized (writeLock) {
+            entries = new Entry[TABLE_SIZE];
+            PayloadRegistry.clearAll();
+        }
     }
 
     /**
@@ -238,6 +267,23 @@ public final class GamePacketRegistry {
      * @return count of registered types
      */
     public static int registeredCount() {
-        return descriptors.size();
+        int count = 0;
+        for (Entry entry : entries) {
+            if (entry != null) {
+                count++;
+            }
+        }
+        return count;
     }
+
+    private static void publish(byte packetType, Entry entry) {
+        Entry[] next = entries.clone();
+        next[packetType & 0xFF] = entry;
+        entries = next;
+    }
+
+    /**
+     * Immutable per-type registration: the current descriptor and every registered version.
+     */
+    private record Entry(GamePacketDescriptor descriptor, Map<Integer, PayloadDeserializer<?>> versions) {}
 }
@@ -0,0 +1,223 @@
+package com.quietterminal.projectneon.core;
+
+import javax.crypto.Cipher;
+import javax.crypto.KeyAgreement;
+import javax.crypto.Mac;
+import javax.crypto.spec.GCMParameterSpec;
+import javax.crypto.spec.SecretKeySpec;
+import java.math.BigInteger;
+import java.nio.charset.StandardCharsets;
+import java.security.GeneralSecurityException;
+import java.security.KeyFactory;
+import java.security.KeyPair;
+import java.security.KeyPairGenerator;
+import java.security.interfaces.XECPublicKey;
+import java.security.spec.NamedParameterSpec;
+import java.security.spec.XECPublicKeySpec;
+
+/**
+ * X25519 key exchange used to hand the session secret from the host to a joining client.
+ *
+ * <p>The client sends an ephemeral public key in its {@link PacketPayload.ConnectRequest};
+ * the host answers with its own ephemeral public key and the session secret sealed with
+ * AES-GCM under a key derived from the shared X25519 secret. The relay forwards both
+ * messages but cannot recover the secret. The exchange is unauthenticated, so it protects
+ * against passive observers, not against an active man in the middle.
+ *
+ * @since 1.3
+ */
+public final class KeyExchange {
+
+    /**
+     * Raw X25519 public key length in bytes.
+     */
+    public static final int PUBLIC_KEY_LENGTH = 32;
+
+    /**
+     * Session secret length in bytes.
+     */
+    public static final int SECRET_LENGTH = 32;
+
+    /**
+     * Length of a wrapped session secret: the secret plus a 16-byte GCM tag.
+     */
+    public static final int WRAPPED_SECRET_LENGTH = SECRET_LENGTH + 16;
+
+    /**
+     * Length of the key share a host returns in a {@link PacketPayload.ConnectAccept}:
+     * the cipher suite id, the host public key and the wrapped session secret.
+     */
+    public static final int ACCEPT_SHARE_LENGTH = 1 + PUBLIC_KEY_LENGTH + WRAPPED_SECRET_LENGTH;
+
+    private static final byte[] WRAP_SALT = "neon-wrap".getBytes(StandardCharsets.US_ASCII);
+    private static final BigInteger U_MASK = BigInteger.ONE.shiftLeft(255).subtract(BigInteger.ONE);
+
+    private final KeyPair keyPair;
+
+    /**
+     * Generates a fresh ephemeral key pair.
+     */
+    public KeyExchange() {
+        try {
+            this.keyPair = KeyPairGenerator.getInstance("X25519").generateKeyPair();
+        } catch (GeneralSecurityException e) {
+            throw new IllegalStateException("X25519 is not available", e);
+        }
+    }
+
+    /**
+     * Gets the raw little-endian public key to send to the peer.
+     */
+    public byte[] publicKey() {
+        BigInteger u = ((XECPublicKey) keyPair.getPublic()).getU();
+        byte[] bigEndian = u.toByteArray();
+        byte[] raw = new byte[PUBLIC_KEY_LENGTH];
+        for (int i = 0; i < raw.length && i < bigEndian.length; i++) {
+            raw[i] = bigEndian[bigEndian.length - 1 - i];
+        }
+        return raw;
+    }
+
+    /**
+     * Seals a session secret for the peer that sent {@code peerPublicKey}.
+     *
+     * @param peerPublicKey the peer's raw public key
+     * @param secret the session secret
+     * @param sessionId the session the secret belongs to
+     * @param clientId the client the secret is sealed for
+     * @return the wrapped secret, {@link #WRAPPED_SECRET_LENGTH} bytes
+     */
+    public byte[] wrap(byte[] peerPublicKey, byte[] secret, int sessionId, byte clientId) {
+        try {
+            Cipher cipher = Cipher.getInstance("AES/GCM/NoPadding");
+            cipher.init(Cipher.ENCRYPT_MODE, wrapKey(peerPublicKey, sessionId, clientId),
+                new GCMParameterSpec(128, new byte[12]));
+            return cipher.doFinal(secret);
+        } catch (GeneralSecurityException e) {
+            throw new IllegalArgumentException("Cannot wrap session secret: " + e.getMessage(), e);
+        }
+    }
+
+    /**
+     * Recovers a session secret sealed by the peer.
+     *
+     * @param peerPublicKey the peer's raw public key
+     * @param wrapped the wrapped secret
+     * @param sessionId the session the secret belongs to
+     * @param clientId this client's id
+     * @return the session secret
+     * @throws IllegalArgumentException if the secret does not authenticate
+     */
+    public byte[] unwrap(byte[] peerPublicKey, byte[] wrapped, int sessionId, byte clientId) {
+        try {
+            Cipher cipher = Cipher.getInstance("AES/GCM/NoPadding");
+            cipher.init(Cipher.DECRYPT_MODE, wrapKey(peerPublicKey, sessionId, clientId),
+                new GCMParameterSpec(128, new byte[12]));
+            return cipher.doFinal(wrapped);
+        } catch (GeneralSecurityException e) {
+            throw new IllegalArgumentException("Cannot unwrap session secret: " + e.getMessage(), e);
+        }
+    }
+
+    /**
+     * Builds the key share for a {@link PacketPayload.ConnectAccept} answering a client.
+     *
+     * @param clientPublicKey the key share from the client's connect request
+     * @param suite the session's cipher suite
+     * @param secret the session secret
+     * @param sessionId the session id
+     * @param clientId the id assigned to the client
+     * @return the {@link #ACCEPT_SHARE_LENGTH}-byte key share
+     */
+    public byte[] acceptShare(byte[] clientPublicKey, SessionCipher.Suite suite, byte[] secret,
+                              int sessionId, byte clientId) {
+        byte[] wrapped = wrap(clientPublicKey, secret, sessionId, clientId);
+        byte[] share = new byte[ACCEPT_SHARE_LENGTH];
+        share[0] = suite.getId();
+        System.arraycopy(publicKey(), 0, share, 1, PUBLIC_KEY_LENGTH);
+        System.arraycopy(wrapped, 0, share, 1 + PUBLIC_KEY_LENGTH, WRAPPED_SECRET_LENGTH);
+        return share;
+    }
+
+    /**
+     * Opens the key share from a host's {@link PacketPayload.ConnectAccept}.
+     *
+     * @param share the key share
+     * @param sessionId the session id
+     * @param clientId the id the host assigned to this client
+     * @return the session cipher
+     * @throws IllegalArgumentException if the share is malformed or does not authenticate
+     */
+    public SessionCipher openAcceptShare(byte[] share, int sessionId, byte clientId) {
+        if (share.length != ACCEPT_SHARE_LENGTH) {
+            throw new IllegalArgumentException("Key share must be " + ACCEPT_SHARE_LENGTH + " bytes, got: " + share.length);
+        }
+        SessionCipher.Suite suite = SessionCipher.Suite.fromId(share[0]);
+        byte[] hostPublicKey = new byte[PUBLIC_KEY_LENGTH];
+        System.arraycopy(share, 1, hostPublicKey, 0, PUBLIC_KEY_LENGTH);
+        byte[] wrapped = new byte[WRAPPED_SECRET_LENGTH];
+        System.arraycopy(share, 1 + PUBLIC_KEY_LENGTH, wrapped, 0, WRAPPED_SECRET_LENGTH);
+        return new SessionCipher(suite, unwrap(hostPublicKey, wrapped, sessionId, clientId));
+    }
+
+    private SecretKeySpec wrapKey(byte[] peerPublicKey, int sessionId, byte clientId) throws GeneralSecurityException {
+        if (peerPublicKey == null || peerPublicKey.length != PUBLIC_KEY_LENGTH) {
+            throw new IllegalArgumentException("Peer public key must be " + PUBLIC_KEY_LENGTH + " bytes");
+        }
+        byte[] bigEndian = new byte[PUBLIC_KEY_LENGTH];
+        for (int i = 0; i < PUBLIC_KEY_LENGTH; i++) {
+            bigEndian[i] = peerPublicKey[PUBLIC_KEY_LENGTH - 1 - i];
+        }
+        BigInteger u = new BigInteger(1, bigEndian).and(U_MASK);
+        KeyFactory factory = KeyFactory.getInstance("XDH");
+        XECPublicKeySpec spec = new XECPublicKeySpec(NamedParameterSpec.X25519, u);
+
+        KeyAgreement agreement = KeyAgreement.getInstance("XDH");
+        agreement.init(keyPair.getPrivate());
+        agreement.doPhase(factory.generatePublic(spec), true);
+        byte[] shared = agreement.generateSecret();
+
+        byte[] info = {
+            (byte) sessionId, (byte) (sessionId >>> 8), (byte) (sessionId >>> 16), (byte) (sessionId >>> 24), clientId
+        };
+        return new SecretKeySpec(expand(extract(WRAP_SALT, shared), info, 32), "AES");
+    }
+
+    /**
+     * HKDF-Extract with HMAC-SHA256 (RFC 5869).
+     */
+    static byte[] extract(byte[] salt, byte[] inputKeyMaterial) {
+        try {
+            Mac mac = Mac.getInstance("HmacSHA256");
+            mac.init(new SecretKeySpec(salt, "HmacSHA256"));
+            return mac.doFinal(inputKeyMaterial);
+        } catch (GeneralSecurityException e) {
+            throw new IllegalStateException("HmacSHA256 is not available", e);
+        }
+    }
+
+    /**
+     * HKDF-Expand with HMAC-SHA256 (RFC 5869).
+     */
+    static byte[] expand(byte[] pseudoRandomKey, byte[] info, int length) {
+        try {
+            Mac mac = Mac.getInstance("HmacSHA256");
+            mac.init(new SecretKeySpec(pseudoRandomKey, "HmacSHA256"));
+            byte[] out = new byte[length];
+            byte[] block = new byte[0];
+            int pos = 0;
+            for (int counter = 1; pos < length; counter++) {
+                mac.update(block);
+                mac.update(info);
+                mac.update((byte) counter);
+                block = mac.doFinal();
+                int n = Math.min(block.length, length - pos);
+                System.arraycopy(block, 0, out, pos, n);
+                pos += n;
+            }
+            return out;
+        } catch (GeneralSecurityException e) {
+            throw new IllegalStateException("HmacSHA256 is not available", e);
+        }
+    }
+}
@@ -0,0 +1,313 @@
+package com.quietterminal.projectneon.core;
+
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.net.BindException;
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+import java.net.SocketAddress;
+import java.net.SocketException;
+import java.net.SocketTimeoutException;
+import java.nio.ByteBuffer;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.locks.LockSupport;
+
+/**
+ * In-process transport that hands datagrams between endpoints of the same {@link Network}
+ * without any system call, for relays, hosts and clients running in one JVM.
+ *
+ * <p>Addressing follows UDP on a single machine: endpoints bind to ports, port 0 picks a
+ * free ephemeral port, local and source addresses are loopback {@link InetSocketAddress}es,
+ * and only the port of a destination is significant. Sends to an unbound port are dropped
+ * silently, like UDP without ICMP. Unlike UDP, datagrams between two endpoints are never
+ * lost or reordered, except that a datagram arriving at a full queue is dropped and counted.
+ *
+ * <p>Each endpoint has a lock-free inbox that any number of threads may send to. Payloads
+ * are copied once into a buffer from the network's pool and once out into the receiver's
+ * buffer. Receives must come from one thread at a time, as with {@link NeonSocket}.
+ *
+ * <p>Example usage:
+ * <pre>{@code
+ * LoopbackTransport.Network network = new LoopbackTransport.Network();
+ * NeonRelay relay = new NeonRelay(LoopbackTransport.bound(network, 7777), config);
+ * NeonHost host = new NeonHost(sessionId, "127.0.0.1:7777", config, LoopbackTransport.bound(network, 0));
+ * }</pre>
+ *
+ * @since 1.3
+ */
+public class LoopbackTransport implements Transport {
+
+    /**
+     * Maximum number of datagrams waiting in an endpoint's inbox.
+     */
+    public static final int QUEUE_CAPACITY = 1024;
+
+    private final Network network;
+    private final ConcurrentLinkedQueue<Datagram> inbox = new ConcurrentLinkedQueue<>();
+    private final AtomicInteger queued = new AtomicInteger();
+    private final AtomicLong dropped = new AtomicLong();
+    private volatile InetSocketAddress localAddress;
+    private volatile boolean blocking;
+    private volatile int timeoutMs;
+    private volatile boolean closed;
+    private volatile Thread waiter;
+
+    /**
+     * Creates an unbound endpoint on the {@link Network#shared() shared} network.
+     */
+    public LoopbackTransport() {
+        this(Network.shared());
+    }
+
+    /**
+     * Creates an unbound endpoint on the given network.
+     *
+     * @param network the network to attach to
+     */
+    public LoopbackTransport(Network network) {
+        if (network == null) {
+            throw new IllegalArgumentException("network cannot be null");
+        }
+        this.network = network;
+    }
+
+    /**
+     * Creates an endpoint on the given network bound to the specified port.
+     *
+     * @param network the network to attach to
+     * @param port the port to bind to, or 0 for any free port
+     * @return the bound transport
+     * @throws BindException if the port is in use
+     */
+    public static LoopbackTransport bound(Network network, int port) throws IOException {
+        LoopbackTransport transport = new LoopbackTransport(network);
+        transport.bind(port);
+        return transport;
+    }
+
+    @Override
+    public Type getType() {
+        return Type.LOOPBACK;
+    }
+
+    @Override
+    public synchronized void bind(int port) throws IOException {
+        ensureOpen();
+        if (localAddress != null) {
+            throw new SocketException("Already bound");
+        }
+        localAddress = network.bind(this, port);
+    }
+
+    @Override
+    public SocketAddress getLocalAddress() {
+        return localAddress;
+    }
+
+    @Override
+    public void send(ByteBuffer data, SocketAddress address) throws IOException {
+        ensureOpen();
+        if (localAddress == null) {
+            bind(0);
+        }
+        LoopbackTransport target = network.lookup(address);
+        if (target == null || !target.deliver(data, localAddress)) {
+            data.position(data.limit());
+        }
+    }
+
+    @Override
+    public SocketAddress receive(ByteBuffer buffer) throws IOException {
+        ensureOpen();
+        Datagram datagram = inbox.poll();
+        if (datagram == null) {
+            if (!blocking) {
+                return null;
+            }
+            datagram = await();
+        }
+        queued.decrementAndGet();
+        buffer.put(datagram.data(), 0, Math.min(datagram.length(), buffer.remaining()));
+        network.bufferPool.release(datagram.data());
+        return datagram.source();
+    }
+
+    @Override
+    public void setBlocking(boolean blocking) {
+        this.blocking = blocking;
+    }
+
+    @Override
+    public boolean isBlocking() {
+        return blocking;
+    }
+
+    @Override
+    public void setTimeout(int timeoutMs) {
+        if (timeoutMs < 0) {
+            throw new IllegalArgumentException("timeoutMs must be non-negative, got: " + timeoutMs);
+        }
+        this.timeoutMs = timeoutMs;
+    }
+
+    @Override
+    public boolean isClosed() {
+        return closed;
+    }
+
+    /**
+     * Gets the number of datagrams dropped because this endpoint's inbox was full.
+     */
+    public long getDroppedCount() {
+        return dropped.get();
+    }
+
+    @Override
+    public synchronized void close() {
+        if (closed) {
+            return;
+        }
+        closed = true;
+        if (localAddress != null) {
+            network.unbind(localAddress.getPort(), this);
+        }
+        Datagram datagram;
+        while ((datagram = inbox.poll()) != null) {
+            network.bufferPool.release(datagram.data());
+        }
+        wake();
+    }
+
+    /**
+     * Copies the remaining bytes of a datagram into this endpoint's inbox.
+     *
+     * @return false if the endpoint is closed or its inbox is full
+     */
+    private boolean deliver(ByteBuffer data, InetSocketAddress source) {
+        if (closed) {
+            return false;
+        }
+        if (queued.incrementAndGet() > QUEUE_CAPACITY) {
+            queued.decrementAndGet();
+            dropped.incrementAndGet();
+            return false;
+        }
+        int length = data.remaining();
+        byte[] buffer = length <= Network.POOLED_BUFFER_SIZE ? network.bufferPool.acquire() : new byte[length];
+        data.get(buffer, 0, length);
+        inbox.offer(new Datagram(buffer, length, source));
+        wake();
+        return true;
+    }
+
+    /**
+     * Parks until a datagram arrives, the timeout expires or the endpoint is closed.
+     * Publishing the waiter before polling pairs with {@link #wake()} after offering, so a
+     * datagram is either seen by the poll or its sender unparks this thread.
+     */
+    private Datagram await() throws IOException {
+        long deadline = System.nanoTime() + timeoutMs * 1_000_000L;
+        waiter = Thread.currentThread();
+        try {
+            while (true) {
+                Datagram datagram = inbox.poll();
+                if (datagram != null) {
+                    return datagram;
+                }
+                ensureOpen();
+                if (timeoutMs > 0) {
+                    long remaining = deadline - System.nanoTime();
+                    if (remaining <= 0) {
+                        throw new SocketTimeoutException("Receive timed out");
+                    }
+                    LockSupport.parkNanos(this, remaining);
+                } else {
+                    LockSupport.park(this);
+                }
+                if (Thread.currentThread().isInterrupted()) {
+                    throw new InterruptedIOException("Receive interrupted");
+                }
+            }
+        } finally {
+            waiter = null;
+        }
+    }
+
+    private void wake() {
+        Thread thread = waiter;
+        if (thread != null) {
+            LockSupport.unpark(thread);
+        }
+    }
+
+    private void ensureOpen() throws SocketException {
+        if (closed) {
+            throw new SocketException("Socket is closed");
+        }
+    }
+
+    private record Datagram(byte[] data, int length, SocketAddress source) {
+    }
+
+    /**
+     * A set of loopback endpoints that can reach each other, like the ports of one host.
+     * Independent networks keep parallel tests from seeing each other's traffic.
+     */
+    public static final class Network {
+        private static final Network SHARED = new Network();
+
+        static final int POOLED_BUFFER_SIZE = 2048;
+        private static final int EPHEMERAL_FIRST = 49152;
+        private static final int EPHEMERAL_LAST = 65535;
+
+        private final ConcurrentHashMap<Integer, LoopbackTransport> endpoints = new ConcurrentHashMap<>();
+        private final AtomicInteger nextEphemeral = new AtomicInteger(EPHEMERAL_FIRST);
+        private final ByteBufferPool bufferPool = new ByteBufferPool(POOLED_BUFFER_SIZE, 0, QUEUE_CAPACITY);
+
+        /**
+         * Gets the process-wide network used by endpoints created without one.
+         */
+        public static Network shared() {
+            return SHARED;
+        }
+
+        /**
+         * Gets the number of bound endpoints.
+         */
+        public int size() {
+            return endpoints.size();
+        }
+
+        private InetSocketAddress bind(LoopbackTransport transport, int port) throws BindException {
+            if (port < 0 || port > EPHEMERAL_LAST) {
+                throw new IllegalArgumentException("Port out of range: " + port);
+            }
+            if (port == 0) {
+                int range = EPHEMERAL_LAST - EPHEMERAL_FIRST + 1;
+                for (int i = 0; i < range && port == 0; i++) {
+                    int candidate = EPHEMERAL_FIRST + Math.floorMod(nextEphemeral.getAndIncrement() - EPHEMERAL_FIRST, range);
+                    if (endpoints.putIfAbsent(candidate, transport) == null) {
+                        port = candidate;
+                    }
+                }
+                if (port == 0) {
+                    throw new BindException("No free loopback ports");
+                }
+            } else if (endpoints.putIfAbsent(port, transport) != null) {
+                throw new BindException("Address already in use: " + port);
+            }
+            return new InetSocketAddress(InetAddress.getLoopbackAddress(), port);
+        }
+
+        private LoopbackTransport lookup(SocketAddress address) {
+            return address instanceof InetSocketAddress inet ? endpoints.get(inet.getPort()) : null;
+        }
+
+        private void unbind(int port, LoopbackTransport transport) {
+            endpoints.remove(port, transport);
+        }
+    }
+}
@@ -41,6 +41,11 @@ public class NeonConfig {
     private int relaySocketTimeoutMs = 100;
     private int relayMainLoopSleepMs = 1;
     private int relayPendingConnectionTimeoutMs = 30000;
+    private boolean relayConnectCookiesEnabled = false;
+    private int relayConnectCookieLifetimeMs = 10000;
+    private int relayAmplificationFactor = 3;
+    private String relayAllowList = "";
+    private String relayBlockList = "";
 
     private int maxPacketsPerSecond = 100;
     private int maxClientsPerSession = 32;
@@ -80,6 +85,12 @@ public class NeonConfig {
     private int maxDescriptionLength = 256;
     private int maxPacketCount = 100;
     private int maxPayloadSize = 65507;
+    private boolean packetChecksumEnabled = false;
+    private int maxHeaderVersion = 1;
+    private boolean pathMtuDiscoveryEnabled = false;
+    private int pathMtuMaxSize = 1472;
+    private String sessionTokenKey = "";
+    private String sessionEncryption = "none";
 
     private boolean useEventDrivenReceiver = false;
     private int eventLoopSelectTimeoutMs = 100;
@@ -235,6 +246,23 @@ public class NeonConfig {
         if (eventLoopSelectTimeoutMs < 0) {
             throw new IllegalArgumentException("eventLoopSelectTimeoutMs must be non-negative, got: " + eventLoopSelectTimeoutMs);
         }
+        if (maxHeaderVersion < PacketHeader.VERSION || maxHeaderVersion > PacketHeaderV2.VERSION) {
+            throw new IllegalArgumentException("maxHeaderVersion must be 1 or 2, got: " + maxHeaderVersion);
+        }
+        if (pathMtuMaxSize < PayloadSizeEnforcer.MTU_SAFE_PAYLOAD || pathMtuMaxSize > PayloadSizeEnforcer.UDP_MAX_PAYLOAD) {
+            throw new IllegalArgumentException("pathMtuMaxSize must be between 1200 and 65507, got: " + pathMtuMaxSize);
+        }
+        if (relayConnectCookieLifetimeMs < 1000) {
+            throw new IllegalArgumentException("relayConnectCookieLifetimeMs must be at least 1000, got: " + relayConnectCookieLifetimeMs);
+        }
+        if (relayAmplificationFactor < 0) {
+            throw new IllegalArgumentException("relayAmplificationFactor must be non-negative, got: " + relayAmplificationFactor);
+        }
+        CidrFilter.parse(relayAllowList, relayBlockList);
+        if (sessionTokenKey != null && !sessionTokenKey.isEmpty()) {
+            SessionTokenSigner.parseKey(sessionTokenKey);
+        }
+        SessionCipher.Suite.fromConfigName(sessionEncryption);
     }
 
     public int getBufferSize() {
@@ -336,6 +364,51 @@ public class NeonConfig {
         return this;
     }
 
+    public boolean isRelayConnectCookiesEnabled() {
+        return relayConnectCookiesEnabled;
+    }
+
+    public NeonConfig setRelayConnectCookiesEnabled(boolean relayConnectCookiesEnabled) {
+        this.relayConnectCookiesEnabled = relayConnectCookiesEnabled;
+        return this;
+    }
+
+    public int getRelayConnectCookieLifetimeMs() {
+        return relayConnectCookieLifetimeMs;
+    }
+
+    public NeonConfig setRelayConnectCookieLifetimeMs(int relayConnectCookieLifetimeMs) {
+        this.relayConnectCookieLifetimeMs = relayConnectCookieLifetimeMs;
+        return this;
+    }
+
+    public int getRelayAmplificationFactor() {
+        return relayAmplificationFactor;
+    }
+
+    public NeonConfig setRelayAmplificationFactor(int relayAmplificationFactor) {
+        this.relayAmplificationFactor = relayAmplificationFactor;
+        return this;
+    }
+
+    public String getRelayAllowList() {
+        return relayAllowList;
+    }
+
+    public NeonConfig setRelayAllowList(String relayAllowList) {
+        this.relayAllowList = relayAllowList;
+        return this;
+    }
+
+    public String getRelayBlockList() {
+        return relayBlockList;
+    }
+
+    public NeonConfig setRelayBlockList(String relayBlockList) {
+        this.relayBlockList = relayBlockList;
+        return this;
+    }
+
     public int getMaxPacketsPerSecond() {
         return maxPacketsPerSecond;
     }
@@ -624,6 +697,60 @@ public class NeonConfig {
         return this;
     }
 
+    public boolean isPacketChecksumEnabled() {
+        return packetChecksumEnabled;
+    }
+
+    public NeonConfig setPacketChecksumEnabled(boolean packetChecksumEnabled) {
+        this.packetChecksumEnabled = packetChecksumEnabled;
+        return this;
+    }
+
+    public int getMaxHeaderVersion() {
+        return maxHeaderVersion;
+    }
+
+    public NeonConfig setMaxHeaderVersion(int maxHeaderVersion) {
+        this.maxHeaderVersion = maxHeaderVersion;
+        return this;
+    }
+
+    public boolean isPathMtuDiscoveryEnabled() {
+        return pathMtuDiscoveryEnabled;
+    }
+
+    public NeonConfig setPathMtuDiscoveryEnabled(boolean pathMtuDiscoveryEnabled) {
+        this.pathMtuDiscoveryEnabled = pathMtuDiscoveryEnabled;
+        return this;
+    }
+
+    public int getPathMtuMaxSize() {
+        return pathMtuMaxSize;
+    }
+
+    public NeonConfig setPathMtuMaxSize(int pathMtuMaxSize) {
+        this.pathMtuMaxSize = pathMtuMaxSize;
+        return this;
+    }
+
+    public String getSessionTokenKey() {
+        return sessionTokenKey;
+    }
+
+    public NeonConfig setSessionTokenKey(String sessionTokenKey) {
+        this.sessionTokenKey = sessionTokenKey;
+        return this;
+    }
+
+    public String getSessionEncryption() {
+        return sessionEncryption;
+    }
+
+    public NeonConfig setSessionEncryption(String sessionEncryption) {
+        this.sessionEncryption = sessionEncryption;
+        return this;
+    }
+
     public boolean isUseEventDrivenReceiver() {
         return useEventDrivenReceiver;
     }
@@ -719,6 +846,31 @@ public class NeonConfig {
             return this;
         }
 
+        public Builder relayConnectCookiesEnabled(boolean relayConnectCookiesEnabled) {
+            config.setRelayConnectCookiesEnabled(relayConnectCookiesEnabled);
+            return this;
+        }
+
+        public Builder relayConnectCookieLifetimeMs(int relayConnectCookieLifetimeMs) {
+            config.setRelayConnectCookieLifetimeMs(relayConnectCookieLifetimeMs);
+            return this;
+        }
+
+        public Builder relayAmplificationFactor(int relayAmplificationFactor) {
+            config.setRelayAmplificationFactor(relayAmplificationFactor);
+            return this;
+        }
+
+        public Builder relayAllowList(String relayAllowList) {
+            config.setRelayAllowList(relayAllowList);
+            return this;
+        }
+
+        public Builder relayBlockList(String relayBlockList) {
+            config.setRelayBlockList(relayBlockList);
+            return this;
+        }
+
         public Builder maxPacketsPerSecond(int maxPacketsPerSecond) {
             config.setMaxPacketsPerSecond(maxPacketsPerSecond);
             return this;
@@ -879,6 +1031,36 @@ public class NeonConfig {
             return this;
         }
 
+        public Builder packetChecksumEnabled(boolean packetChecksumEnabled) {
+            config.setPacketChecksumEnabled(packetChecksumEnabled);
+            return this;
+        }
+
+        public Builder maxHeaderVersion(int maxHeaderVersion) {
+            config.setMaxHeaderVersion(maxHeaderVersion);
+            return this;
+        }
+
+        public Builder pathMtuDiscoveryEnabled(boolean pathMtuDiscoveryEnabled) {
+            config.setPathMtuDiscoveryEnabled(pathMtuDiscoveryEnabled);
+            return this;
+        }
+
+        public Builder pathMtuMaxSize(int pathMtuMaxSize) {
+            config.setPathMtuMaxSize(pathMtuMaxSize);
+            return this;
+        }
+
+        public Builder sessionTokenKey(String sessionTokenKey) {
+            config.setSessionTokenKey(sessionTokenKey);
+            return this;
+        }
+
+        public Builder sessionEncryption(String sessionEncryption) {
+            config.setSessionEncryption(sessionEncryption);
+            return this;
+        }
+
         public Builder useEventDrivenReceiver(boolean useEventDrivenReceiver) {
             config.setUseEventDrivenReceiver(useEventDrivenReceiver);
             return this;
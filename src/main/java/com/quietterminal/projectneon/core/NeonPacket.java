@@ -1,21 +1,62 @@
 package com.quietterminal.projectneon.core;
 
 import java.util.Arrays;
+import java.util.Objects;
 
 /**
  * Complete Neon packet with header and payload.
+ *
+ * <p>Packets received or created with a {@link PacketHeaderV2} keep it in {@code headerV2}
+ * and are serialized in the version 2 format. {@code header} is then the version 1 view
+ * of the same fields, so routing code can treat both versions alike.
  */
-public record NeonPacket(PacketHeader header, PacketPayload payload) {
+public record NeonPacket(PacketHeader header, PacketPayload payload, PacketHeaderV2 headerV2) {
+
+    public NeonPacket(PacketHeader header, PacketPayload payload) {
+        this(header, payload, null);
+    }
+
+    /**
+     * Checks whether this packet uses the version 2 header.
+     */
+    public boolean isV2() {
+        return headerV2 != null;
+    }
+
+    /**
+     * Gets the full 32-bit sequence number, or the zero-extended 16-bit one for version 1.
+     */
+    public int fullSequence() {
+        return headerV2 != null ? headerV2.sequence() : header.sequence() & 0xFFFF;
+    }
 
     /**
      * Serializes the entire packet to bytes.
      */
     public byte[] toBytes() {
-        byte[] headerBytes = header.toBytes();
         byte[] payloadBytes = payload.toBytes();
-        byte[] packet = new byte[headerBytes.length + payloadBytes.length];
+        return encode(header, headerV2, payloadBytes, 0, payloadBytes.length);
+    }
+
+    /**
+     * Serializes a header followed by a slice of a buffer, copying the slice only once.
+     *
+     * @param header the version 1 header, used when {@code headerV2} is null
+     * @param headerV2 the version 2 header, or null
+     */
+    public static byte[] encode(PacketHeader header, PacketHeaderV2 headerV2, byte[] payload, int offset, int length) {
+        Objects.checkFromIndexSize(offset, length, payload.length);
+        if (headerV2 != null) {
+            int headerLength = headerV2.encodedSize();
+            byte[] packet = new byte[headerLength + length];
+            headerV2.encodeTo(packet, 0);
+            System.arraycopy(payload, offset, packet, headerLength, length);
+            return packet;
+        }
+        byte[] headerBytes = header.toBytes();
+        byte[] packet = new byte[headerBytes.length + length];
         System.arraycopy(headerBytes, 0, packet, 0, headerBytes.length);
-        System.arraycopy(payloadBytes, 0, packet, headerBytes.length, payloadBytes.length);
+        System.arraycopy(payload, offset, packet, headerBytes.length, length);
         return packet;
     }
 
@@ -26,12 +67,21 @@ public record NeonPacket(PacketHeader header, PacketPayload payload) {
      * For game packet types (>= 0x10), checks the {@link PayloadRegistry} for
      * custom deserializers. If no custom deserializer is registered, falls back
      * to {@link PacketPayload.GamePacket} which preserves raw bytes.
+     *
+     * <p>Both header versions are accepted; the version byte selects the decoder.
      */
     public static NeonPacket fromBytes(byte[] bytes) {
         if (bytes.length < PacketHeader.HEADER_SIZE) {
             throw new IllegalArgumentException("Packet too small");
         }
 
+        if (bytes[2] == PacketHeaderV2.VERSION) {
+            PacketHeaderV2 headerV2 = PacketHeaderV2.decode(bytes, 0, bytes.length);
+            byte[] payloadBytes = Arrays.copyOfRange(bytes, headerV2.encodedSize(), bytes.length);
+            PacketPayload payload = deserializePayload(headerV2.packetType(), payloadBytes);
+            return new NeonPacket(headerV2.toV1(), payload, headerV2);
+        }
+
         PacketHeader header = PacketHeader.fromBytes(bytes);
         byte[] payloadBytes = Arrays.copyOfRange(bytes, PacketHeader.HEADER_SIZE, bytes.length);
 
@@ -40,9 +90,9 @@ public record NeonPacket(PacketHeader header, PacketPayload payload) {
     }
 
     private static PacketPayload deserializePayload(byte packetType, byte[] payloadBytes) {
-        var customDeserializer = PayloadRegistry.getDeserializer(packetType);
-        if (customDeserializer.isPresent()) {
-            return customDeserializer.get().fromBytes(payloadBytes);
+        PayloadDeserializer<?> customDeserializer = PayloadRegistry.lookup(packetType);
+        if (customDeserializer != null) {
+            return customDeserializer.fromBytes(payloadBytes);
         }
 
         PacketType type = PacketType.fromByte(packetType);
@@ -52,8 +102,10 @@ public record NeonPacket(PacketHeader header, PacketPayload payload) {
             case CONNECT_DENY -> PacketPayload.ConnectDeny.fromBytes(payloadBytes);
             case SESSION_CONFIG -> PacketPayload.SessionConfig.fromBytes(payloadBytes);
             case PACKET_TYPE_REGISTRY -> PacketPayload.PacketTypeRegistry.fromBytes(payloadBytes);
-            case PING -> PacketPayload.Ping.fromBytes(payloadBytes);
-            case PONG -> PacketPayload.Pong.fromBytes(payloadBytes);
+            case PING -> payloadBytes.length > 8
+                ? PacketPayload.MtuProbe.fromBytes(payloadBytes) : PacketPayload.Ping.fromBytes(payloadBytes);
+            case PONG -> payloadBytes.length > 8
+                ? PacketPayload.MtuProbe.fromBytes(payloadBytes) : PacketPayload.Pong.fromBytes(payloadBytes);
             case DISCONNECT_NOTICE -> PacketPayload.DisconnectNotice.fromBytes(payloadBytes);
             case ACK -> PacketPayload.Ack.fromBytes(payloadBytes);
             case RECONNECT_REQUEST -> PacketPayload.ReconnectRequest.fromBytes(payloadBytes);
@@ -69,8 +121,17 @@ public record NeonPacket(PacketHeader header, PacketPayload payload) {
         return new NeonPacket(header, payload);
     }
 
+    /**
+     * Creates a new packet with a version 2 header.
+     */
+    public static NeonPacket createV2(PacketType type, int sequence, int clientId, int destinationId, PacketPayload payload) {
+        PacketHeaderV2 headerV2 = PacketHeaderV2.create(type.getValue(), sequence, clientId, destinationId);
+        return new NeonPacket(headerV2.toV1(), payload, headerV2);
+    }
+
     @Override
     public String toString() {
-        return String.format("NeonPacket[%s, payload=%s]", header, payload.getClass().getSimpleName());
+        return String.format("NeonPacket[%s, payload=%s]",
+            headerV2 != null ? headerV2 : header, payload.getClass().getSimpleName());
     }
 }
@@ -5,15 +5,18 @@ import com.quietterminal.projectneon.util.LoggerConfig;
 import java.io.IOException;
 import java.net.*;
 import java.nio.BufferUnderflowException;
-import java.nio.channels.DatagramChannel;
+import java.nio.ByteBuffer;
 import java.util.logging.Level;
 import java.util.logging.Logger;
 
 /**
- * UDP socket wrapper for Neon protocol operations.
+ * Socket for Neon protocol operations. Adds checksums, encryption, source filtering,
+ * interning and amplification limits on top of a {@link Transport}, by default a
+ * {@link UdpTransport}. A NeonSocket is itself a transport that sends and receives
+ * framed packets.
  * Supports both blocking and non-blocking modes.
  */
-public class NeonSocket implements AutoCloseable {
+public class NeonSocket implements Transport {
     private static final Logger logger;
 
     static {
@@ -21,11 +24,19 @@ public class NeonSocket implements AutoCloseable {
         LoggerConfig.configureLogger(logger);
     }
 
-    private final DatagramChannel channel;
-    private final DatagramSocket socket;
+    private final Transport transport;
     private final ByteBufferPool bufferPool;
 
     private final NeonConfig config;
+    private volatile boolean checksumEnabled;
+    private long rejectedDatagrams;
+    private SourceAddressTable sourceTable;
+    private AmplificationLimiter amplificationLimiter;
+    private long amplificationDrops;
+    private volatile CidrFilter sourceFilter;
+    private long filteredDatagrams;
+    private volatile SessionCipher sessionCipher;
+    private long undecryptableDatagrams;
 
     /**
      * Creates a new UDP socket bound to any available port with default configuration.
@@ -52,56 +63,322 @@ public class NeonSocket implements AutoCloseable {
      * Creates a new UDP socket bound to the specified port with custom configuration.
      */
     public NeonSocket(int port, NeonConfig config) throws IOException {
+        this(UdpTransport.bound(port, config), config);
+    }
+
+    /**
+     * Creates a socket over an already bound transport, which it takes ownership of and
+     * closes on {@link #close()}.
+     *
+     * @param transport the bound transport
+     * @param config the configuration
+     * @since 1.3
+     */
+    public NeonSocket(Transport transport, NeonConfig config) throws IOException {
+        if (transport == null) {
+            throw new IllegalArgumentException("transport cannot be null");
+        }
         if (config == null) {
             throw new IllegalArgumentException("config cannot be null");
         }
         this.config = config;
-        this.channel = DatagramChannel.open();
-        this.socket = channel.socket();
-        this.socket.bind(new InetSocketAddress(port));
+        this.transport = transport;
         this.bufferPool = new ByteBufferPool(
             config.getBufferSize(),
             config.getBufferPoolInitialSize(),
             config.getBufferPoolMaxSize()
         );
+        this.checksumEnabled = config.isPacketChecksumEnabled();
+        if (config.isPathMtuDiscoveryEnabled()) {
+            setDontFragment(true);
+        }
         setBlocking(false);
     }
 
+    /**
+     * Sets the IP don't-fragment bit on outgoing datagrams. Path MTU discovery needs it,
+     * since otherwise oversized probes are fragmented by IP and arrive anyway. With the bit
+     * set, datagrams larger than the local interface MTU fail to send.
+     *
+     * @param enabled true to set the bit
+     * @return false if the platform does not support the option
+     */
+    @Override
+    public boolean setDontFragment(boolean enabled) {
+        if (!transport.setDontFragment(enabled)) {
+            logger.log(Level.WARNING, "IP_DONTFRAGMENT not supported by the {0} transport on this platform",
+                transport.getType());
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Gets the transport this socket sends and receives through.
+     *
+     * @since 1.3
+     */
+    public Transport getTransport() {
+        return transport;
+    }
+
+    @Override
+    public Type getType() {
+        return transport.getType();
+    }
+
+    @Override
+    public void bind(int port) throws IOException {
+        transport.bind(port);
+    }
+
     /**
      * Sets the socket to blocking or non-blocking mode.
      */
+    @Override
     public void setBlocking(boolean blocking) throws IOException {
-        channel.configureBlocking(blocking);
+        transport.setBlocking(blocking);
     }
 
     /**
      * Checks if the socket is in blocking mode.
      */
+    @Override
     public boolean isBlocking() {
-        return channel.isBlocking();
+        return transport.isBlocking();
     }
 
     /**
      * Gets the local address this socket is bound to.
      */
+    @Override
     public InetSocketAddress getLocalAddress() {
-        return (InetSocketAddress) socket.getLocalSocketAddress();
+        return (InetSocketAddress) transport.getLocalAddress();
     }
 
     /**
      * Sends a packet to the specified address.
      */
     public void sendTo(byte[] data, SocketAddress address) throws IOException {
-        DatagramPacket packet = new DatagramPacket(data, data.length, address);
-        socket.send(packet);
+        sendTo(data, data.length, address);
+    }
+
+    /**
+     * Sends the first {@code length} bytes of a buffer to the specified address.
+     */
+    public void sendTo(byte[] data, int length, SocketAddress address) throws IOException {
+        send(ByteBuffer.wrap(data, 0, length), address);
+    }
+
+    /**
+     * Sends the remaining bytes of a buffer as-is, subject to the amplification limit.
+     * Use {@link #sendPacket} for framed packets.
+     */
+    @Override
+    public void send(ByteBuffer data, SocketAddress address) throws IOException {
+        AmplificationLimiter limiter = amplificationLimiter;
+        int length = data.remaining();
+        if (limiter != null && !limiter.trySend(sourceTable.slotOf(address), address, length)) {
+            amplificationDrops++;
+            logger.log(Level.FINE, "Dropped {0}-byte send to unverified {1}: amplification budget exhausted",
+                new Object[]{length, address});
+            data.position(data.limit());
+            return;
+        }
+        transport.send(data, address);
     }
 
     /**
      * Sends a Neon packet to the specified address.
+     * A CRC32C trailer is appended when checksums are enabled on this socket.
      */
+    @Override
     public void sendPacket(NeonPacket packet, SocketAddress address) throws IOException {
-        byte[] data = packet.toBytes();
-        sendTo(data, address);
+        sendPacket(packet, address, checksumEnabled);
+    }
+
+    /**
+     * Sends a Neon packet to the specified address, choosing the framing explicitly.
+     * The relay uses this to mirror the framing of the packet it is forwarding.
+     *
+     * @param packet the packet to send
+     * @param address the destination address
+     * @param checksum true to append a CRC32C trailer
+     */
+    public void sendPacket(NeonPacket packet, SocketAddress address, boolean checksum) throws IOException {
+        sendEncoded(packet.toBytes(), address, checksum);
+    }
+
+    /**
+     * Sends a packet already serialized with {@link NeonPacket#encode}, framed exactly as
+     * {@link #sendPacket} would frame it.
+     */
+    public void sendEncoded(byte[] data, SocketAddress address) throws IOException {
+        sendEncoded(data, address, checksumEnabled);
+    }
+
+    private void sendEncoded(byte[] data, SocketAddress address, boolean checksum) throws IOException {
+        SessionCipher cipher = sessionCipher;
+        if (cipher == null || !SessionCipher.covers(data)) {
+            sendTo(checksum ? PacketChecksum.seal(data) : data, address);
+            return;
+        }
+
+        int capacity = data.length + SessionCipher.OVERHEAD + PacketChecksum.TRAILER_SIZE;
+        byte[] buffer = capacity <= bufferPool.getBufferSize() ? bufferPool.acquire() : new byte[capacity];
+        try {
+            System.arraycopy(data, 0, buffer, 0, data.length);
+            int length = cipher.seal(buffer, data.length);
+            if (checksum) {
+                length = PacketChecksum.sealInPlace(buffer, length);
+            }
+            sendTo(buffer, length, address);
+        } finally {
+            bufferPool.release(buffer);
+        }
+    }
+
+    /**
+     * Installs the session cipher. Game packets are then encrypted on send, and received
+     * game packets that fail authentication or replay checks are dropped in
+     * {@link #receive()}. Core packets are unaffected.
+     *
+     * @param cipher the cipher, or null to send and accept game packets in the clear
+     */
+    public void setSessionCipher(SessionCipher cipher) {
+        this.sessionCipher = cipher;
+    }
+
+    /**
+     * Gets the session cipher, or null if game packets are not encrypted.
+     */
+    public SessionCipher getSessionCipher() {
+        return sessionCipher;
+    }
+
+    /**
+     * Gets the number of datagrams dropped because they failed decryption or were replayed.
+     */
+    public long getUndecryptableDatagramCount() {
+        return undecryptableDatagrams;
+    }
+
+    /**
+     * Enables or disables the CRC32C trailer on outgoing packets.
+     * Incoming packets are accepted in either framing regardless of this setting.
+     *
+     * @param enabled true to checksum outgoing packets
+     */
+    public void setChecksumEnabled(boolean enabled) {
+        this.checksumEnabled = enabled;
+    }
+
+    /**
+     * Checks whether outgoing packets carry a CRC32C trailer.
+     */
+    public boolean isChecksumEnabled() {
+        return checksumEnabled;
+    }
+
+    /**
+     * Interns source addresses of received packets into a {@link SourceAddressTable}.
+     * Received packets then carry the canonical address instance and its slot, so callers
+     * can keep per-source state in arrays. This does not avoid the address the transport
+     * allocates for each datagram. Sources beyond the capacity are still received, with a
+     * slot of -1.
+     *
+     * @param capacity the maximum number of distinct sources to intern
+     */
+    public void enableSourceInterning(int capacity) {
+        this.sourceTable = new SourceAddressTable(capacity);
+    }
+
+    /**
+     * Gets the source address table, or null if interning is disabled.
+     */
+    public SourceAddressTable getSourceTable() {
+        return sourceTable;
+    }
+
+    /**
+     * Limits sends to unverified sources to {@code factor} times the bytes received from
+     * them. Requires source interning, since budgets are kept per slot; sends that exceed
+     * the budget are dropped silently and counted.
+     *
+     * @param factor bytes of response budget earned per byte received
+     * @throws IllegalStateException if source interning is not enabled
+     */
+    public void enableAmplificationLimit(int factor) {
+        if (sourceTable == null) {
+            throw new IllegalStateException("Source interning must be enabled before the amplification limit");
+        }
+        this.amplificationLimiter = new AmplificationLimiter(sourceTable.capacity(), factor);
+    }
+
+    /**
+     * Marks an address as able to receive replies, lifting its amplification budget.
+     * Does nothing when the amplification limit is disabled.
+     *
+     * @param address the verified address
+     */
+    public void markSourceVerified(SocketAddress address) {
+        AmplificationLimiter limiter = amplificationLimiter;
+        if (limiter != null) {
+            limiter.markVerified(sourceTable.slotOf(address), address);
+        }
+    }
+
+    /**
+     * Releases an interned source slot together with any per-slot send state.
+     *
+     * @param slot the slot to release
+     */
+    public void releaseSource(int slot) {
+        if (amplificationLimiter != null) {
+            amplificationLimiter.reset(slot);
+        }
+        sourceTable.release(slot);
+    }
+
+    /**
+     * Gets the amplification limiter, or null if the limit is disabled.
+     */
+    public AmplificationLimiter getAmplificationLimiter() {
+        return amplificationLimiter;
+    }
+
+    /**
+     * Gets the number of sends dropped because an unverified destination
+     * exhausted its amplification budget.
+     */
+    public long getAmplificationDroppedCount() {
+        return amplificationDrops;
+    }
+
+    /**
+     * Installs a CIDR filter applied to the raw source address of every datagram before
+     * any copy, interning or decoding. Datagrams from filtered sources are skipped and the
+     * next one is read. May be called from any thread to hot-swap the lists.
+     *
+     * @param filter the filter, or null to accept all sources
+     */
+    public void setSourceFilter(CidrFilter filter) {
+        this.sourceFilter = filter == null || filter.isEmpty() ? null : filter;
+    }
+
+    /**
+     * Gets the number of datagrams dropped by the source filter.
+     */
+    public long getFilteredDatagramCount() {
+        return filteredDatagrams;
+    }
+
+    /**
+     * Gets the number of datagrams dropped because of an unknown magic number
+     * or a failed checksum.
+     */
+    public long getRejectedDatagramCount() {
+        return rejectedDatagrams;
     }
 
     /**
@@ -111,41 +388,124 @@ public class NeonSocket implements AutoCloseable {
      *
      * When buffer enforcement is enabled, packets that fill the entire buffer
      * are logged as potential truncation and rejected if enforcement is strict.
+     *
+     * Datagrams from sources rejected by the {@link #setSourceFilter source filter} are
+     * skipped without being returned.
+     *
+     * Datagrams with an unknown magic number or a CRC32C trailer that does not match
+     * are dropped here, before any decoding, and the next datagram is read instead.
+     * Checksummed datagrams are returned with the trailer stripped.
+     *
+     * With a {@link #setSessionCipher session cipher} installed, game packets are
+     * decrypted in the pooled buffer and dropped if they are forged or replayed.
      */
     public ReceivedPacket receive() throws IOException {
         byte[] receiveBuffer = bufferPool.acquire();
-        DatagramPacket datagram = new DatagramPacket(receiveBuffer, receiveBuffer.length);
-
         try {
-            socket.receive(datagram);
-            int receivedLength = datagram.getLength();
-
-            if (config.isEnforceBufferSize() && receivedLength == receiveBuffer.length) {
-                logger.log(Level.WARNING,
-                    "Packet from {0} filled entire buffer ({1} bytes) - possible truncation, dropping packet",
-                    new Object[]{datagram.getSocketAddress(), receivedLength});
-                bufferPool.release(receiveBuffer);
+            Datagram datagram = receiveInto(receiveBuffer);
+            if (datagram == null) {
                 return null;
             }
+            byte[] data = new byte[datagram.length()];
+            System.arraycopy(receiveBuffer, 0, data, 0, datagram.length());
+            return new ReceivedPacket(data, datagram.source(), datagram.checksummed(), datagram.sourceSlot());
+        } finally {
+            bufferPool.release(receiveBuffer);
+        }
+    }
 
-            if (receivedLength < config.getMinBufferSize() && receivedLength < PacketHeader.HEADER_SIZE) {
-                logger.log(Level.WARNING,
-                    "Packet from {0} too small ({1} bytes, minimum header is {2} bytes)",
-                    new Object[]{datagram.getSocketAddress(), receivedLength, PacketHeader.HEADER_SIZE});
-                bufferPool.release(receiveBuffer);
+    /**
+     * Receives a packet into the buffer with the same checks as {@link #receive()}, leaving
+     * the bytes of the packet without any checksum trailer or encryption. As the
+     * {@link Transport} contract requires, a packet larger than the buffer's remaining
+     * space is truncated.
+     */
+    @Override
+    public SocketAddress receive(ByteBuffer buffer) throws IOException {
+        byte[] receiveBuffer = bufferPool.acquire();
+        try {
+            Datagram datagram = receiveInto(receiveBuffer);
+            if (datagram == null) {
                 return null;
             }
-
-            byte[] data = new byte[receivedLength];
-            System.arraycopy(receiveBuffer, 0, data, 0, receivedLength);
+            buffer.put(receiveBuffer, 0, Math.min(datagram.length(), buffer.remaining()));
+            return datagram.source();
+        } finally {
             bufferPool.release(receiveBuffer);
-            return new ReceivedPacket(data, datagram.getSocketAddress());
+        }
+    }
+
+    /**
+     * Receives the next datagram that passes every check into the pooled buffer and unwraps
+     * it in place. Rejected datagrams are skipped, so in blocking mode this returns only a
+     * packet or throws on timeout.
+     *
+     * @return the unwrapped datagram, or null if nothing is available in non-blocking mode
+     */
+    private Datagram receiveInto(byte[] receiveBuffer) throws IOException {
+        ByteBuffer buffer = ByteBuffer.wrap(receiveBuffer);
+        try {
+            while (true) {
+                buffer.clear();
+                SocketAddress source = transport.receive(buffer);
+                if (source == null) {
+                    return null;
+                }
+                CidrFilter filter = sourceFilter;
+                SourceAddressTable table = sourceTable;
+                InetSocketAddress inet = source instanceof InetSocketAddress address && address.getAddress() != null
+                    ? address : null;
+                byte[] raw = inet != null && (filter != null || table != null) ? inet.getAddress().getAddress() : null;
+                if (filter != null && raw != null && !filter.allows(raw, raw.length)) {
+                    filteredDatagrams++;
+                    continue;
+                }
+                int receivedLength = buffer.position();
+
+                if (config.isEnforceBufferSize() && receivedLength == receiveBuffer.length) {
+                    logger.log(Level.WARNING,
+                        "Packet from {0} filled entire buffer ({1} bytes) - possible truncation, dropping packet",
+                        new Object[]{source, receivedLength});
+                    continue;
+                }
+
+                if (receivedLength < config.getMinBufferSize() && receivedLength < PacketHeader.HEADER_SIZE) {
+                    logger.log(Level.WARNING,
+                        "Packet from {0} too small ({1} bytes, minimum header is {2} bytes)",
+                        new Object[]{source, receivedLength, PacketHeader.HEADER_SIZE});
+                    continue;
+                }
+
+                PacketChecksum.Framing framing = PacketChecksum.inspect(receiveBuffer, receivedLength);
+                if (framing == PacketChecksum.Framing.INVALID) {
+                    rejectedDatagrams++;
+                    logger.log(Level.FINE, "Dropped datagram from {0}: bad magic or checksum ({1} bytes)",
+                        new Object[]{source, receivedLength});
+                    continue;
+                }
+
+                boolean checksummed = framing == PacketChecksum.Framing.CHECKSUMMED;
+                int length = checksummed ? PacketChecksum.unsealInPlace(receiveBuffer, receivedLength) : receivedLength;
+                SessionCipher cipher = sessionCipher;
+                if (cipher != null) {
+                    length = cipher.open(receiveBuffer, length);
+                    if (length < 0) {
+                        undecryptableDatagrams++;
+                        logger.log(Level.FINE, "Dropped datagram from {0}: failed decryption or replayed", source);
+                        continue;
+                    }
+                }
+
+                int slot = table != null && raw != null ? table.intern(inet.getAddress(), raw, inet.getPort()) : -1;
+                if (amplificationLimiter != null) {
+                    amplificationLimiter.onReceived(slot, receivedLength);
+                }
+                return new Datagram(length, slot >= 0 ? table.addressOf(slot) : source, checksummed, slot);
+            }
         } catch (SocketTimeoutException e) {
-            bufferPool.release(receiveBuffer);
             throw e;
         } catch (IOException e) {
-            bufferPool.release(receiveBuffer);
-            if (!channel.isBlocking()) {
+            if (!transport.isBlocking()) {
                 return null;
             }
             throw e;
@@ -164,7 +524,7 @@ public class NeonSocket implements AutoCloseable {
 
         try {
             NeonPacket packet = NeonPacket.fromBytes(received.data());
-            return new ReceivedNeonPacket(packet, received.source());
+            return new ReceivedNeonPacket(packet, received.source(), received.checksummed(), received.sourceSlot());
         } catch (BufferUnderflowException e) {
             logger.log(Level.WARNING, "Buffer underflow parsing packet from {0}: packet too short or malformed", received.source());
             return null;
@@ -181,27 +541,58 @@ public class NeonSocket implements AutoCloseable {
      * Sets a receive timeout for blocking mode (in milliseconds).
      * Set to 0 for infinite timeout.
      */
-    public void setSoTimeout(int timeoutMs) throws SocketException {
-        socket.setSoTimeout(timeoutMs);
+    public void setSoTimeout(int timeoutMs) throws IOException {
+        transport.setTimeout(timeoutMs);
+    }
+
+    @Override
+    public void setTimeout(int timeoutMs) throws IOException {
+        transport.setTimeout(timeoutMs);
     }
 
     @Override
     public void close() throws IOException {
-        channel.close();
-        socket.close();
+        transport.close();
     }
 
+    @Override
     public boolean isClosed() {
-        return socket.isClosed();
+        return transport.isClosed();
     }
 
+    /**
+     * A datagram unwrapped in a receive buffer: its length after unwrapping, its source, whether
+     * it carried a checksum trailer and its interned source slot.
+     */
+    private record Datagram(int length, SocketAddress source, boolean checksummed, int sourceSlot) {}
+
     /**
      * Helper record for received raw packets.
+     * {@code checksummed} is true if the datagram arrived with a verified CRC32C trailer.
+     * {@code sourceSlot} is the interned source slot, or -1 if interning is disabled or full.
      */
-    public record ReceivedPacket(byte[] data, SocketAddress source) {}
+    public record ReceivedPacket(byte[] data, SocketAddress source, boolean checksummed, int sourceSlot) {
+        public ReceivedPacket(byte[] data, SocketAddress source, boolean checksummed) {
+            this(data, source, checksummed, -1);
+        }
+
+        public ReceivedPacket(byte[] data, SocketAddress source) {
+            this(data, source, false, -1);
+        }
+    }
 
     /**
      * Helper record for received Neon packets.
+     * {@code checksummed} is true if the datagram arrived with a verified CRC32C trailer.
+     * {@code sourceSlot} is the interned source slot, or -1 if interning is disabled or full.
      */
-    public record ReceivedNeonPacket(NeonPacket packet, SocketAddress source) {}
+    public record ReceivedNeonPacket(NeonPacket packet, SocketAddress source, boolean checksummed, int sourceSlot) {
+        public ReceivedNeonPacket(NeonPacket packet, SocketAddress source, boolean checksummed) {
+            this(packet, source, checksummed, -1);
+        }
+
+        public ReceivedNeonPacket(NeonPacket packet, SocketAddress source) {
+            this(packet, source, false, -1);
+        }
+    }
 }
@@ -0,0 +1,181 @@
+package com.quietterminal.projectneon.core;
+
+import java.util.zip.CRC32C;
+
+/**
+ * Optional CRC32C integrity trailer for Neon datagrams.
+ *
+ * <p>A checksummed datagram carries {@link #MAGIC_CHECKSUMMED} ("NC") in place of the
+ * regular header magic and ends with a 4-byte little-endian CRC32C computed over every
+ * byte before it. The magic identifies the framing, so receivers accept both forms and
+ * verify the trailer before any header or payload decoding takes place. Corrupt or
+ * truncated datagrams are rejected with a single pass over the bytes instead of failing
+ * deep inside a payload decoder.
+ *
+ * <p>Layout:
+ * <pre>
+ * [2 bytes] magic 0x4E43 ("NC")
+ * [6 bytes] remainder of the 8-byte header
+ * [N bytes] payload
+ * [4 bytes] CRC32C over all preceding bytes
+ * </pre>
+ *
+ * <p>{@link CRC32C} is intrinsified by HotSpot on x86 (SSE4.2) and AArch64, so the
+ * per-packet cost is a few nanoseconds for typical game payloads.
+ *
+ * @since 1.3
+ */
+public final class PacketChecksum {
+
+    /**
+     * Header magic for datagrams that carry a CRC32C trailer ("NC").
+     */
+    public static final short MAGIC_CHECKSUMMED = (short) 0x4E43;
+
+    /**
+     * Size of the CRC32C trailer in bytes.
+     */
+    public static final int TRAILER_SIZE = 4;
+
+    /**
+     * Framing of a raw datagram as determined by {@link #inspect(byte[], int)}.
+     */
+    public enum Framing {
+        /** Regular datagram without a trailer. */
+        PLAIN,
+        /** Datagram with a valid CRC32C trailer. */
+        CHECKSUMMED,
+        /** Unknown magic, truncated datagram, or checksum mismatch. */
+        INVALID
+    }
+
+    private PacketChecksum() {
+        /* No instantiation */
+    }
+
+    /**
+     * Determines the framing of a raw datagram and verifies its trailer if present.
+     * Never throws; anything that is not a well-formed Neon datagram is reported as
+     * {@link Framing#INVALID}.
+     *
+     * @param data the datagram bytes
+     * @param length the number of valid bytes in {@code data}
+     * @return the framing of the datagram
+     */
+    public static Framing inspect(byte[] data, int length) {
+        if (length < PacketHeader.HEADER_SIZE) {
+            return Framing.INVALID;
+        }
+
+        short magic = (short) ((data[0] & 0xFF) | (data[1] & 0xFF) << 8);
+        if (magic == PacketHeader.MAGIC) {
+            return Framing.PLAIN;
+        }
+        if (magic == MAGIC_CHECKSUMMED
+                && length >= PacketHeader.HEADER_SIZE + TRAILER_SIZE
+                && verify(data, length)) {
+            return Framing.CHECKSUMMED;
+        }
+        return Framing.INVALID;
+    }
+
+    /**
+     * Verifies the CRC32C trailer of a checksummed datagram.
+     *
+     * @param data the datagram bytes, including the trailer
+     * @param length the number of valid bytes in {@code data}
+     * @return true if the trailer matches the preceding bytes
+     */
+    public static boolean verify(byte[] data, int length) {
+        if (length < TRAILER_SIZE) {
+            return false;
+        }
+        int bodyLength = length - TRAILER_SIZE;
+        int expected = (data[bodyLength] & 0xFF)
+            | (data[bodyLength + 1] & 0xFF) << 8
+            | (data[bodyLength + 2] & 0xFF) << 16
+            | (data[bodyLength + 3] & 0xFF) << 24;
+        return compute(data, 0, bodyLength) == expected;
+    }
+
+    /**
+     * Computes the CRC32C of a byte range.
+     *
+     * @param data the bytes
+     * @param offset the start offset
+     * @param length the number of bytes
+     * @return the CRC32C value
+     */
+    public static int compute(byte[] data, int offset, int length) {
+        CRC32C crc = new CRC32C();
+        crc.update(data, offset, length);
+        return (int) crc.getValue();
+    }
+
+    /**
+     * Converts a serialized plain packet into its checksummed form.
+     *
+     * @param packet the serialized packet, starting with the regular header magic
+     * @return a new array with the checksummed magic and CRC32C trailer
+     */
+    public static byte[] seal(byte[] packet) {
+        if (packet.length < PacketHeader.HEADER_SIZE) {
+            throw new IllegalArgumentException("Packet too small to checksum");
+        }
+        byte[] sealed = new byte[packet.length + TRAILER_SIZE];
+        System.arraycopy(packet, 0, sealed, 0, packet.length);
+        sealInPlace(sealed, packet.length);
+        return sealed;
+    }
+
+    /**
+     * Converts a serialized plain packet into its checksummed form without copying.
+     *
+     * @param buf the buffer holding the packet; needs {@link #TRAILER_SIZE} spare bytes after it
+     * @param length the packet length
+     * @return the checksummed length
+     */
+    public static int sealInPlace(byte[] buf, int length) {
+        if (length < PacketHeader.HEADER_SIZE) {
+            throw new IllegalArgumentException("Packet too small to checksum");
+        }
+        buf[0] = (byte) MAGIC_CHECKSUMMED;
+        buf[1] = (byte) (MAGIC_CHECKSUMMED >> 8);
+
+        int crc = compute(buf, 0, length);
+        buf[length] = (byte) crc;
+        buf[length + 1] = (byte) (crc >> 8);
+        buf[length + 2] = (byte) (crc >> 16);
+        buf[length + 3] = (byte) (crc >> 24);
+        return length + TRAILER_SIZE;
+    }
+
+    /**
+     * Strips the trailer from a verified checksummed datagram and restores the regular magic.
+     * The caller must have verified the datagram with {@link #inspect(byte[], int)} first.
+     *
+     * @param data the checksummed datagram bytes
+     * @param length the number of valid bytes in {@code data}
+     * @return a new array holding the plain packet
+     */
+    public static byte[] unseal(byte[] data, int length) {
+        byte[] plain = new byte[length - TRAILER_SIZE];
+        System.arraycopy(data, 0, plain, 0, plain.length);
+        plain[0] = (byte) PacketHeader.MAGIC;
+        plain[1] = (byte) (PacketHeader.MAGIC >> 8);
+        return plain;
+    }
+
+    /**
+     * Strips the trailer from a verified checksummed datagram in place.
+     *
+     * @param data the checksummed datagram bytes
+     * @param length the number of valid bytes in {@code data}
+     * @return the plain packet length
+     */
+    public static int unsealInPlace(byte[] data, int length) {
+        data[0] = (byte) PacketHeader.MAGIC;
+        data[1] = (byte) (PacketHeader.MAGIC >> 8);
+        return length - TRAILER_SIZE;
+    }
+}
@@ -1,8 +1,5 @@
 package com.quietterminal.projectneon.core;
 
-import java.nio.ByteBuffer;
-import java.nio.ByteOrder;
-
 /**
  * Fixed 8-byte packet header for all Neon packets.
  *
@@ -13,6 +10,9 @@ import java.nio.ByteOrder;
  * - sequence: u16 (For ordering/reliability)
  * - client_id: u8 (Sender)
  * - destination_id: u8 (Target: 0=broadcast, 1=host, 2+=clients)
+ *
+ * Version 2 headers share the magic and type bytes but are variable-length;
+ * see {@link PacketHeaderV2}. {@link #fromBytes(byte[])} only decodes version 1.
  */
 public record PacketHeader(
     short magic,
@@ -46,15 +46,16 @@ public record PacketHeader(
      * Serializes the header to bytes (little-endian).
      */
     public byte[] toBytes() {
-        ByteBuffer buffer = ByteBuffer.allocate(HEADER_SIZE);
-        buffer.order(ByteOrder.LITTLE_ENDIAN);
-        buffer.putShort(magic);
-        buffer.put(version);
-        buffer.put(packetType);
-        buffer.putShort(sequence);
-        buffer.put(clientId);
-        buffer.put(destinationId);
-        return buffer.array();
+        byte[] bytes = new byte[HEADER_SIZE];
+        bytes[0] = (byte) magic;
+        bytes[1] = (byte) (magic >> 8);
+        bytes[2] = version;
+        bytes[3] = packetType;
+        bytes[4] = (byte) sequence;
+        bytes[5] = (byte) (sequence >> 8);
+        bytes[6] = clientId;
+        bytes[7] = destinationId;
+        return bytes;
     }
 
     /**
@@ -64,15 +65,13 @@ public record PacketHeader(
         if (bytes.length < HEADER_SIZE) {
             throw new IllegalArgumentException("Insufficient bytes for packet header");
         }
-        ByteBuffer buffer = ByteBuffer.wrap(bytes);
-        buffer.order(ByteOrder.LITTLE_ENDIAN);
         return new PacketHeader(
-            buffer.getShort(),
-            buffer.get(),
-            buffer.get(),
-            buffer.getShort(),
-            buffer.get(),
-            buffer.get()
+            (short) ((bytes[0] & 0xFF) | (bytes[1] & 0xFF) << 8),
+            bytes[2],
+            bytes[3],
+            (short) ((bytes[4] & 0xFF) | (bytes[5] & 0xFF) << 8),
+            bytes[6],
+            bytes[7]
         );
     }
 
@@ -0,0 +1,375 @@
+package com.quietterminal.projectneon.core;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Objects;
+
+/**
+ * Variable-length version 2 packet header.
+ *
+ * <p>Version 2 keeps the version 1 magic and type bytes so both can be told apart by the
+ * version byte alone, then widens the sequence to 32 bits and the ids to varints, and adds
+ * a flags byte and optional extension blocks.
+ *
+ * <p>Layout (multi-byte integers are unsigned LEB128 varints):
+ * <pre>
+ * [2 bytes] magic 0x4E45 ("NE", little-endian)
+ * [1 byte]  version = 2
+ * [1 byte]  packet_type
+ * [1 byte]  flags (see FLAG_* constants)
+ * [varint]  sequence (u32)
+ * [varint]  client_id
+ * [varint]  destination_id
+ * if FLAG_CONNECTION_ID:
+ *   [8 bytes] connection_id (relay-assigned, little-endian, see below)
+ * if FLAG_EXTENSIONS:
+ *   [varint] extension count
+ *   per extension: [1 byte] type, [varint] length, [N bytes] data
+ * </pre>
+ *
+ * <p>A header with small ids and a sequence below 128 encodes in 8 bytes, the same as
+ * version 1. Decoding reads the byte array directly without a {@code ByteBuffer}.
+ *
+ * <p>The connection id is assigned by the relay when a client joins and indexes its peer
+ * table directly; the remaining bits are random so an id cannot be guessed. A packet
+ * carrying a valid id is attributed to that peer even if it arrives from a new source
+ * address, which lets the relay follow NAT rebinding once the new path is validated.
+ *
+ * @since 1.3
+ */
+public record PacketHeaderV2(
+    byte packetType,
+    byte flags,
+    int sequence,
+    int clientId,
+    int destinationId,
+    long connectionId,
+    List<Extension> extensions
+) {
+    public static final byte VERSION = 2;
+    public static final int MIN_HEADER_SIZE = 8;
+    /** Largest header without extension blocks: fixed bytes, three 5-byte varints and a connection id. */
+    public static final int MAX_FIXED_HEADER_SIZE = 28;
+    /** Size of the connection id field when present. */
+    public static final int CONNECTION_ID_SIZE = 8;
+
+    /** An ACK bitfield is piggybacked in an extension block. */
+    public static final byte FLAG_ACK_PIGGYBACK = 0x01;
+    /** The payload is compressed. */
+    public static final byte FLAG_COMPRESSED = 0x02;
+    /** The payload is one fragment of a larger message. */
+    public static final byte FLAG_FRAGMENT = 0x04;
+    /** The packet belongs to a non-default channel, carried in an extension block. */
+    public static final byte FLAG_CHANNEL = 0x08;
+    /** A relay-assigned connection id follows the destination id. Set automatically when non-zero. */
+    public static final byte FLAG_CONNECTION_ID = 0x10;
+    /** Extension blocks follow the fixed fields. Set automatically when extensions are present. */
+    public static final byte FLAG_EXTENSIONS = (byte) 0x80;
+
+    private static final int MAX_EXTENSIONS = 16;
+    private static final int MAX_EXTENSION_LENGTH = 1024;
+
+    public PacketHeaderV2 {
+        Objects.requireNonNull(extensions, "extensions cannot be null");
+        if (clientId < 0 || destinationId < 0 || connectionId < 0) {
+            throw new IllegalArgumentException("Client, destination and connection IDs must be non-negative");
+        }
+        extensions = List.copyOf(extensions);
+        flags = extensions.isEmpty()
+            ? (byte) (flags & ~FLAG_EXTENSIONS)
+            : (byte) (flags | FLAG_EXTENSIONS);
+        flags = connectionId == 0
+            ? (byte) (flags & ~FLAG_CONNECTION_ID)
+            : (byte) (flags | FLAG_CONNECTION_ID);
+    }
+
+    /**
+     * Creates a version 2 header without extension blocks.
+     */
+    public static PacketHeaderV2 create(byte packetType, int sequence, int clientId, int destinationId) {
+        return new PacketHeaderV2(packetType, (byte) 0, sequence, clientId, destinationId, 0, List.of());
+    }
+
+    /**
+     * Creates a version 2 header carrying the same fields as a version 1 header.
+     */
+    public static PacketHeaderV2 fromV1(PacketHeader header) {
+        return create(header.packetType(), header.sequence() & 0xFFFF,
+            header.clientId() & 0xFF, header.destinationId() & 0xFF);
+    }
+
+    /**
+     * Returns a version 1 view of this header for code that routes on the fixed fields.
+     * The sequence is truncated to its low 16 bits and ids to their low 8 bits, and the
+     * version is 1 so the view stays valid if it is re-serialized on its own.
+     */
+    public PacketHeader toV1() {
+        return new PacketHeader(PacketHeader.MAGIC, PacketHeader.VERSION, packetType,
+            (short) sequence, (byte) clientId, (byte) destinationId);
+    }
+
+    /**
+     * Checks whether a flag bit is set.
+     */
+    public boolean hasFlag(byte flag) {
+        return (flags & flag) != 0;
+    }
+
+    /**
+     * Returns a copy of this header with additional flag bits set.
+     */
+    public PacketHeaderV2 withFlags(byte additionalFlags) {
+        return new PacketHeaderV2(packetType, (byte) (flags | additionalFlags),
+            sequence, clientId, destinationId, connectionId, extensions);
+    }
+
+    /**
+     * Returns a copy of this header carrying a relay-assigned connection id (0 for none).
+     */
+    public PacketHeaderV2 withConnectionId(long connectionId) {
+        return new PacketHeaderV2(packetType, flags, sequence, clientId, destinationId, connectionId, extensions);
+    }
+
+    /**
+     * Returns a copy of this header with an extension block appended.
+     */
+    public PacketHeaderV2 withExtension(Extension extension) {
+        List<Extension> next = new ArrayList<>(extensions);
+        next.add(extension);
+        return new PacketHeaderV2(packetType, flags, sequence, clientId, destinationId, connectionId, next);
+    }
+
+    /**
+     * Finds the first extension block of a type.
+     *
+     * @return the extension, or null if absent
+     */
+    public Extension findExtension(byte type) {
+        for (Extension extension : extensions) {
+            if (extension.type() == type) {
+                return extension;
+            }
+        }
+        return null;
+    }
+
+    /**
+     * Gets the number of bytes this header occupies on the wire.
+     */
+    public int encodedSize() {
+        int size = 5 + varintSize(sequence) + varintSize(clientId) + varintSize(destinationId);
+        if (connectionId != 0) {
+            size += CONNECTION_ID_SIZE;
+        }
+        if (!extensions.isEmpty()) {
+            size += varintSize(extensions.size());
+            for (Extension extension : extensions) {
+                size += 1 + varintSize(extension.data().length) + extension.data().length;
+            }
+        }
+        return size;
+    }
+
+    /**
+     * Serializes the header to a new array.
+     */
+    public byte[] toBytes() {
+        byte[] out = new byte[encodedSize()];
+        encodeTo(out, 0);
+        return out;
+    }
+
+    /**
+     * Serializes the header into an existing array.
+     *
+     * @param dst the destination array
+     * @param offset the offset to start writing at
+     * @return the offset just past the header
+     */
+    public int encodeTo(byte[] dst, int offset) {
+        int pos = offset;
+        dst[pos++] = (byte) PacketHeader.MAGIC;
+        dst[pos++] = (byte) (PacketHeader.MAGIC >> 8);
+        dst[pos++] = VERSION;
+        dst[pos++] = packetType;
+        dst[pos++] = flags;
+        pos = writeVarint(dst, pos, sequence);
+        pos = writeVarint(dst, pos, clientId);
+        pos = writeVarint(dst, pos, destinationId);
+        if (connectionId != 0) {
+            for (int i = 0; i < CONNECTION_ID_SIZE; i++) {
+                dst[pos++] = (byte) (connectionId >>> (8 * i));
+            }
+        }
+        if (!extensions.isEmpty()) {
+            pos = writeVarint(dst, pos, extensions.size());
+            for (Extension extension : extensions) {
+                dst[pos++] = extension.type();
+                pos = writeVarint(dst, pos, extension.data().length);
+                System.arraycopy(extension.data(), 0, dst, pos, extension.data().length);
+                pos += extension.data().length;
+            }
+        }
+        return pos;
+    }
+
+    /**
+     * Deserializes a version 2 header.
+     *
+     * @param src the source array
+     * @param offset the offset of the magic number
+     * @param length the number of valid bytes from {@code offset}
+     * @return the decoded header; its {@link #encodedSize()} gives the payload offset
+     * @throws IllegalArgumentException if the bytes are not a well-formed version 2 header,
+     *         including any encoding other than the canonical one {@link #encodeTo} writes
+     */
+    public static PacketHeaderV2 decode(byte[] src, int offset, int length) {
+        if (length < MIN_HEADER_SIZE) {
+            throw new IllegalArgumentException("Insufficient bytes for v2 packet header");
+        }
+        int limit = offset + length;
+        short magic = (short) ((src[offset] & 0xFF) | (src[offset + 1] & 0xFF) << 8);
+        if (magic != PacketHeader.MAGIC) {
+            throw new IllegalArgumentException(
+                String.format("Invalid magic number: 0x%04X (expected 0x%04X)",
+                    magic & 0xFFFF, PacketHeader.MAGIC & 0xFFFF));
+        }
+        if (src[offset + 2] != VERSION) {
+            throw new IllegalArgumentException("Not a v2 header: version " + (src[offset + 2] & 0xFF));
+        }
+        byte packetType = src[offset + 3];
+        byte flags = src[offset + 4];
+        int pos = offset + 5;
+
+        long r = readVarint(src, pos, limit);
+        int sequence = (int) r;
+        pos = (int) (r >>> 32);
+        r = readVarint(src, pos, limit);
+        int clientId = (int) r;
+        pos = (int) (r >>> 32);
+        r = readVarint(src, pos, limit);
+        int destinationId = (int) r;
+        pos = (int) (r >>> 32);
+        long connectionId = 0;
+        if ((flags & FLAG_CONNECTION_ID) != 0) {
+            if (limit - pos < CONNECTION_ID_SIZE) {
+                throw new IllegalArgumentException("Buffer underflow: truncated connection id");
+            }
+            for (int i = 0; i < CONNECTION_ID_SIZE; i++) {
+                connectionId |= (src[pos++] & 0xFFL) << (8 * i);
+            }
+            if (connectionId == 0) {
+                throw new IllegalArgumentException("Connection id flag set without a connection id");
+            }
+        }
+
+        List<Extension> extensions = List.of();
+        if ((flags & FLAG_EXTENSIONS) != 0) {
+            r = readVarint(src, pos, limit);
+            int count = (int) r;
+            pos = (int) (r >>> 32);
+            if (count == 0) {
+                throw new IllegalArgumentException("Extensions flag set without extensions");
+            }
+            if (count < 0 || count > MAX_EXTENSIONS) {
+                throw new IllegalArgumentException("Extension count " + count + " exceeds maximum of " + MAX_EXTENSIONS);
+            }
+            extensions = new ArrayList<>(count);
+            for (int i = 0; i < count; i++) {
+                if (pos >= limit) {
+                    throw new IllegalArgumentException("Buffer underflow: not enough bytes for extension type");
+                }
+                byte type = src[pos++];
+                r = readVarint(src, pos, limit);
+                int extLength = (int) r;
+                pos = (int) (r >>> 32);
+                if (extLength < 0 || extLength > MAX_EXTENSION_LENGTH || extLength > limit - pos) {
+                    throw new IllegalArgumentException("Buffer underflow: invalid extension length " + extLength);
+                }
+                extensions.add(new Extension(type, Arrays.copyOfRange(src, pos, pos + extLength)));
+                pos += extLength;
+            }
+        }
+
+        return new PacketHeaderV2(packetType, flags, sequence, clientId, destinationId, connectionId, extensions);
+    }
+
+    static int varintSize(int value) {
+        int size = 1;
+        while ((value & ~0x7F) != 0) {
+            value >>>= 7;
+            size++;
+        }
+        return size;
+    }
+
+    private static int writeVarint(byte[] dst, int pos, int value) {
+        while ((value & ~0x7F) != 0) {
+            dst[pos++] = (byte) ((value & 0x7F) | 0x80);
+            value >>>= 7;
+        }
+        dst[pos++] = (byte) value;
+        return pos;
+    }
+
+    /**
+     * Reads an unsigned 32-bit varint. Returns the value in the low 32 bits and the
+     * position after it in the high 32 bits, so the hot path allocates nothing. Only the
+     * shortest encoding is accepted, so the header's encoded size matches the bytes read.
+     */
+    private static long readVarint(byte[] src, int pos, int limit) {
+        int value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            if (pos >= limit) {
+                throw new IllegalArgumentException("Buffer underflow: truncated varint");
+            }
+            byte b = src[pos++];
+            value |= (b & 0x7F) << shift;
+            if (b >= 0) {
+                if ((b == 0 && shift > 0) || (shift == 28 && b > 0x0F)) {
+                    throw new IllegalArgumentException("Malformed varint: non-canonical encoding");
+                }
+                return ((long) pos << 32) | (value & 0xFFFFFFFFL);
+            }
+        }
+        throw new IllegalArgumentException("Malformed varint: more than 5 bytes");
+    }
+
+    @Override
+    public String toString() {
+        return String.format(
+            "PacketHeaderV2[type=0x%02X, flags=0x%02X, seq=%d, from=%d, to=%d, conn=%d, extensions=%d]",
+            packetType & 0xFF, flags & 0xFF, Integer.toUnsignedLong(sequence),
+            clientId, destinationId, connectionId, extensions.size()
+        );
+    }
+
+    /**
+     * Optional typed extension block carried after the fixed header fields.
+     */
+    public record Extension(byte type, byte[] data) {
+        public Extension {
+            Objects.requireNonNull(data, "data cannot be null");
+            if (data.length > MAX_EXTENSION_LENGTH) {
+                throw new IllegalArgumentException(
+                    "Extension length " + data.length + " exceeds maximum of " + MAX_EXTENSION_LENGTH);
+            }
+        }
+
+        @Override
+        public boolean equals(Object o) {
+            return o instanceof Extension other && type == other.type && Arrays.equals(data, other.data);
+        }
+
+        @Override
+        public int hashCode() {
+            return 31 * type + Arrays.hashCode(data);
+        }
+
+        @Override
+        public String toString() {
+            return String.format("Extension[type=0x%02X, length=%d]", type & 0xFF, data.length);
+        }
+    }
+}
@@ -4,7 +4,9 @@ import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
 import java.nio.charset.StandardCharsets;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.List;
+import java.util.Objects;
 
 /**
  * Base interface for all packet payloads.
@@ -28,6 +30,18 @@ public interface PacketPayload {
     int MAX_DESCRIPTION_LENGTH = 256;
     int MAX_PACKET_COUNT = 100;
     int MAX_PAYLOAD_SIZE = 65507;
+    int MAX_COOKIE_LENGTH = 64;
+    int MAX_KEY_SHARE_LENGTH = 128;
+
+    /**
+     * Shared empty retry cookie.
+     */
+    byte[] NO_COOKIE = new byte[0];
+
+    /**
+     * Shared empty key share.
+     */
+    byte[] NO_KEY_SHARE = NO_COOKIE;
 
     byte[] toBytes();
 
@@ -43,22 +57,122 @@ public interface PacketPayload {
         return sanitized.trim();
     }
 
-    record ConnectRequest(byte clientVersion, String desiredName, int targetSessionId, int gameIdentifier)
-        implements PacketPayload {
+    /**
+     * Reads an optional length-prefixed field trailing a connect payload.
+     */
+    private static byte[] readOptionalBytes(ByteBuffer buffer, int maxLength, String what) {
+        if (!buffer.hasRemaining()) {
+            return NO_COOKIE;
+        }
+        int len = buffer.get() & 0xFF;
+        if (len > maxLength) {
+            throw new IllegalArgumentException(what + " length " + len + " exceeds maximum of " + maxLength);
+        }
+        if (buffer.remaining() < len) {
+            throw new IllegalArgumentException("Buffer underflow: not enough bytes for " + what.toLowerCase());
+        }
+        if (len == 0) {
+            return NO_COOKIE;
+        }
+        byte[] bytes = new byte[len];
+        buffer.get(bytes);
+        return bytes;
+    }
+
+    private static byte[] readRetryCookie(ByteBuffer buffer) {
+        return readOptionalBytes(buffer, MAX_COOKIE_LENGTH, "Retry cookie");
+    }
+
+    private static byte[] readKeyShare(ByteBuffer buffer) {
+        return readOptionalBytes(buffer, MAX_KEY_SHARE_LENGTH, "Key share");
+    }
+
+    /**
+     * Connection request sent by a client.
+     *
+     * <p>{@code retryCookie} is an optional trailing length-prefixed field echoing the cookie
+     * from a relay's retry {@link ConnectDeny}; it is omitted on the wire when empty.
+     * {@code keyShare} is the client's {@link KeyExchange} public key when it asks for an
+     * encrypted session; it follows the cookie field, which is then written even when empty.
+     */
+    record ConnectRequest(byte clientVersion, String desiredName, int targetSessionId, int gameIdentifier,
+                          byte[] retryCookie, byte[] keyShare) implements PacketPayload {
+
+        public ConnectRequest(byte clientVersion, String desiredName, int targetSessionId, int gameIdentifier) {
+            this(clientVersion, desiredName, targetSessionId, gameIdentifier, NO_COOKIE, NO_KEY_SHARE);
+        }
+
+        public ConnectRequest(byte clientVersion, String desiredName, int targetSessionId, int gameIdentifier,
+                              byte[] retryCookie) {
+            this(clientVersion, desiredName, targetSessionId, gameIdentifier, retryCookie, NO_KEY_SHARE);
+        }
+
+        public ConnectRequest {
+            retryCookie = retryCookie == null ? NO_COOKIE : retryCookie;
+            keyShare = keyShare == null ? NO_KEY_SHARE : keyShare;
+        }
+
+        /**
+         * Returns a copy of this request carrying the given retry cookie.
+         */
+        public ConnectRequest withRetryCookie(byte[] cookie) {
+            return new ConnectRequest(clientVersion, desiredName, targetSessionId, gameIdentifier, cookie, keyShare);
+        }
+
+        /**
+         * Returns a copy of this request carrying the given key share.
+         */
+        public ConnectRequest withKeyShare(byte[] share) {
+            return new ConnectRequest(clientVersion, desiredName, targetSessionId, gameIdentifier, retryCookie, share);
+        }
 
         @Override
         public byte[] toBytes() {
             byte[] nameBytes = desiredName.getBytes(StandardCharsets.UTF_8);
-            ByteBuffer buffer = ByteBuffer.allocate(1 + 4 + nameBytes.length + 4 + 4);
+            int keyShareSize = keyShare.length > 0 ? 1 + keyShare.length : 0;
+            int cookieSize = retryCookie.length > 0 || keyShareSize > 0 ? 1 + retryCookie.length : 0;
+            ByteBuffer buffer = ByteBuffer.allocate(1 + 4 + nameBytes.length + 4 + 4 + cookieSize + keyShareSize);
             buffer.order(ByteOrder.LITTLE_ENDIAN);
             buffer.put(clientVersion);
             buffer.putInt(nameBytes.length);
             buffer.put(nameBytes);
             buffer.putInt(targetSessionId);
             buffer.putInt(gameIdentifier);
+            if (cookieSize > 0) {
+                buffer.put((byte) retryCookie.length);
+                buffer.put(retryCookie);
+            }
+            if (keyShareSize > 0) {
+                buffer.put((byte) keyShare.length);
+                buffer.put(keyShare);
+            }
             return buffer.array();
         }
 
+        @Override
+        public boolean equals(Object o) {
+            return o instanceof ConnectRequest other
+                && clientVersion == other.clientVersion
+                && targetSessionId == other.targetSessionId
+                && gameIdentifier == other.gameIdentifier
+                && desiredName.equals(other.desiredName)
+                && Arrays.equals(retryCookie, other.retryCookie)
+                && Arrays.equals(keyShare, other.keyShare);
+        }
+
+        @Override
+        public int hashCode() {
+            return (Objects.hash(clientVersion, desiredName, targetSessionId, gameIdentifier)
+                * 31 + Arrays.hashCode(retryCookie)) * 31 + Arrays.hashCode(keyShare);
+        }
+
+        @Override
+        public String toString() {
+            return "ConnectRequest[clientVersion=" + clientVersion + ", desiredName=" + desiredName
+                + ", targetSessionId=" + targetSessionId + ", gameIdentifier=" + gameIdentifier
+                + ", retryCookie=" + retryCookie.length + " bytes, keyShare=" + keyShare.length + " bytes]";
+        }
+
         public static ConnectRequest fromBytes(byte[] bytes) {
             ByteBuffer buffer = ByteBuffer.wrap(bytes);
             buffer.order(ByteOrder.LITTLE_ENDIAN);
@@ -91,21 +205,64 @@ public interface PacketPayload {
                 throw new IllegalArgumentException("Session ID must be a positive integer, got: " + sessionId);
             }
             int gameId = buffer.getInt();
-            return new ConnectRequest(version, name, sessionId, gameId);
+            byte[] cookie = readRetryCookie(buffer);
+            return new ConnectRequest(version, name, sessionId, gameId, cookie, readKeyShare(buffer));
         }
     }
 
-    record ConnectAccept(byte assignedClientId, int sessionId, long sessionToken) implements PacketPayload {
+    /**
+     * Connection acceptance sent by the host.
+     *
+     * <p>{@code keyShare} is an optional trailing length-prefixed field answering a
+     * {@link ConnectRequest#keyShare()}: the cipher suite id, the host's {@link KeyExchange}
+     * public key and the wrapped session secret. It is omitted on the wire when empty.
+     */
+    record ConnectAccept(byte assignedClientId, int sessionId, long sessionToken, byte[] keyShare)
+        implements PacketPayload {
+
+        public ConnectAccept(byte assignedClientId, int sessionId, long sessionToken) {
+            this(assignedClientId, sessionId, sessionToken, NO_KEY_SHARE);
+        }
+
+        public ConnectAccept {
+            keyShare = keyShare == null ? NO_KEY_SHARE : keyShare;
+        }
+
         @Override
         public byte[] toBytes() {
-            ByteBuffer buffer = ByteBuffer.allocate(1 + 4 + 8);
+            int keyShareSize = keyShare.length > 0 ? 1 + keyShare.length : 0;
+            ByteBuffer buffer = ByteBuffer.allocate(1 + 4 + 8 + keyShareSize);
             buffer.order(ByteOrder.LITTLE_ENDIAN);
             buffer.put(assignedClientId);
             buffer.putInt(sessionId);
             buffer.putLong(sessionToken);
+            if (keyShareSize > 0) {
+                buffer.put((byte) keyShare.length);
+                buffer.put(keyShare);
+            }
             return buffer.array();
         }
 
+        @Override
+        public boolean equals(Object o) {
+            return o instanceof ConnectAccept other
+                && assignedClientId == other.assignedClientId
+                && sessionId == other.sessionId
+                && sessionToken == other.sessionToken
+                && Arrays.equals(keyShare, other.keyShare);
+        }
+
+        @Override
+        public int hashCode() {
+            return Objects.hash(assignedClientId, sessionId, sessionToken) * 31 + Arrays.hashCode(keyShare);
+        }
+
+        @Override
+        public String toString() {
+            return "ConnectAccept[assignedClientId=" + assignedClientId + ", sessionId=" + sessionId
+                + ", sessionToken=" + sessionToken + ", keyShare=" + keyShare.length + " bytes]";
+        }
+
         public static ConnectAccept fromBytes(byte[] bytes) {
             ByteBuffer buffer = ByteBuffer.wrap(bytes);
             buffer.order(ByteOrder.LITTLE_ENDIAN);
@@ -118,21 +275,66 @@ public interface PacketPayload {
                 throw new IllegalArgumentException("Session ID must be a positive integer, got: " + sessionId);
             }
             long token = buffer.getLong();
-            return new ConnectAccept(clientId, sessionId, token);
+            return new ConnectAccept(clientId, sessionId, token, readKeyShare(buffer));
         }
     }
 
-    record ConnectDeny(String reason) implements PacketPayload {
+    /**
+     * Connection refusal.
+     *
+     * <p>A deny carrying a non-empty {@code retryCookie} is a stateless retry request from a
+     * relay: the client should resend its {@link ConnectRequest} with the cookie attached.
+     * The cookie is an optional trailing field, omitted on the wire when empty.
+     */
+    record ConnectDeny(String reason, byte[] retryCookie) implements PacketPayload {
+
+        public ConnectDeny(String reason) {
+            this(reason, NO_COOKIE);
+        }
+
+        public ConnectDeny {
+            retryCookie = retryCookie == null ? NO_COOKIE : retryCookie;
+        }
+
+        /**
+         * Checks whether this deny asks the client to retry with a cookie.
+         */
+        public boolean isRetry() {
+            return retryCookie.length > 0;
+        }
+
         @Override
         public byte[] toBytes() {
             byte[] reasonBytes = reason.getBytes(StandardCharsets.UTF_8);
-            ByteBuffer buffer = ByteBuffer.allocate(4 + reasonBytes.length);
+            int cookieSize = retryCookie.length > 0 ? 1 + retryCookie.length : 0;
+            ByteBuffer buffer = ByteBuffer.allocate(4 + reasonBytes.length + cookieSize);
             buffer.order(ByteOrder.LITTLE_ENDIAN);
             buffer.putInt(reasonBytes.length);
             buffer.put(reasonBytes);
+            if (cookieSize > 0) {
+                buffer.put((byte) retryCookie.length);
+                buffer.put(retryCookie);
+            }
             return buffer.array();
         }
 
+        @Override
+        public boolean equals(Object o) {
+            return o instanceof ConnectDeny other
+                && reason.equals(other.reason)
+                && Arrays.equals(retryCookie, other.retryCookie);
+        }
+
+        @Override
+        public int hashCode() {
+            return reason.hashCode() * 31 + Arrays.hashCode(retryCookie);
+        }
+
+        @Override
+        public String toString() {
+            return "ConnectDeny[reason=" + reason + ", retryCookie=" + retryCookie.length + " bytes]";
+        }
+
         public static ConnectDeny fromBytes(byte[] bytes) {
             ByteBuffer buffer = ByteBuffer.wrap(bytes);
             buffer.order(ByteOrder.LITTLE_ENDIAN);
@@ -149,18 +351,41 @@ public interface PacketPayload {
             byte[] reasonBytes = new byte[len];
             buffer.get(reasonBytes);
             String reason = new String(reasonBytes, StandardCharsets.UTF_8);
-            return new ConnectDeny(reason);
+            return new ConnectDeny(reason, readRetryCookie(buffer));
         }
     }
 
-    record SessionConfig(byte version, short tickRate, short maxPacketSize) implements PacketPayload {
+    /**
+     * Session parameters announced by the host.
+     *
+     * <p>{@code flags} is an optional trailing byte; it is omitted on the wire when zero so
+     * that peers predating it still parse the 5-byte form.
+     */
+    record SessionConfig(byte version, short tickRate, short maxPacketSize, byte flags) implements PacketPayload {
+
+        /**
+         * Flag bit: peers in this session should append a CRC32C trailer to outgoing packets.
+         */
+        public static final byte FLAG_CHECKSUM = 0x01;
+
+        public SessionConfig(byte version, short tickRate, short maxPacketSize) {
+            this(version, tickRate, maxPacketSize, (byte) 0);
+        }
+
+        public boolean hasFlag(byte flag) {
+            return (flags & flag) != 0;
+        }
+
         @Override
         public byte[] toBytes() {
-            ByteBuffer buffer = ByteBuffer.allocate(1 + 2 + 2);
+            ByteBuffer buffer = ByteBuffer.allocate(flags != 0 ? 6 : 5);
             buffer.order(ByteOrder.LITTLE_ENDIAN);
             buffer.put(version);
             buffer.putShort(tickRate);
             buffer.putShort(maxPacketSize);
+            if (flags != 0) {
+                buffer.put(flags);
+            }
             return buffer.array();
         }
 
@@ -173,7 +398,8 @@ public interface PacketPayload {
             byte version = buffer.get();
             short tickRate = buffer.getShort();
             short maxPacketSize = buffer.getShort();
-            return new SessionConfig(version, tickRate, maxPacketSize);
+            byte flags = buffer.hasRemaining() ? buffer.get() : 0;
+            return new SessionConfig(version, tickRate, maxPacketSize, flags);
         }
     }
 
@@ -259,6 +485,41 @@ public interface PacketPayload {
         }
     }
 
+    /**
+     * Path MTU probe. The probe id takes the place of the ping timestamp and is followed by
+     * {@code padding} zero bytes that bring the datagram up to the size being probed. The
+     * client sends it as a {@link PacketType#PING}; the relay forwards it at full size and
+     * the host echoes it back as a {@link PacketType#PONG} of the same size, so a confirmed
+     * probe has crossed the whole path in both directions. Any PING or PONG payload longer
+     * than a plain timestamp decodes as a probe. Probe ids are negative so they never
+     * collide with real ping timestamps.
+     *
+     * @see PathMtuDiscovery
+     */
+    record MtuProbe(long probeId, int padding) implements PacketPayload {
+        public MtuProbe {
+            if (padding < 0 || padding > MAX_PAYLOAD_SIZE - 8) {
+                throw new IllegalArgumentException("MTU probe padding must be between 0 and " + (MAX_PAYLOAD_SIZE - 8)
+                    + ", got: " + padding);
+            }
+        }
+
+        @Override
+        public byte[] toBytes() {
+            byte[] bytes = new byte[8 + padding];
+            ByteBuffer.wrap(bytes).order(ByteOrder.LITTLE_ENDIAN).putLong(probeId);
+            return bytes;
+        }
+
+        public static MtuProbe fromBytes(byte[] bytes) {
+            if (bytes.length < 8) {
+                throw new IllegalArgumentException("Buffer underflow: not enough bytes for MtuProbe (expected at least 8 bytes)");
+            }
+            long probeId = ByteBuffer.wrap(bytes).order(ByteOrder.LITTLE_ENDIAN).getLong();
+            return new MtuProbe(probeId, bytes.length - 8);
+        }
+    }
+
     record Ping(long timestamp) implements PacketPayload {
         @Override
         public byte[] toBytes() {
@@ -0,0 +1,255 @@
+package com.quietterminal.projectneon.core;
+
+import com.quietterminal.projectneon.util.LoggerConfig;
+
+import java.util.logging.Level;
+import java.util.logging.Logger;
+
+/**
+ * Packetization-layer path MTU discovery for a single peer.
+ *
+ * <p>Starts from {@link PayloadSizeEnforcer#MTU_SAFE_PAYLOAD}, which every path is assumed
+ * to carry, and binary-searches upward with padded {@link PacketPayload.MtuProbe} datagrams
+ * sent with the don't-fragment bit set. A probe size is confirmed when the peer echoes the
+ * probe at the same size, and rejected after {@code maxProbes} unanswered attempts
+ * or a local "message too long" send failure. Once the search converges the confirmed size is
+ * re-validated periodically and the search is retried upward; if re-validation fails the
+ * path is assumed to have changed, the MTU falls back to the safe base and the search
+ * starts over.
+ *
+ * <p>Sizes are UDP payload sizes, i.e. whole Neon datagrams including the header.
+ * Not thread-safe: drive it from the thread that sends and receives for the peer.
+ *
+ * @since 1.3
+ */
+public final class PathMtuDiscovery {
+    private static final Logger logger;
+
+    static {
+        logger = Logger.getLogger(PathMtuDiscovery.class.getName());
+        LoggerConfig.configureLogger(logger);
+    }
+
+    /**
+     * Size every path is assumed to carry.
+     */
+    public static final int BASE_MTU = PayloadSizeEnforcer.MTU_SAFE_PAYLOAD;
+
+    /**
+     * The search stops once the remaining range is smaller than this.
+     */
+    public static final int SEARCH_GRANULARITY = 16;
+
+    /**
+     * Discovery state.
+     */
+    public enum State {
+        /** Probing for a larger size. */
+        SEARCHING,
+        /** Converged; the confirmed size is re-validated periodically. */
+        SEARCH_COMPLETE
+    }
+
+    private final int maxMtu;
+    private final int maxProbes;
+    private final long probeTimeoutMs;
+    private final long revalidateIntervalMs;
+
+    private State state = State.SEARCHING;
+    private int confirmedMtu = BASE_MTU;
+    private int searchHigh;
+    private long lastCompletedAt;
+
+    private int probeSize;
+    private boolean probeOutstanding;
+    private long probeId;
+    private long probeSentAt;
+    private int probeAttempts;
+
+    /**
+     * Creates a discovery instance.
+     *
+     * @param maxMtu the largest datagram size to try
+     * @param maxProbes unanswered probes before a size is rejected
+     * @param probeTimeoutMs how long to wait for a probe to be confirmed
+     * @param revalidateIntervalMs how often to re-check the confirmed size once converged
+     */
+    public PathMtuDiscovery(int maxMtu, int maxProbes, long probeTimeoutMs, long revalidateIntervalMs) {
+        if (maxMtu < BASE_MTU || maxMtu > PayloadSizeEnforcer.UDP_MAX_PAYLOAD) {
+            throw new IllegalArgumentException("maxMtu must be between " + BASE_MTU + " and "
+                + PayloadSizeEnforcer.UDP_MAX_PAYLOAD + ", got: " + maxMtu);
+        }
+        if (maxProbes <= 0) {
+            throw new IllegalArgumentException("maxProbes must be positive, got: " + maxProbes);
+        }
+        if (probeTimeoutMs <= 0 || revalidateIntervalMs <= 0) {
+            throw new IllegalArgumentException("Probe timeout and revalidation interval must be positive");
+        }
+        this.maxMtu = maxMtu;
+        this.maxProbes = maxProbes;
+        this.probeTimeoutMs = probeTimeoutMs;
+        this.revalidateIntervalMs = revalidateIntervalMs;
+        this.searchHigh = maxMtu;
+        if (maxMtu - BASE_MTU < SEARCH_GRANULARITY) {
+            state = State.SEARCH_COMPLETE;
+        }
+    }
+
+    /**
+     * Creates a discovery instance from NeonConfig settings.
+     */
+    public static PathMtuDiscovery fromConfig(NeonConfig config) {
+        return new PathMtuDiscovery(config.getPathMtuMaxSize(), 3,
+            config.getReliablePacketTimeoutMs() / 2, 60_000);
+    }
+
+    /**
+     * Returns the datagram size to probe now, or 0 if no probe is due.
+     * An outstanding probe that timed out is retried at the same size until
+     * {@code maxProbes} attempts have failed.
+     *
+     * @param now the current time in milliseconds
+     */
+    public int nextProbeSize(long now) {
+        if (probeOutstanding) {
+            if (now - probeSentAt < probeTimeoutMs) {
+                return 0;
+            }
+            probeOutstanding = false;
+            if (probeAttempts >= maxProbes) {
+                onProbeRejected(probeSize);
+                return nextProbeSize(now);
+            }
+            return probeSize;
+        }
+
+        if (state == State.SEARCH_COMPLETE) {
+            if (now - lastCompletedAt < revalidateIntervalMs) {
+                return 0;
+            }
+            if (confirmedMtu > BASE_MTU) {
+                probeAttempts = 0;
+                probeSize = confirmedMtu;
+                return probeSize;
+            }
+            if (maxMtu - BASE_MTU < SEARCH_GRANULARITY) {
+                return 0;
+            }
+            searchHigh = maxMtu;
+            state = State.SEARCHING;
+        }
+
+        probeAttempts = 0;
+        probeSize = (confirmedMtu + searchHigh + 1) >>> 1;
+        return probeSize;
+    }
+
+    /**
+     * Records that a probe of {@link #nextProbeSize(long)} bytes was sent.
+     *
+     * @param probeId the identifier echoed back by the peer
+     * @param now the current time in milliseconds
+     */
+    public void onProbeSent(long probeId, long now) {
+        this.probeId = probeId;
+        probeOutstanding = true;
+        probeSentAt = now;
+        probeAttempts++;
+    }
+
+    /**
+     * Records that a probe could not be sent because it exceeds the local interface MTU.
+     */
+    public void onProbeTooLarge() {
+        probeOutstanding = false;
+        onProbeRejected(probeSize);
+    }
+
+    /**
+     * Checks whether an echoed identifier belongs to the outstanding probe.
+     */
+    public boolean isOutstandingProbe(long probeId) {
+        return probeOutstanding && this.probeId == probeId;
+    }
+
+    /**
+     * Processes a confirmation echoed by the peer.
+     *
+     * @param probeId the echoed identifier
+     * @return true if it confirmed the outstanding probe
+     */
+    public boolean onProbeConfirmed(long probeId) {
+        if (!isOutstandingProbe(probeId)) {
+            return false;
+        }
+        probeOutstanding = false;
+        if (probeSize > confirmedMtu) {
+            confirmedMtu = probeSize;
+            logger.log(Level.FINE, "Path MTU probe of {0} bytes confirmed", probeSize);
+        }
+        if (state == State.SEARCH_COMPLETE) {
+            lastCompletedAt = probeSentAt;
+            if (confirmedMtu < maxMtu) {
+                searchHigh = maxMtu;
+                state = State.SEARCHING;
+            }
+        } else {
+            checkConverged();
+        }
+        return true;
+    }
+
+    /**
+     * Resets discovery to the safe base, e.g. after the local socket or route changed.
+     */
+    public void reset() {
+        confirmedMtu = BASE_MTU;
+        searchHigh = maxMtu;
+        probeOutstanding = false;
+        probeAttempts = 0;
+        state = maxMtu - BASE_MTU < SEARCH_GRANULARITY ? State.SEARCH_COMPLETE : State.SEARCHING;
+    }
+
+    private void onProbeRejected(int size) {
+        if (state == State.SEARCH_COMPLETE && size == confirmedMtu) {
+            logger.log(Level.INFO, "Path MTU of {0} bytes no longer confirmed, falling back to {1}",
+                new Object[]{confirmedMtu, BASE_MTU});
+            reset();
+            return;
+        }
+        searchHigh = Math.max(confirmedMtu, size - 1);
+        checkConverged();
+    }
+
+    private void checkConverged() {
+        if (searchHigh - confirmedMtu < SEARCH_GRANULARITY) {
+            searchHigh = confirmedMtu;
+            state = State.SEARCH_COMPLETE;
+            lastCompletedAt = probeSentAt;
+            logger.log(Level.FINE, "Path MTU search complete at {0} bytes", confirmedMtu);
+        }
+    }
+
+    /**
+     * Gets the largest datagram size confirmed for this path.
+     */
+    public int getPathMtu() {
+        return confirmedMtu;
+    }
+
+    /**
+     * Gets the largest payload that fits in one datagram on this path.
+     *
+     * @param overhead header and trailer bytes added around the payload
+     */
+    public int getMaxPayloadSize(int overhead) {
+        return confirmedMtu - overhead;
+    }
+
+    /**
+     * Gets the current discovery state.
+     */
+    public State getState() {
+        return state;
+    }
+}
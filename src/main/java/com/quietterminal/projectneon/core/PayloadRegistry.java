@@ -1,8 +1,6 @@
 package com.quietterminal.projectneon.core;
 
-import java.util.Map;
 import java.util.Optional;
-import java.util.concurrent.ConcurrentHashMap;
 
 /**
  * Registry for packet payload deserializers.
@@ -30,10 +28,18 @@ import java.util.concurrent.ConcurrentHashMap;
  * // Register it
  * PayloadRegistry.register((byte) 0x20, PlayerPosition::fromBytes);
  * }</pre>
+ *
+ * <p>Packet types are a single byte, so deserializers live in a 256-slot array indexed
+ * by the unsigned type. Registration copies the array and publishes the new snapshot,
+ * which keeps the decode path to a single volatile read and array load with no boxing.
  */
 public final class PayloadRegistry {
 
-    private static final Map<Byte, PayloadDeserializer<?>> customDeserializers = new ConcurrentHashMap<>();
+    private static final int TABLE_SIZE = 256;
+    private static final Object writeLock = new Object();
+
+    private static volatile PayloadDeserializer<?>[] customDeserializers = new PayloadDeserializer<?>[TABLE_SIZE];
+    private static volatile int registeredCount = 0;
 
     private PayloadRegistry() {
         /* No instantiation */
@@ -52,7 +58,14 @@ public final class PayloadRegistry {
                 "Cannot register custom deserializer for core packet type 0x" +
                 Integer.toHexString(packetType & 0xFF) + " (must be >= 0x10)");
         }
-        customDeserializers.put(packetType, deserializer);
+        synchronized (writeLock) {
+            PayloadDeserializer<?>[] next = customDeserializers.clone();
+            if (next[packetType & 0xFF] == null) {
+                registeredCount++;
+            }
+            next[packetType & 0xFF] = deserializer;
+            customDeserializers = next;
+        }
     }
 
     /**
@@ -62,7 +75,16 @@ public final class PayloadRegistry {
      * @return true if a deserializer was removed, false if none was registered
      */
     public static boolean unregister(byte packetType) {
-        return customDeserializers.remove(packetType) != null;
+        synchronized (writeLock) {
+            if (customDeserializers[packetType & 0xFF] == null) {
+                return false;
+            }
+            PayloadDeserializer<?>[] next = customDeserializers.clone();
+            next[packetType & 0xFF] = null;
+            customDeserializers = next;
+            registeredCount--;
+            return true;
+        }
     }
 
     /**
@@ -72,7 +94,18 @@ public final class PayloadRegistry {
      * @return The deserializer, or empty if not registered
      */
     public static Optional<PayloadDeserializer<?>> getDeserializer(byte packetType) {
-        return Optional.ofNullable(customDeserializers.get(packetType));
+        return Optional.ofNullable(customDeserializers[packetType & 0xFF]);
+    }
+
+    /**
+     * Gets the deserializer for a packet type without wrapping it in an {@link Optional}.
+     * Intended for the per-packet decode path.
+     *
+     * @param packetType The packet type byte
+     * @return The deserializer, or null if not registered
+     */
+    static PayloadDeserializer<?> lookup(byte packetType) {
+        return customDeserializers[packetType & 0xFF];
     }
 
     /**
@@ -82,14 +115,17 @@ public final class PayloadRegistry {
      * @return true if a custom deserializer is registered
      */
     public static boolean isRegistered(byte packetType) {
-        return customDeserializers.containsKey(packetType);
+        return customDeserializers[packetType & 0xFF] != null;
     }
 
     /**
      * Clears all registered custom deserializers.
      */
     public static void clearAll() {
-        customDeserializers.clear();
+        synchronized (writeLock) {
+            customDeserializers = new PayloadDeserializer<?>[TABLE_SIZE];
+            registeredCount = 0;
+        }
     }
 
     /**
@@ -98,6 +134,6 @@ public final class PayloadRegistry {
      * @return the count of registered deserializers
      */
     public static int registeredCount() {
-        return customDeserializers.size();
+        return registeredCount;
     }
 }
@@ -44,7 +44,8 @@ public final class PayloadSizeEnforcer {
     public static final int UDP_MAX_PAYLOAD = 65507;
 
     /**
-     * Recommended MTU-safe payload size to avoid fragmentation.
+     * Recommended MTU-safe payload size to avoid fragmentation. This is the size
+     * {@link PathMtuDiscovery} assumes for every path before probing for more.
      */
     public static final int MTU_SAFE_PAYLOAD = 1200;
 
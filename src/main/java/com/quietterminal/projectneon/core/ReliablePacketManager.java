@@ -33,7 +33,7 @@ public class ReliablePacketManager {
         LoggerConfig.configureLogger(logger);
     }
 
-    private final NeonSocket socket;
+    private final Transport transport;
     private final SocketAddress relayAddr;
     private final byte clientId;
     private short nextReliableSequence = 0;
@@ -50,27 +50,27 @@ public class ReliablePacketManager {
     /**
      * Creates a new reliable packet manager with default configuration.
      *
-     * @param socket The socket to send packets through
+     * @param transport The transport to send packets through, usually a {@link NeonSocket}
      * @param relayAddr The relay address
      * @param clientId This client's ID
      */
-    public ReliablePacketManager(NeonSocket socket, SocketAddress relayAddr, byte clientId) {
-        this(socket, relayAddr, clientId, new NeonConfig());
+    public ReliablePacketManager(Transport transport, SocketAddress relayAddr, byte clientId) {
+        this(transport, relayAddr, clientId, new NeonConfig());
     }
 
     /**
      * Creates a new reliable packet manager with custom configuration.
      *
-     * @param socket The socket to send packets through
+     * @param transport The transport to send packets through, usually a {@link NeonSocket}
      * @param relayAddr The relay address
      * @param clientId This client's ID
      * @param config The configuration to use
      */
-    public ReliablePacketManager(NeonSocket socket, SocketAddress relayAddr, byte clientId, NeonConfig config) {
+    public ReliablePacketManager(Transport transport, SocketAddress relayAddr, byte clientId, NeonConfig config) {
         if (config == null) {
             throw new IllegalArgumentException("config cannot be null");
         }
-        this.socket = socket;
+        this.transport = transport;
         this.relayAddr = relayAddr;
         this.clientId = clientId;
         this.config = config;
@@ -94,7 +94,7 @@ public class ReliablePacketManager {
             PacketType.GAME_PACKET, sequence, clientId, destinationId, gamePacket
         );
 
-        socket.sendPacket(packet, relayAddr);
+        transport.sendPacket(packet, relayAddr);
 
         pendingPackets.put(sequence, new PendingReliablePacket(
             packet, System.currentTimeMillis(), 0
@@ -122,7 +122,7 @@ public class ReliablePacketManager {
                         new Object[]{entry.getKey(), maxRetries});
                     toRemove.add(entry.getKey());
                 } else {
-                    socket.sendPacket(pending.packet(), relayAddr);
+                    transport.sendPacket(pending.packet(), relayAddr);
                     pendingPackets.put(entry.getKey(), new PendingReliablePacket(
                         pending.packet(), now, pending.retryCount() + 1
                     ));
@@ -174,7 +174,7 @@ public class ReliablePacketManager {
         NeonPacket packet = NeonPacket.create(
             PacketType.ACK, (short) 0, clientId, (byte) 0, ack
         );
-        socket.sendPacket(packet, relayAddr);
+        transport.sendPacket(packet, relayAddr);
     }
 
     /**
@@ -0,0 +1,83 @@
+package com.quietterminal.projectneon.core;
+
+/**
+ * Sliding-window replay detection for 64-bit packet counters (RFC 4303 style).
+ *
+ * <p>Tracks the highest counter accepted so far and a bitmap of the {@link #WINDOW_SIZE}
+ * counters below it. A counter is fresh if it is above the highest one, or inside the
+ * window and not yet marked. Counters are checked before decryption and only recorded
+ * with {@link #update(long)} once the packet has authenticated, so forged packets cannot
+ * advance the window.
+ *
+ * <p>Counters travel truncated to 32 bits; {@link #expand(int)} recovers the full value
+ * from the one closest to the next expected counter.
+ *
+ * <p>Not thread-safe.
+ *
+ * @since 1.3
+ */
+public final class ReplayWindow {
+
+    /**
+     * Number of counters below the highest one that are still accepted out of order.
+     */
+    public static final int WINDOW_SIZE = 64;
+
+    private static final long TRUNCATED_WINDOW = 1L << 32;
+    private static final long TRUNCATED_HALF = TRUNCATED_WINDOW >>> 1;
+
+    private long highest = -1;
+    private long bitmap;
+
+    /**
+     * Recovers a full counter from its low 32 bits.
+     *
+     * @param truncated the low 32 bits of the counter
+     * @return the full counter closest to the next expected value
+     */
+    public long expand(int truncated) {
+        long expected = highest + 1;
+        long candidate = (expected & ~(TRUNCATED_WINDOW - 1)) | (truncated & 0xFFFFFFFFL);
+        if (candidate <= expected - TRUNCATED_HALF && candidate < Long.MAX_VALUE - TRUNCATED_WINDOW) {
+            return candidate + TRUNCATED_WINDOW;
+        }
+        if (candidate > expected + TRUNCATED_HALF && candidate >= TRUNCATED_WINDOW) {
+            return candidate - TRUNCATED_WINDOW;
+        }
+        return candidate;
+    }
+
+    /**
+     * Checks whether a counter has not been seen and is not too old.
+     */
+    public boolean check(long counter) {
+        if (counter < 0) {
+            return false;
+        }
+        if (counter > highest) {
+            return true;
+        }
+        long offset = highest - counter;
+        return offset < WINDOW_SIZE && (bitmap & (1L << offset)) == 0;
+    }
+
+    /**
+     * Records an authenticated counter.
+     */
+    public void update(long counter) {
+        if (counter > highest) {
+            long shift = counter - highest;
+            bitmap = shift >= WINDOW_SIZE ? 1L : (bitmap << shift) | 1L;
+            highest = counter;
+        } else {
+            bitmap |= 1L << (highest - counter);
+        }
+    }
+
+    /**
+     * Gets the highest counter accepted so far, or -1 if none.
+     */
+    public long getHighest() {
+        return highest;
+    }
+}
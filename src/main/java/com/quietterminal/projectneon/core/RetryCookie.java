@@ -0,0 +1,143 @@
+package com.quietterminal.projectneon.core;
+
+import javax.crypto.Mac;
+import javax.crypto.spec.SecretKeySpec;
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+import java.security.GeneralSecurityException;
+import java.security.MessageDigest;
+import java.security.SecureRandom;
+import java.util.Arrays;
+
+/**
+ * Stateless address-validation cookies for the connect handshake.
+ *
+ * <p>A cookie is an HMAC-SHA256 over the source IP address, source port and issue time,
+ * keyed with a secret that never leaves the issuer. A peer that echoes a valid cookie has
+ * proven it can receive datagrams at its claimed address, so the issuer can defer all
+ * per-connection state until then without remembering anything about the first request.
+ *
+ * <p>Wire layout ({@link #COOKIE_LENGTH} bytes): issue time in seconds as a little-endian
+ * int, followed by the first {@link #MAC_LENGTH} bytes of the MAC.
+ *
+ * <p>Not thread-safe: the MAC instance and scratch buffer are reused across calls.
+ *
+ * @since 1.3
+ */
+public final class RetryCookie {
+
+    /**
+     * Truncated MAC length in bytes.
+     */
+    public static final int MAC_LENGTH = 16;
+
+    /**
+     * Encoded cookie length in bytes.
+     */
+    public static final int COOKIE_LENGTH = 4 + MAC_LENGTH;
+
+    private static final String ALGORITHM = "HmacSHA256";
+    private static final int KEY_LENGTH = 32;
+
+    private final Mac mac;
+    private final long lifetimeSeconds;
+    private final byte[] input = new byte[16 + 2 + 4];
+
+    /**
+     * Creates a cookie issuer with a fresh random key. Cookies issued by one instance
+     * are not accepted by another, so a restarted relay simply issues new ones.
+     *
+     * @param lifetimeMs how long an issued cookie stays valid
+     */
+    public RetryCookie(long lifetimeMs) {
+        this(randomKey(), lifetimeMs);
+    }
+
+    /**
+     * Creates a cookie issuer with an explicit key.
+     *
+     * @param key the HMAC key, at least 16 bytes
+     * @param lifetimeMs how long an issued cookie stays valid
+     */
+    public RetryCookie(byte[] key, long lifetimeMs) {
+        if (key == null || key.length < 16) {
+            throw new IllegalArgumentException("key must be at least 16 bytes");
+        }
+        if (lifetimeMs < 1000) {
+            throw new IllegalArgumentException("lifetimeMs must be at least 1000, got: " + lifetimeMs);
+        }
+        try {
+            this.mac = Mac.getInstance(ALGORITHM);
+            this.mac.init(new SecretKeySpec(key, ALGORITHM));
+        } catch (GeneralSecurityException e) {
+            throw new IllegalStateException(ALGORITHM + " is not available", e);
+        }
+        this.lifetimeSeconds = lifetimeMs / 1000;
+    }
+
+    /**
+     * Issues a cookie for a source address.
+     *
+     * @param source the address the cookie is bound to
+     * @param nowMs the current time in milliseconds
+     * @return the encoded cookie
+     */
+    public byte[] issue(InetSocketAddress source, long nowMs) {
+        int issuedAt = (int) (nowMs / 1000);
+        byte[] cookie = new byte[COOKIE_LENGTH];
+        cookie[0] = (byte) issuedAt;
+        cookie[1] = (byte) (issuedAt >>> 8);
+        cookie[2] = (byte) (issuedAt >>> 16);
+        cookie[3] = (byte) (issuedAt >>> 24);
+        System.arraycopy(compute(source, issuedAt), 0, cookie, 4, MAC_LENGTH);
+        return cookie;
+    }
+
+    /**
+     * Checks that a cookie was issued by this instance for the given source and has not expired.
+     *
+     * @param cookie the echoed cookie, may be empty
+     * @param source the address the cookie was received from
+     * @param nowMs the current time in milliseconds
+     * @return true if the cookie is valid
+     */
+    public boolean verify(byte[] cookie, InetSocketAddress source, long nowMs) {
+        if (cookie == null || cookie.length != COOKIE_LENGTH || source.getAddress() == null) {
+            return false;
+        }
+        int issuedAt = (cookie[0] & 0xFF) | (cookie[1] & 0xFF) << 8
+            | (cookie[2] & 0xFF) << 16 | (cookie[3] & 0xFF) << 24;
+        long age = nowMs / 1000 - (issuedAt & 0xFFFFFFFFL);
+        if (age < 0 || age > lifetimeSeconds) {
+            return false;
+        }
+        return MessageDigest.isEqual(compute(source, issuedAt), Arrays.copyOfRange(cookie, 4, COOKIE_LENGTH));
+    }
+
+    private byte[] compute(InetSocketAddress source, int issuedAt) {
+        InetAddress address = source.getAddress();
+        byte[] raw = address == null ? new byte[0] : address.getAddress();
+        Arrays.fill(input, 0, 16, (byte) 0);
+        if (raw.length == 4) {
+            input[10] = (byte) 0xFF;
+            input[11] = (byte) 0xFF;
+            System.arraycopy(raw, 0, input, 12, 4);
+        } else {
+            System.arraycopy(raw, 0, input, 0, Math.min(raw.length, 16));
+        }
+        int port = source.getPort();
+        input[16] = (byte) port;
+        input[17] = (byte) (port >>> 8);
+        input[18] = (byte) issuedAt;
+        input[19] = (byte) (issuedAt >>> 8);
+        input[20] = (byte) (issuedAt >>> 16);
+        input[21] = (byte) (issuedAt >>> 24);
+        return Arrays.copyOf(mac.doFinal(input), MAC_LENGTH);
+    }
+
+    private static byte[] randomKey() {
+        byte[] key = new byte[KEY_LENGTH];
+        new SecureRandom().nextBytes(key);
+        return key;
+    }
+}
@@ -83,6 +83,11 @@ public final class RuntimeConfig {
         defaults.put("relay.socketTimeoutMs", 100);
         defaults.put("relay.mainLoopSleepMs", 1);
         defaults.put("relay.pendingConnectionTimeoutMs", 30000);
+        defaults.put("relay.connectCookies", false);
+        defaults.put("relay.connectCookieLifetimeMs", 10000);
+        defaults.put("relay.amplificationFactor", 3);
+        defaults.put("relay.allowList", "");
+        defaults.put("relay.blockList", "");
 
         defaults.put("limits.maxPacketsPerSecond", 100);
         defaults.put("limits.maxClientsPerSession", 32);
@@ -122,6 +127,12 @@ public final class RuntimeConfig {
         defaults.put("protocol.maxNameLength", 64);
         defaults.put("protocol.maxDescriptionLength", 256);
         defaults.put("protocol.maxPacketCount", 100);
+        defaults.put("protocol.packetChecksum", false);
+        defaults.put("protocol.maxHeaderVersion", 1);
+        defaults.put("protocol.pathMtuDiscovery", false);
+        defaults.put("protocol.pathMtuMaxSize", 1472);
+        defaults.put("protocol.sessionTokenKey", "");
+        defaults.put("protocol.sessionEncryption", "none");
 
         defaults.put("event.useEventDrivenReceiver", false);
         defaults.put("event.loopSelectTimeoutMs", 100);
@@ -424,6 +435,11 @@ public final class RuntimeConfig {
         setInt("relay.socketTimeoutMs", config.getRelaySocketTimeoutMs());
         setInt("relay.mainLoopSleepMs", config.getRelayMainLoopSleepMs());
         setInt("relay.pendingConnectionTimeoutMs", config.getRelayPendingConnectionTimeoutMs());
+        setBoolean("relay.connectCookies", config.isRelayConnectCookiesEnabled());
+        setInt("relay.connectCookieLifetimeMs", config.getRelayConnectCookieLifetimeMs());
+        setInt("relay.amplificationFactor", config.getRelayAmplificationFactor());
+        setString("relay.allowList", config.getRelayAllowList());
+        setString("relay.blockList", config.getRelayBlockList());
 
         setInt("limits.maxPacketsPerSecond", config.getMaxPacketsPerSecond());
         setInt("limits.maxClientsPerSession", config.getMaxClientsPerSession());
@@ -463,6 +479,12 @@ public final class RuntimeConfig {
         setInt("protocol.maxNameLength", config.getMaxNameLength());
         setInt("protocol.maxDescriptionLength", config.getMaxDescriptionLength());
         setInt("protocol.maxPacketCount", config.getMaxPacketCount());
+        setBoolean("protocol.packetChecksum", config.isPacketChecksumEnabled());
+        setInt("protocol.maxHeaderVersion", config.getMaxHeaderVersion());
+        setBoolean("protocol.pathMtuDiscovery", config.isPathMtuDiscoveryEnabled());
+        setInt("protocol.pathMtuMaxSize", config.getPathMtuMaxSize());
+        setString("protocol.sessionTokenKey", config.getSessionTokenKey());
+        setString("protocol.sessionEncryption", config.getSessionEncryption());
 
         setBoolean("event.useEventDrivenReceiver", config.isUseEventDrivenReceiver());
         setInt("event.loopSelectTimeoutMs", config.getEventLoopSelectTimeoutMs());
@@ -484,6 +506,11 @@ public final class RuntimeConfig {
             .relaySocketTimeoutMs(getInt("relay.socketTimeoutMs"))
             .relayMainLoopSleepMs(getInt("relay.mainLoopSleepMs"))
             .relayPendingConnectionTimeoutMs(getInt("relay.pendingConnectionTimeoutMs"))
+            .relayConnectCookiesEnabled(getBoolean("relay.connectCookies"))
+            .relayConnectCookieLifetimeMs(getInt("relay.connectCookieLifetimeMs"))
+            .relayAmplificationFactor(getInt("relay.amplificationFactor"))
+            .relayAllowList(getString("relay.allowList"))
+            .relayBlockList(getString("relay.blockList"))
             .maxPacketsPerSecond(getInt("limits.maxPacketsPerSecond"))
             .maxClientsPerSession(getInt("limits.maxClientsPerSession"))
             .maxTotalConnections(getInt("limits.maxTotalConnections"))
@@ -516,6 +543,12 @@ public final class RuntimeConfig {
             .maxNameLength(getInt("protocol.maxNameLength"))
             .maxDescriptionLength(getInt("protocol.maxDescriptionLength"))
             .maxPacketCount(getInt("protocol.maxPacketCount"))
+            .packetChecksumEnabled(getBoolean("protocol.packetChecksum"))
+            .maxHeaderVersion(getInt("protocol.maxHeaderVersion"))
+            .pathMtuDiscoveryEnabled(getBoolean("protocol.pathMtuDiscovery"))
+            .pathMtuMaxSize(getInt("protocol.pathMtuMaxSize"))
+            .sessionTokenKey(getString("protocol.sessionTokenKey"))
+            .sessionEncryption(getString("protocol.sessionEncryption"))
             .useEventDrivenReceiver(getBoolean("event.useEventDrivenReceiver"))
             .eventLoopSelectTimeoutMs(getInt("event.loopSelectTimeoutMs"))
             .build();
@@ -0,0 +1,327 @@
+package com.quietterminal.projectneon.core;
+
+import javax.crypto.AEADBadTagException;
+import javax.crypto.Cipher;
+import javax.crypto.spec.GCMParameterSpec;
+import javax.crypto.spec.IvParameterSpec;
+import javax.crypto.spec.SecretKeySpec;
+import java.nio.charset.StandardCharsets;
+import java.security.GeneralSecurityException;
+import java.security.spec.AlgorithmParameterSpec;
+import java.util.concurrent.atomic.AtomicLong;
+
+/**
+ * Per-session AEAD encryption of game packet payloads.
+ *
+ * <p>Every member of a session holds the same 32-byte session secret, handed out by the host
+ * through {@link KeyExchange}. Each sender id gets its own key and IV derived from the
+ * secret with HKDF, so senders never share a nonce space. The nonce is the sender IV XOR
+ * a 64-bit packet counter that this instance increments for every sealed packet;
+ * retransmissions are sealed again under a fresh counter. Because the key depends only on
+ * the secret and the sender id, a sender id must never be given to a second client while
+ * the secret is in use; {@code NeonHost} retires ids of encrypted sessions for that reason.
+ *
+ * <p>Only game packets (type {@code 0x10} and above) are encrypted. Core packets stay in
+ * the clear because the relay reads them, and the header always stays in the clear so the
+ * relay can route without the key. The packet type, sender and destination are
+ * authenticated as associated data. An encrypted payload is laid out as:
+ * <pre>
+ * [4 bytes] low 32 bits of the packet counter, little-endian
+ * [n bytes] ciphertext
+ * [16 bytes] authentication tag
+ * </pre>
+ *
+ * <p>Both directions work in place on the caller's buffer; the JDK's AES-GCM and
+ * ChaCha20-Poly1305 implementations use CPU intrinsics where available. Sealing and opening
+ * are each serialized internally, so one thread may send while another receives.
+ *
+ * @since 1.3
+ */
+public final class SessionCipher {
+
+    /**
+     * Bytes added to an encrypted payload: the truncated counter and the tag.
+     */
+    public static final int OVERHEAD = 4 + 16;
+
+    private static final int TAG_LENGTH = 16;
+    private static final int IV_LENGTH = 12;
+    private static final int FIRST_GAME_TYPE = 0x10;
+    private static final byte[] KEY_LABEL = "neon key ".getBytes(StandardCharsets.US_ASCII);
+    private static final byte[] IV_LABEL = "neon iv ".getBytes(StandardCharsets.US_ASCII);
+
+    /**
+     * Supported AEAD algorithms.
+     */
+    public enum Suite {
+        AES_256_GCM((byte) 1, "aes-gcm", "AES/GCM/NoPadding", "AES"),
+        CHACHA20_POLY1305((byte) 2, "chacha20-poly1305", "ChaCha20-Poly1305", "ChaCha20");
+
+        private final byte id;
+        private final String configName;
+        private final String transformation;
+        private final String keyAlgorithm;
+
+        Suite(byte id, String configName, String transformation, String keyAlgorithm) {
+            this.id = id;
+            this.configName = configName;
+            this.transformation = transformation;
+            this.keyAlgorithm = keyAlgorithm;
+        }
+
+        public byte getId() {
+            return id;
+        }
+
+        public String getConfigName() {
+            return configName;
+        }
+
+        /**
+         * Looks up a suite by its wire id.
+         *
+         * @throws IllegalArgumentException if the id is unknown
+         */
+        public static Suite fromId(byte id) {
+            for (Suite suite : values()) {
+                if (suite.id == id) {
+                    return suite;
+                }
+            }
+            throw new IllegalArgumentException("Unknown cipher suite id: " + id);
+        }
+
+        /**
+         * Looks up a suite by its configuration name.
+         *
+         * @return the suite, or null for {@code "none"}
+         * @throws IllegalArgumentException if the name is unknown
+         */
+        public static Suite fromConfigName(String name) {
+            if (name == null || name.isEmpty() || name.equals("none")) {
+                return null;
+            }
+            for (Suite suite : values()) {
+                if (suite.configName.equals(name)) {
+                    return suite;
+                }
+            }
+            throw new IllegalArgumentException("sessionEncryption must be none, aes-gcm or chacha20-poly1305, got: " + name);
+        }
+    }
+
+    private final Suite suite;
+    private final byte[] secret;
+    private final SecretKeySpec[] keys = new SecretKeySpec[256];
+    private final byte[][] ivs = new byte[256][];
+    private final ReplayWindow[] windows = new ReplayWindow[256];
+    private final AtomicLong nextCounter = new AtomicLong();
+
+    private final Cipher sealCipher;
+    private final Cipher openCipher;
+    private final byte[] sealNonce = new byte[IV_LENGTH];
+    private final byte[] openNonce = new byte[IV_LENGTH];
+    private final byte[] sealAad = new byte[3];
+    private final byte[] openAad = new byte[3];
+    private long rejected;
+
+    /**
+     * Creates a cipher for a session.
+     *
+     * @param suite the AEAD algorithm
+     * @param secret the {@link KeyExchange#SECRET_LENGTH}-byte session secret
+     */
+    public SessionCipher(Suite suite, byte[] secret) {
+        if (suite == null) {
+            throw new IllegalArgumentException("suite cannot be null");
+        }
+        if (secret == null || secret.length != KeyExchange.SECRET_LENGTH) {
+            throw new IllegalArgumentException("Session secret must be " + KeyExchange.SECRET_LENGTH + " bytes");
+        }
+        this.suite = suite;
+        this.secret = secret.clone();
+        try {
+            this.sealCipher = Cipher.getInstance(suite.transformation);
+            this.openCipher = Cipher.getInstance(suite.transformation);
+        } catch (GeneralSecurityException e) {
+            throw new IllegalStateException(suite.transformation + " is not available", e);
+        }
+    }
+
+    /**
+     * Gets the AEAD algorithm.
+     */
+    public Suite getSuite() {
+        return suite;
+    }
+
+    /**
+     * Checks whether a serialized packet's payload is covered by encryption.
+     */
+    public static boolean covers(byte[] packet) {
+        return packet.length > 3 && (packet[3] & 0xFF) >= FIRST_GAME_TYPE;
+    }
+
+    /**
+     * Encrypts the payload of a serialized packet in place.
+     *
+     * @param buf the buffer holding the packet; needs {@link #OVERHEAD} spare bytes after it
+     * @param length the packet length
+     * @return the new packet length
+     */
+    public int seal(byte[] buf, int length) {
+        if (length + OVERHEAD > buf.length) {
+            throw new IllegalArgumentException("Buffer too small for encrypted packet");
+        }
+        long counter = nextCounter.getAndIncrement();
+
+        synchronized (sealCipher) {
+            int headerLength = describe(buf, length, sealAad);
+            int payloadLength = length - headerLength;
+            byte sender = sealAad[1];
+            System.arraycopy(buf, headerLength, buf, headerLength + 4, payloadLength);
+            writeCounter(buf, headerLength, counter);
+            nonce(sender, counter, sealNonce);
+            try {
+                sealCipher.init(Cipher.ENCRYPT_MODE, key(sender), parameters(sealNonce));
+                sealCipher.updateAAD(sealAad);
+                int written = sealCipher.doFinal(buf, headerLength + 4, payloadLength, buf, headerLength + 4);
+                return headerLength + 4 + written;
+            } catch (GeneralSecurityException e) {
+                throw new IllegalStateException("Packet encryption failed", e);
+            }
+        }
+    }
+
+    /**
+     * Authenticates and decrypts the payload of a serialized packet in place.
+     * Packets this cipher does not cover are returned unchanged.
+     *
+     * @param buf the buffer holding the packet
+     * @param length the packet length
+     * @return the new packet length, or -1 if the packet is forged, corrupt or replayed
+     */
+    public int open(byte[] buf, int length) {
+        if (length <= 3 || (buf[3] & 0xFF) < FIRST_GAME_TYPE) {
+            return length;
+        }
+        synchronized (openCipher) {
+            int headerLength;
+            try {
+                headerLength = describe(buf, length, openAad);
+            } catch (IllegalArgumentException e) {
+                return reject();
+            }
+            int sealedLength = length - headerLength - 4;
+            if (sealedLength < TAG_LENGTH) {
+                return reject();
+            }
+            byte sender = openAad[1];
+            int truncated = (buf[headerLength] & 0xFF) | (buf[headerLength + 1] & 0xFF) << 8
+                | (buf[headerLength + 2] & 0xFF) << 16 | (buf[headerLength + 3] & 0xFF) << 24;
+
+            ReplayWindow window = windows[sender & 0xFF];
+            if (window == null) {
+                window = new ReplayWindow();
+                windows[sender & 0xFF] = window;
+            }
+            long counter = window.expand(truncated);
+            if (!window.check(counter)) {
+                return reject();
+            }
+            nonce(sender, counter, openNonce);
+            try {
+                openCipher.init(Cipher.DECRYPT_MODE, key(sender), parameters(openNonce));
+                openCipher.updateAAD(openAad);
+                int written = openCipher.doFinal(buf, headerLength + 4, sealedLength, buf, headerLength);
+                window.update(counter);
+                return headerLength + written;
+            } catch (AEADBadTagException e) {
+                return reject();
+            } catch (GeneralSecurityException e) {
+                throw new IllegalStateException("Packet decryption failed", e);
+            }
+        }
+    }
+
+    /**
+     * Starts a fresh replay window for a sender that has just joined the session, so
+     * nothing received under its id before the join affects its traffic.
+     *
+     * @param sender the sender id
+     */
+    public void resetSender(byte sender) {
+        synchronized (openCipher) {
+            windows[sender & 0xFF] = null;
+        }
+    }
+
+    /**
+     * Gets the number of packets rejected as forged, corrupt or replayed.
+     */
+    public long getRejectedCount() {
+        return rejected;
+    }
+
+    private int reject() {
+        rejected++;
+        return -1;
+    }
+
+    private AlgorithmParameterSpec parameters(byte[] nonce) {
+        return suite == Suite.AES_256_GCM
+            ? new GCMParameterSpec(TAG_LENGTH * 8, nonce)
+            : new IvParameterSpec(nonce);
+    }
+
+    private synchronized SecretKeySpec key(byte sender) {
+        int index = sender & 0xFF;
+        SecretKeySpec key = keys[index];
+        if (key == null) {
+            byte[] prk = KeyExchange.extract(new byte[32], secret);
+            key = new SecretKeySpec(KeyExchange.expand(prk, label(KEY_LABEL, sender), 32), suite.keyAlgorithm);
+            ivs[index] = KeyExchange.expand(prk, label(IV_LABEL, sender), IV_LENGTH);
+            keys[index] = key;
+        }
+        return key;
+    }
+
+    private void nonce(byte sender, long counter, byte[] out) {
+        key(sender);
+        byte[] iv = ivs[sender & 0xFF];
+        System.arraycopy(iv, 0, out, 0, IV_LENGTH);
+        for (int i = 0; i < 8; i++) {
+            out[IV_LENGTH - 1 - i] ^= (byte) (counter >>> (8 * i));
+        }
+    }
+
+    private static byte[] label(byte[] prefix, byte sender) {
+        byte[] info = new byte[prefix.length + 1];
+        System.arraycopy(prefix, 0, info, 0, prefix.length);
+        info[prefix.length] = sender;
+        return info;
+    }
+
+    private static void writeCounter(byte[] buf, int offset, long counter) {
+        buf[offset] = (byte) counter;
+        buf[offset + 1] = (byte) (counter >>> 8);
+        buf[offset + 2] = (byte) (counter >>> 16);
+        buf[offset + 3] = (byte) (counter >>> 24);
+    }
+
+    /**
+     * Fills the associated data (type, sender, destination) and returns the header length.
+     */
+    private static int describe(byte[] buf, int length, byte[] aad) {
+        aad[0] = buf[3];
+        if (buf[2] == PacketHeaderV2.VERSION) {
+            PacketHeaderV2 header = PacketHeaderV2.decode(buf, 0, length);
+            aad[1] = (byte) header.clientId();
+            aad[2] = (byte) header.destinationId();
+            return header.encodedSize();
+        }
+        aad[1] = buf[6];
+        aad[2] = buf[7];
+        return PacketHeader.HEADER_SIZE;
+    }
+}
@@ -0,0 +1,125 @@
+package com.quietterminal.projectneon.core;
+
+import javax.crypto.Mac;
+import javax.crypto.spec.SecretKeySpec;
+import java.security.GeneralSecurityException;
+import java.security.SecureRandom;
+
+/**
+ * Issues and checks session tokens signed with a key shared by the host and the relay.
+ *
+ * <p>A token keeps the 64-bit wire format of {@link PacketPayload.ConnectAccept#sessionToken()}:
+ * the top {@link #NONCE_BITS} bits are a random nonce and the remaining bits are a truncated
+ * HMAC-SHA256 over the session id, client id and nonce. The host issues tokens and still
+ * remembers them, while the relay, which never sees the issue, can check a
+ * {@link PacketPayload.ReconnectRequest} on its own and rebind the peer without a round trip
+ * to the host.
+ *
+ * <p>A valid signature only proves that a token was issued at some point. Callers that accept
+ * tokens must also check that the token is the peer's current one; the relay does this and
+ * issues a replacement on every rebind, so a captured request cannot be replayed.
+ *
+ * <p>Not thread-safe: the MAC instance is reused across calls.
+ *
+ * @since 1.3
+ */
+public final class SessionTokenSigner {
+
+    /**
+     * Random nonce bits at the top of a token.
+     */
+    public static final int NONCE_BITS = 24;
+
+    private static final int MAC_BITS = 64 - NONCE_BITS;
+    private static final long MAC_MASK = (1L << MAC_BITS) - 1;
+    private static final String ALGORITHM = "HmacSHA256";
+
+    private final Mac mac;
+    private final SecureRandom random = new SecureRandom();
+    private final byte[] input = new byte[4 + 1 + 4];
+
+    /**
+     * Creates a signer.
+     *
+     * @param key the shared key, at least 16 bytes
+     */
+    public SessionTokenSigner(byte[] key) {
+        if (key == null || key.length < 16) {
+            throw new IllegalArgumentException("Session token key must be at least 16 bytes");
+        }
+        try {
+            this.mac = Mac.getInstance(ALGORITHM);
+            this.mac.init(new SecretKeySpec(key, ALGORITHM));
+        } catch (GeneralSecurityException e) {
+            throw new IllegalStateException(ALGORITHM + " is not available", e);
+        }
+    }
+
+    /**
+     * Creates a signer from NeonConfig settings.
+     *
+     * @return the signer, or null if no session token key is configured
+     */
+    public static SessionTokenSigner fromConfig(NeonConfig config) {
+        String key = config.getSessionTokenKey();
+        return key == null || key.isEmpty() ? null : new SessionTokenSigner(parseKey(key));
+    }
+
+    /**
+     * Parses a hex-encoded key.
+     *
+     * @param hex the key as hex digits, at least 32 of them
+     * @return the key bytes
+     * @throws IllegalArgumentException if the key is malformed or too short
+     */
+    public static byte[] parseKey(String hex) {
+        if (hex.length() < 32 || (hex.length() & 1) != 0) {
+            throw new IllegalArgumentException("Session token key must be an even number of at least 32 hex digits");
+        }
+        byte[] key = new byte[hex.length() / 2];
+        for (int i = 0; i < key.length; i++) {
+            int high = Character.digit(hex.charAt(2 * i), 16);
+            int low = Character.digit(hex.charAt(2 * i + 1), 16);
+            if (high < 0 || low < 0) {
+                throw new IllegalArgumentException("Session token key contains a non-hex character");
+            }
+            key[i] = (byte) (high << 4 | low);
+        }
+        return key;
+    }
+
+    /**
+     * Issues a fresh token for a client.
+     */
+    public long issue(int sessionId, byte clientId) {
+        int nonce = random.nextInt() >>> (32 - NONCE_BITS);
+        return (long) nonce << MAC_BITS | sign(sessionId, clientId, nonce);
+    }
+
+    /**
+     * Checks that a token was issued for the given client with the shared key.
+     */
+    public boolean verify(long token, int sessionId, byte clientId) {
+        int nonce = (int) (token >>> MAC_BITS);
+        long expected = sign(sessionId, clientId, nonce);
+        return ((token & MAC_MASK) ^ expected) == 0;
+    }
+
+    private long sign(int sessionId, byte clientId, int nonce) {
+        input[0] = (byte) sessionId;
+        input[1] = (byte) (sessionId >>> 8);
+        input[2] = (byte) (sessionId >>> 16);
+        input[3] = (byte) (sessionId >>> 24);
+        input[4] = clientId;
+        input[5] = (byte) nonce;
+        input[6] = (byte) (nonce >>> 8);
+        input[7] = (byte) (nonce >>> 16);
+        input[8] = (byte) (nonce >>> 24);
+        byte[] digest = mac.doFinal(input);
+        long value = 0;
+        for (int i = 0; i < 8; i++) {
+            value = (value << 8) | (digest[i] & 0xFF);
+        }
+        return value & MAC_MASK;
+    }
+}
@@ -0,0 +1,502 @@
+package com.quietterminal.projectneon.core;
+
+import com.quietterminal.projectneon.util.LoggerConfig;
+import com.quietterminal.projectneon.util.VirtualThreads;
+
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.VarHandle;
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+import java.net.SocketAddress;
+import java.net.SocketException;
+import java.net.SocketTimeoutException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.locks.LockSupport;
+import java.util.logging.Level;
+import java.util.logging.Logger;
+
+/**
+ * Transport between two processes on the same machine over a memory-mapped file holding
+ * one {@link SpscByteRing} per direction, typically a relay and a dedicated host on the
+ * same box.
+ *
+ * <p>The relay side {@link #create creates} the file and may pass a fallback transport,
+ * usually its UDP socket: datagrams for the peer go through the ring and everything else
+ * through the fallback, so external clients keep using UDP. The host side
+ * {@link #open opens} the file and sends every datagram through the ring. The host appears
+ * to the relay as {@code 127.0.0.1:0}, a source no UDP peer can have, and the relay
+ * appears to the host as {@code 127.0.0.1} with the fallback's port.
+ *
+ * <p>A send is a copy into the ring and a release store, with no system call while the
+ * receiver is busy. An idle receiver sleeps on a futex word in the file and the sender
+ * wakes it through the {@code neon_jni} library. Without that library, or on platforms
+ * other than Linux, the receiver instead parks in slices of {@value #PARK_NANOS} ns, which
+ * bounds the wake-up latency. Datagrams that arrive while the ring is full are dropped and
+ * counted, as a full socket buffer would.
+ *
+ * <p>Any number of threads may send. Receives must come from one thread at a time. A
+ * blocking receive on a transport with a fallback starts a virtual thread that moves
+ * fallback datagrams into an in-memory queue, so that one futex covers both sources.
+ *
+ * <p>File layout, in native byte order:
+ * <pre>
+ * [0..16)     magic, layout version, ring capacity, creator port
+ * [64..72)    wake word and waiter count for the ring towards the creator
+ * [128..136)  wake word and waiter count for the ring towards the opener
+ * [192..)     ring towards the creator, then ring towards the opener
+ * </pre>
+ *
+ * @since 1.3
+ */
+public class SharedMemoryTransport implements Transport {
+    private static final Logger logger;
+
+    static {
+        logger = Logger.getLogger(SharedMemoryTransport.class.getName());
+        LoggerConfig.configureLogger(logger);
+    }
+
+    /**
+     * Ring data region size used when none is given.
+     */
+    public static final int DEFAULT_RING_CAPACITY = 1 << 20;
+
+    /**
+     * Maximum number of fallback datagrams waiting to be received.
+     */
+    public static final int QUEUE_CAPACITY = 1024;
+
+    static final long PARK_NANOS = 50_000;
+
+    private static final int MAGIC = 0x4E454F4D;
+    private static final int LAYOUT_VERSION = 1;
+    private static final int MAGIC_OFFSET = 0;
+    private static final int VERSION_OFFSET = 4;
+    private static final int CAPACITY_OFFSET = 8;
+    private static final int PORT_OFFSET = 12;
+    private static final int TO_CREATOR_WAKE = 64;
+    private static final int TO_OPENER_WAKE = 128;
+    private static final int WAITERS = 4;
+    private static final int FILE_HEADER_SIZE = 192;
+
+    private static final int PUMP_TIMEOUT_MS = 100;
+    private static final int MAX_DATAGRAM_SIZE = 65535;
+    private static final int POOLED_BUFFER_SIZE = 2048;
+    private static final String EMBEDDED_PROPERTY = "neon.jni.embedded";
+
+    private static final VarHandle INT =
+        MethodHandles.byteBufferViewVarHandle(int[].class, ByteOrder.nativeOrder());
+
+    private static final boolean NATIVE_WAKEUP = loadNativeWakeup();
+
+    private final Path file;
+    private final boolean creator;
+    private final MappedByteBuffer map;
+    private final SpscByteRing inbound;
+    private final SpscByteRing outbound;
+    private final int inboundWake;
+    private final int outboundWake;
+    private final Transport fallback;
+    private final InetSocketAddress peerAddress;
+    private final byte[] receiveScratch;
+    private final byte[] sendScratch;
+    private final Object sendLock = new Object();
+    private final ConcurrentLinkedQueue<Datagram> relayed = new ConcurrentLinkedQueue<>();
+    private final AtomicInteger relayedCount = new AtomicInteger();
+    private final AtomicLong dropped = new AtomicLong();
+    private final ByteBufferPool bufferPool = new ByteBufferPool(POOLED_BUFFER_SIZE, 0, QUEUE_CAPACITY);
+    private volatile boolean blocking;
+    private volatile int timeoutMs;
+    private volatile boolean closed;
+    private volatile Thread waiter;
+    private volatile Thread pump;
+
+    private SharedMemoryTransport(Path file, boolean creator, MappedByteBuffer map, int capacity,
+                                  Transport fallback, InetSocketAddress peerAddress) {
+        int ringSize = SpscByteRing.HEADER_SIZE + capacity;
+        SpscByteRing toCreator = new SpscByteRing(map.slice(FILE_HEADER_SIZE, ringSize));
+        SpscByteRing toOpener = new SpscByteRing(map.slice(FILE_HEADER_SIZE + ringSize, ringSize));
+
+        this.file = file;
+        this.creator = creator;
+        this.map = map;
+        this.inbound = creator ? toCreator : toOpener;
+        this.outbound = creator ? toOpener : toCreator;
+        this.inboundWake = creator ? TO_CREATOR_WAKE : TO_OPENER_WAKE;
+        this.outboundWake = creator ? TO_OPENER_WAKE : TO_CREATOR_WAKE;
+        this.fallback = fallback;
+        this.peerAddress = peerAddress;
+        this.receiveScratch = new byte[inbound.maxRecordLength()];
+        this.sendScratch = new byte[outbound.maxRecordLength()];
+    }
+
+    /**
+     * Creates the shared file and returns the creator's end. An existing file is replaced;
+     * processes still mapping it keep the old rings.
+     *
+     * @param file the file to create, ideally on a memory-backed file system such as /dev/shm
+     * @param ringCapacity the data region size of each ring, a power of two
+     * @param fallback a bound transport for all other peers, or null
+     * @return the creator's end
+     * @throws IOException if the file cannot be created or mapped
+     */
+    public static SharedMemoryTransport create(Path file, int ringCapacity, Transport fallback) throws IOException {
+        if (file == null) {
+            throw new IllegalArgumentException("file cannot be null");
+        }
+        if (ringCapacity < 64 || Integer.bitCount(ringCapacity) != 1) {
+            throw new IllegalArgumentException("ringCapacity must be a power of two of at least 64, got: " + ringCapacity);
+        }
+
+        Files.deleteIfExists(file);
+        MappedByteBuffer map;
+        try (FileChannel channel = FileChannel.open(file,
+                StandardOpenOption.CREATE_NEW, StandardOpenOption.READ, StandardOpenOption.WRITE)) {
+            map = channel.map(FileChannel.MapMode.READ_WRITE, 0, fileSize(ringCapacity));
+        }
+        map.order(ByteOrder.nativeOrder());
+        map.putInt(VERSION_OFFSET, LAYOUT_VERSION);
+        map.putInt(CAPACITY_OFFSET, ringCapacity);
+        map.putInt(PORT_OFFSET, fallback != null ? portOf(fallback.getLocalAddress()) : 0);
+        INT.setRelease(map, MAGIC_OFFSET, MAGIC);
+
+        return new SharedMemoryTransport(file, true, map, ringCapacity, fallback,
+            new InetSocketAddress(InetAddress.getLoopbackAddress(), 0));
+    }
+
+    /**
+     * Opens a file made by {@link #create} and returns the opener's end.
+     *
+     * @param file the shared file
+     * @return the opener's end
+     * @throws IOException if the file is missing, not yet initialized or of another layout
+     */
+    public static SharedMemoryTransport open(Path file) throws IOException {
+        if (file == null) {
+            throw new IllegalArgumentException("file cannot be null");
+        }
+
+        MappedByteBuffer map;
+        try (FileChannel channel = FileChannel.open(file, StandardOpenOption.READ, StandardOpenOption.WRITE)) {
+            if (channel.size() < FILE_HEADER_SIZE) {
+                throw new IOException("Shared-memory file not initialized: " + file);
+            }
+            map = channel.map(FileChannel.MapMode.READ_WRITE, 0, channel.size());
+        }
+        map.order(ByteOrder.nativeOrder());
+        if ((int) INT.getAcquire(map, MAGIC_OFFSET) != MAGIC) {
+            throw new IOException("Shared-memory file not initialized: " + file);
+        }
+        if (map.getInt(VERSION_OFFSET) != LAYOUT_VERSION) {
+            throw new IOException("Unsupported shared-memory layout version " + map.getInt(VERSION_OFFSET) + ": " + file);
+        }
+        int capacity = map.getInt(CAPACITY_OFFSET);
+        if (capacity < 64 || Integer.bitCount(capacity) != 1 || map.capacity() != fileSize(capacity)) {
+            throw new IOException("Corrupt shared-memory file: " + file);
+        }
+
+        return new SharedMemoryTransport(file, false, map, capacity, null,
+            new InetSocketAddress(InetAddress.getLoopbackAddress(), map.getInt(PORT_OFFSET)));
+    }
+
+    @Override
+    public Type getType() {
+        return Type.SHARED_MEMORY;
+    }
+
+    /**
+     * Binds the fallback transport. The shared-memory end itself needs no port.
+     */
+    @Override
+    public void bind(int port) throws IOException {
+        if (fallback == null) {
+            throw new SocketException("Shared-memory transport has no fallback to bind");
+        }
+        fallback.bind(port);
+        map.putInt(PORT_OFFSET, portOf(fallback.getLocalAddress()));
+    }
+
+    @Override
+    public SocketAddress getLocalAddress() {
+        if (fallback != null) {
+            return fallback.getLocalAddress();
+        }
+        return new InetSocketAddress(InetAddress.getLoopbackAddress(), creator ? map.getInt(PORT_OFFSET) : 0);
+    }
+
+    /**
+     * Gets the address the other end appears under.
+     */
+    public InetSocketAddress getPeerAddress() {
+        return peerAddress;
+    }
+
+    @Override
+    public void send(ByteBuffer data, SocketAddress address) throws IOException {
+        ensureOpen();
+        if (fallback != null && !peerAddress.equals(address)) {
+            fallback.send(data, address);
+            return;
+        }
+
+        int length = data.remaining();
+        if (length > outbound.maxRecordLength()) {
+            throw new IOException("Datagram of " + length + " bytes exceeds ring record limit " + outbound.maxRecordLength());
+        }
+        boolean offered;
+        synchronized (sendLock) {
+            if (data.hasArray()) {
+                offered = outbound.offer(data.array(), data.arrayOffset() + data.position(), length);
+            } else {
+                data.get(data.position(), sendScratch, 0, length);
+                offered = outbound.offer(sendScratch, 0, length);
+            }
+        }
+        data.position(data.limit());
+        if (offered) {
+            signal(outboundWake);
+        } else {
+            dropped.incrementAndGet();
+        }
+    }
+
+    @Override
+    public SocketAddress receive(ByteBuffer buffer) throws IOException {
+        ensureOpen();
+        SocketAddress source = poll(buffer);
+        if (source != null || !blocking) {
+            return source;
+        }
+
+        long deadline = timeoutMs > 0 ? System.nanoTime() + timeoutMs * 1_000_000L : 0;
+        while (true) {
+            long remaining = deadline == 0 ? Long.MAX_VALUE : deadline - System.nanoTime();
+            if (remaining <= 0) {
+                throw new SocketTimeoutException("Receive timed out");
+            }
+            await(remaining);
+            source = poll(buffer);
+            if (source != null) {
+                return source;
+            }
+            ensureOpen();
+            if (Thread.currentThread().isInterrupted()) {
+                throw new InterruptedIOException("Receive interrupted");
+            }
+        }
+    }
+
+    @Override
+    public synchronized void setBlocking(boolean blocking) throws IOException {
+        this.blocking = blocking;
+        if (blocking && fallback != null && pump == null) {
+            fallback.setBlocking(true);
+            fallback.setTimeout(PUMP_TIMEOUT_MS);
+            pump = VirtualThreads.startVirtualThread(this::runPump);
+        }
+    }
+
+    @Override
+    public boolean isBlocking() {
+        return blocking;
+    }
+
+    @Override
+    public void setTimeout(int timeoutMs) {
+        if (timeoutMs < 0) {
+            throw new IllegalArgumentException("timeoutMs must be non-negative, got: " + timeoutMs);
+        }
+        this.timeoutMs = timeoutMs;
+    }
+
+    @Override
+    public boolean setDontFragment(boolean enabled) {
+        return fallback != null && fallback.setDontFragment(enabled);
+    }
+
+    @Override
+    public boolean isClosed() {
+        return closed;
+    }
+
+    /**
+     * Gets the number of datagrams dropped because a ring or the fallback queue was full.
+     */
+    public long getDroppedCount() {
+        return dropped.get();
+    }
+
+    /**
+     * Checks whether idle receivers sleep on a futex rather than parking in slices.
+     */
+    public static boolean isNativeWakeupAvailable() {
+        return NATIVE_WAKEUP;
+    }
+
+    @Override
+    public synchronized void close() throws IOException {
+        if (closed) {
+            return;
+        }
+        closed = true;
+        wakeLocal();
+        try {
+            if (fallback != null) {
+                fallback.close();
+            }
+        } finally {
+            Datagram datagram;
+            while ((datagram = relayed.poll()) != null) {
+                bufferPool.release(datagram.data());
+            }
+            if (creator) {
+                Files.deleteIfExists(file);
+            }
+        }
+    }
+
+    /**
+     * Takes the next datagram from the ring, then from the fallback, without waiting.
+     */
+    private SocketAddress poll(ByteBuffer buffer) throws IOException {
+        int length = inbound.poll(receiveScratch);
+        if (length >= 0) {
+            buffer.put(receiveScratch, 0, Math.min(length, buffer.remaining()));
+            return peerAddress;
+        }
+
+        Datagram datagram = relayed.poll();
+        if (datagram != null) {
+            relayedCount.decrementAndGet();
+            buffer.put(datagram.data(), 0, Math.min(datagram.length(), buffer.remaining()));
+            bufferPool.release(datagram.data());
+            return datagram.source();
+        }
+
+        return fallback != null && pump == null ? fallback.receive(buffer) : null;
+    }
+
+    /**
+     * Sleeps until signalled or up to {@code nanos}. Registering as a waiter before reading
+     * the wake word and rechecking the queues pairs with {@link #signal}, which publishes
+     * first and then reads the waiter count, so a wake-up is never lost.
+     */
+    private void await(long nanos) {
+        waiter = Thread.currentThread();
+        INT.getAndAdd(map, inboundWake + WAITERS, 1);
+        try {
+            int sequence = (int) INT.getVolatile(map, inboundWake);
+            if (!inbound.isEmpty() || !relayed.isEmpty() || closed) {
+                return;
+            }
+            if (NATIVE_WAKEUP) {
+                futexWait(map, inboundWake, sequence, Math.min(nanos, 1_000_000_000L));
+            } else {
+                LockSupport.parkNanos(this, Math.min(nanos, PARK_NANOS));
+            }
+        } finally {
+            INT.getAndAdd(map, inboundWake + WAITERS, -1);
+            waiter = null;
+        }
+    }
+
+    private void signal(int wake) {
+        VarHandle.fullFence();
+        if ((int) INT.getVolatile(map, wake + WAITERS) != 0) {
+            INT.getAndAdd(map, wake, 1);
+            if (NATIVE_WAKEUP) {
+                futexWake(map, wake, 1);
+            }
+        }
+    }
+
+    private void wakeLocal() {
+        signal(inboundWake);
+        Thread thread = waiter;
+        if (thread != null) {
+            LockSupport.unpark(thread);
+        }
+    }
+
+    private void runPump() {
+        ByteBuffer buffer = ByteBuffer.allocate(MAX_DATAGRAM_SIZE);
+        while (!closed) {
+            try {
+                buffer.clear();
+                SocketAddress source = fallback.receive(buffer);
+                if (source == null) {
+                    continue;
+                }
+                if (relayedCount.incrementAndGet() > QUEUE_CAPACITY) {
+                    relayedCount.decrementAndGet();
+                    dropped.incrementAndGet();
+                    continue;
+                }
+                int length = buffer.position();
+                byte[] data = length <= POOLED_BUFFER_SIZE ? bufferPool.acquire() : new byte[length];
+                System.arraycopy(buffer.array(), 0, data, 0, length);
+                relayed.offer(new Datagram(data, length, source));
+                wakeLocal();
+            } catch (SocketTimeoutException e) {
+                // Re-check closed
+            } catch (IOException e) {
+                if (closed || fallback.isClosed()) {
+                    break;
+                }
+                logger.log(Level.FINE, "Fallback receive failed", e);
+            }
+        }
+    }
+
+    private void ensureOpen() throws SocketException {
+        if (closed) {
+            throw new SocketException("Socket is closed");
+        }
+    }
+
+    private static long fileSize(int ringCapacity) {
+        return FILE_HEADER_SIZE + 2L * (SpscByteRing.HEADER_SIZE + ringCapacity);
+    }
+
+    private static int portOf(SocketAddress address) {
+        return address instanceof InetSocketAddress inet ? inet.getPort() : 0;
+    }
+
+    private static boolean loadNativeWakeup() {
+        try {
+            if (!Boolean.getBoolean(EMBEDDED_PROPERTY)) {
+                System.loadLibrary("neon_jni");
+            }
+            return futexWake(ByteBuffer.allocateDirect(4), 0, 1) >= 0;
+        } catch (UnsatisfiedLinkError e) {
+            logger.log(Level.FINE, "neon_jni not available, shared-memory receivers will park in slices", e);
+            return false;
+        }
+    }
+
+    /**
+     * Sleeps while the int at {@code offset} equals {@code expected}, for at most
+     * {@code timeoutNanos}. Returns -1 if futexes are unsupported.
+     */
+    private static native int futexWait(ByteBuffer buffer, int offset, int expected, long timeoutNanos);
+
+    /**
+     * Wakes up to {@code count} threads sleeping on the int at {@code offset}, in any
+     * process. Returns the number woken, or -1 if futexes are unsupported.
+     */
+    private static native int futexWake(ByteBuffer buffer, int offset, int count);
+
+    private record Datagram(byte[] data, int length, SocketAddress source) {
+    }
+}
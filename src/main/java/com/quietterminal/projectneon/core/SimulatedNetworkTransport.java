@@ -0,0 +1,462 @@
+package com.quietterminal.projectneon.core;
+
+import com.quietterminal.projectneon.util.LoggerConfig;
+import com.quietterminal.projectneon.util.VirtualThreads;
+
+import java.io.IOException;
+import java.net.SocketAddress;
+import java.net.SocketException;
+import java.nio.ByteBuffer;
+import java.util.SplittableRandom;
+import java.util.concurrent.DelayQueue;
+import java.util.concurrent.Delayed;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.logging.Level;
+import java.util.logging.Logger;
+
+/**
+ * Transport decorator that impairs outgoing datagrams the way a real network path would:
+ * loss, latency, jitter, reordering, duplication and a bandwidth cap with a drop-tail queue.
+ *
+ * <p>Every random decision comes from one generator seeded by {@link Conditions#setSeed seed}, and
+ * each datagram draws the same number of values whatever the outcome, so the same seed
+ * and the same sequence of sends give the same losses, delays and duplicates on every run.
+ * Changing one impairment leaves the others' pattern unchanged. Bandwidth drops are the
+ * exception: the queue drains in real time, so whether a datagram overflows it depends on
+ * when it is sent, and the same seed may overflow different datagrams from run to run.
+ *
+ * <p>Only sends are impaired; receives pass straight to the wrapped transport. Wrap both
+ * ends to impair both directions, for example two {@link LoopbackTransport}s to test a
+ * reliability feature at memory speed:
+ * <pre>{@code
+ * SimulatedNetworkTransport.Conditions wan = new SimulatedNetworkTransport.Conditions()
+ *     .setLossRate(0.02).setLatencyMs(40).setJitterMs(10).setSeed(7);
+ * Transport client = new SimulatedNetworkTransport(new LoopbackTransport(network), wan);
+ * }</pre>
+ *
+ * <p>Delayed datagrams are handed to the wrapped transport by a virtual thread started on
+ * the first delayed send. Without latency, jitter, reordering or a bandwidth cap, datagrams
+ * go out on the calling thread.
+ *
+ * @since 1.3
+ */
+public class SimulatedNetworkTransport implements Transport {
+    private static final Logger logger;
+
+    static {
+        logger = Logger.getLogger(SimulatedNetworkTransport.class.getName());
+        LoggerConfig.configureLogger(logger);
+    }
+
+    private final Transport transport;
+    private final Conditions conditions;
+    private final SplittableRandom random;
+    private final DelayQueue<Scheduled> scheduled = new DelayQueue<>();
+    private final AtomicLong sent = new AtomicLong();
+    private final AtomicLong lost = new AtomicLong();
+    private final AtomicLong overflowed = new AtomicLong();
+    private final AtomicLong duplicated = new AtomicLong();
+    private final AtomicLong reordered = new AtomicLong();
+    private long nextOrder;
+    private long linkFreeAt;
+    private volatile boolean closed;
+    private Thread deliveryThread;
+
+    /**
+     * Wraps a transport with the given conditions. Later changes to {@code conditions} are
+     * not seen; the transport keeps its own copy.
+     *
+     * @param transport the transport to impair
+     * @param conditions the network conditions to simulate
+     */
+    public SimulatedNetworkTransport(Transport transport, Conditions conditions) {
+        if (transport == null) {
+            throw new IllegalArgumentException("transport cannot be null");
+        }
+        if (conditions == null) {
+            throw new IllegalArgumentException("conditions cannot be null");
+        }
+        this.transport = transport;
+        this.conditions = conditions.copy();
+        this.random = new SplittableRandom(conditions.seed);
+    }
+
+    /**
+     * Gets the wrapped transport.
+     */
+    public Transport getTransport() {
+        return transport;
+    }
+
+    /**
+     * Gets a copy of the simulated conditions.
+     */
+    public Conditions getConditions() {
+        return conditions.copy();
+    }
+
+    @Override
+    public Type getType() {
+        return transport.getType();
+    }
+
+    @Override
+    public void bind(int port) throws IOException {
+        transport.bind(port);
+    }
+
+    @Override
+    public SocketAddress getLocalAddress() {
+        return transport.getLocalAddress();
+    }
+
+    @Override
+    public void send(ByteBuffer data, SocketAddress address) throws IOException {
+        if (closed) {
+            throw new SocketException("Socket is closed");
+        }
+        int length = data.remaining();
+        long now = System.nanoTime();
+        long firstDelay;
+        long secondDelay;
+
+        synchronized (this) {
+            sent.incrementAndGet();
+            double lossDraw = random.nextDouble();
+            double jitterDraw = random.nextDouble();
+            double reorderDraw = random.nextDouble();
+            double duplicateDraw = random.nextDouble();
+            double duplicateJitterDraw = random.nextDouble();
+
+            if (lossDraw < conditions.lossRate) {
+                lost.incrementAndGet();
+                data.position(data.limit());
+                return;
+            }
+
+            long departure = now;
+            if (conditions.bandwidthBytesPerSecond > 0) {
+                long start = Math.max(now, linkFreeAt);
+                long backlogBytes = (start - now) * conditions.bandwidthBytesPerSecond / 1_000_000_000L;
+                if (backlogBytes + length > conditions.queueLimitBytes) {
+                    overflowed.incrementAndGet();
+                    data.position(data.limit());
+                    return;
+                }
+                linkFreeAt = start + length * 1_000_000_000L / conditions.bandwidthBytesPerSecond;
+                departure = linkFreeAt;
+            }
+
+            long propagation = TimeUnit.MILLISECONDS.toNanos(conditions.latencyMs);
+            firstDelay = departure - now + propagation + jitter(jitterDraw);
+            if (reorderDraw < conditions.reorderRate) {
+                reordered.incrementAndGet();
+                firstDelay += TimeUnit.MILLISECONDS.toNanos(conditions.reorderDelayMs);
+            }
+            if (duplicateDraw < conditions.duplicateRate) {
+                duplicated.incrementAndGet();
+                secondDelay = departure - now + propagation + jitter(duplicateJitterDraw);
+            } else {
+                secondDelay = -1;
+            }
+        }
+
+        if (firstDelay == 0 && secondDelay <= 0) {
+            ByteBuffer copy = secondDelay == 0 ? data.duplicate() : null;
+            transport.send(data, address);
+            if (copy != null) {
+                transport.send(copy, address);
+            }
+            return;
+        }
+
+        byte[] bytes = new byte[length];
+        data.get(bytes);
+        schedule(now + firstDelay, bytes, address);
+        if (secondDelay >= 0) {
+            schedule(now + secondDelay, bytes, address);
+        }
+    }
+
+    @Override
+    public SocketAddress receive(ByteBuffer buffer) throws IOException {
+        return transport.receive(buffer);
+    }
+
+    @Override
+    public void setBlocking(boolean blocking) throws IOException {
+        transport.setBlocking(blocking);
+    }
+
+    @Override
+    public boolean isBlocking() {
+        return transport.isBlocking();
+    }
+
+    @Override
+    public boolean setDontFragment(boolean enabled) {
+        return transport.setDontFragment(enabled);
+    }
+
+    @Override
+    public void setTimeout(int timeoutMs) throws IOException {
+        transport.setTimeout(timeoutMs);
+    }
+
+    @Override
+    public boolean isClosed() {
+        return closed || transport.isClosed();
+    }
+
+    /**
+     * Gets the number of datagrams still in flight.
+     */
+    public int getInFlightCount() {
+        return scheduled.size();
+    }
+
+    /**
+     * Gets counters of what the simulator has done to the datagrams sent so far.
+     */
+    public Stats getStats() {
+        return new Stats(sent.get(), lost.get(), overflowed.get(), duplicated.get(), reordered.get());
+    }
+
+    /**
+     * Closes the wrapped transport. Datagrams still in flight are discarded.
+     */
+    @Override
+    public void close() throws IOException {
+        Thread thread;
+        synchronized (this) {
+            closed = true;
+            thread = deliveryThread;
+        }
+        if (thread != null) {
+            thread.interrupt();
+        }
+        scheduled.clear();
+        transport.close();
+    }
+
+    private long jitter(double draw) {
+        return (long) (draw * TimeUnit.MILLISECONDS.toNanos(conditions.jitterMs));
+    }
+
+    private void schedule(long due, byte[] bytes, SocketAddress address) {
+        synchronized (this) {
+            if (closed) {
+                return;
+            }
+            scheduled.offer(new Scheduled(due, nextOrder++, bytes, address));
+            if (deliveryThread == null) {
+                deliveryThread = VirtualThreads.startVirtualThread(this::deliver);
+            }
+        }
+    }
+
+    private void deliver() {
+        while (!closed) {
+            Scheduled next;
+            try {
+                next = scheduled.take();
+            } catch (InterruptedException e) {
+                return;
+            }
+            try {
+                transport.send(ByteBuffer.wrap(next.data()), next.address());
+            } catch (IOException e) {
+                if (closed || transport.isClosed()) {
+                    return;
+                }
+                logger.log(Level.FINE, "Delayed send failed", e);
+            }
+        }
+    }
+
+    /**
+     * Counters of simulator decisions.
+     *
+     * @param sent datagrams passed to {@link #send}
+     * @param lost datagrams dropped by random loss
+     * @param overflowed datagrams dropped because the bandwidth queue was full
+     * @param duplicated datagrams delivered twice
+     * @param reordered datagrams held back so that later ones overtake them
+     */
+    public record Stats(long sent, long lost, long overflowed, long duplicated, long reordered) {
+    }
+
+    private record Scheduled(long due, long order, byte[] data, SocketAddress address) implements Delayed {
+        @Override
+        public long getDelay(TimeUnit unit) {
+            return unit.convert(due - System.nanoTime(), TimeUnit.NANOSECONDS);
+        }
+
+        @Override
+        public int compareTo(Delayed other) {
+            Scheduled that = (Scheduled) other;
+            int byDue = Long.compare(due, that.due);
+            return byDue != 0 ? byDue : Long.compare(order, that.order);
+        }
+    }
+
+    /**
+     * Network conditions for a {@link SimulatedNetworkTransport}. Rates are probabilities
+     * per datagram in [0, 1]; times are one-way, in milliseconds.
+     */
+    public static final class Conditions {
+        private double lossRate;
+        private int latencyMs;
+        private int jitterMs;
+        private double reorderRate;
+        private int reorderDelayMs = 10;
+        private double duplicateRate;
+        private long bandwidthBytesPerSecond;
+        private int queueLimitBytes = 64 * 1024;
+        private long seed;
+
+        /**
+         * Sets the probability that a datagram is lost.
+         */
+        public Conditions setLossRate(double lossRate) {
+            this.lossRate = checkRate("lossRate", lossRate);
+            return this;
+        }
+
+        /**
+         * Sets the fixed one-way delay.
+         */
+        public Conditions setLatencyMs(int latencyMs) {
+            this.latencyMs = checkNonNegative("latencyMs", latencyMs);
+            return this;
+        }
+
+        /**
+         * Sets the upper bound of the uniform random delay added to the latency.
+         */
+        public Conditions setJitterMs(int jitterMs) {
+            this.jitterMs = checkNonNegative("jitterMs", jitterMs);
+            return this;
+        }
+
+        /**
+         * Sets the probability that a datagram is held back by the reorder delay.
+         */
+        public Conditions setReorderRate(double reorderRate) {
+            this.reorderRate = checkRate("reorderRate", reorderRate);
+            return this;
+        }
+
+        /**
+         * Sets the extra delay of a reordered datagram.
+         */
+        public Conditions setReorderDelayMs(int reorderDelayMs) {
+            this.reorderDelayMs = checkNonNegative("reorderDelayMs", reorderDelayMs);
+            return this;
+        }
+
+        /**
+         * Sets the probability that a datagram is delivered twice.
+         */
+        public Conditions setDuplicateRate(double duplicateRate) {
+            this.duplicateRate = checkRate("duplicateRate", duplicateRate);
+            return this;
+        }
+
+        /**
+         * Sets the link rate, or 0 for unlimited.
+         */
+        public Conditions setBandwidthBytesPerSecond(long bandwidthBytesPerSecond) {
+            if (bandwidthBytesPerSecond < 0) {
+                throw new IllegalArgumentException("bandwidthBytesPerSecond must be non-negative, got: " + bandwidthBytesPerSecond);
+            }
+            this.bandwidthBytesPerSecond = bandwidthBytesPerSecond;
+            return this;
+        }
+
+        /**
+         * Sets how many bytes may wait for the link before datagrams are dropped. The backlog
+         * is measured against the wall clock, so these drops are not reproducible from the seed.
+         */
+        public Conditions setQueueLimitBytes(int queueLimitBytes) {
+            if (queueLimitBytes <= 0) {
+                throw new IllegalArgumentException("queueLimitBytes must be positive, got: " + queueLimitBytes);
+            }
+            this.queueLimitBytes = queueLimitBytes;
+            return this;
+        }
+
+        /**
+         * Sets the seed of the random decisions.
+         */
+        public Conditions setSeed(long seed) {
+            this.seed = seed;
+            return this;
+        }
+
+        public double getLossRate() {
+            return lossRate;
+        }
+
+        public int getLatencyMs() {
+            return latencyMs;
+        }
+
+        public int getJitterMs() {
+            return jitterMs;
+        }
+
+        public double getReorderRate() {
+            return reorderRate;
+        }
+
+        public int getReorderDelayMs() {
+            return reorderDelayMs;
+        }
+
+        public double getDuplicateRate() {
+            return duplicateRate;
+        }
+
+        public long getBandwidthBytesPerSecond() {
+            return bandwidthBytesPerSecond;
+        }
+
+        public int getQueueLimitBytes() {
+            return queueLimitBytes;
+        }
+
+        public long getSeed() {
+            return seed;
+        }
+
+        private Conditions copy() {
+            Conditions copy = new Conditions();
+            copy.lossRate = lossRate;
+            copy.latencyMs = latencyMs;
+            copy.jitterMs = jitterMs;
+            copy.reorderRate = reorderRate;
+            copy.reorderDelayMs = reorderDelayMs;
+            copy.duplicateRate = duplicateRate;
+            copy.bandwidthBytesPerSecond = bandwidthBytesPerSecond;
+            copy.queueLimitBytes = queueLimitBytes;
+            copy.seed = seed;
+            return copy;
+        }
+
+        private static double checkRate(String name, double rate) {
+            if (!(rate >= 0.0 && rate <= 1.0)) {
+                throw new IllegalArgumentException(name + " must be between 0 and 1, got: " + rate);
+            }
+            return rate;
+        }
+
+        private static int checkNonNegative(String name, int value) {
+            if (value < 0) {
+                throw new IllegalArgumentException(name + " must be non-negative, got: " + value);
+            }
+            return value;
+        }
+    }
+}
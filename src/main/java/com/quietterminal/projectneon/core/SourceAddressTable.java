@@ -0,0 +1,256 @@
+package com.quietterminal.projectneon.core;
+
+import java.net.Inet6Address;
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+import java.net.SocketAddress;
+import java.util.Arrays;
+
+/**
+ * Interns datagram source addresses into dense integer slots.
+ *
+ * <p>Each distinct IP address and port maps to a slot in {@code [0, capacity)} through an
+ * open-addressing table of primitive keys. The slot owns one canonical
+ * {@link InetSocketAddress}, so every packet from a source reports the same instance, and
+ * per-source state can live in plain arrays indexed by slot instead of hash maps keyed by
+ * address.
+ *
+ * <p>Interning does not make receiving allocation-free: the {@link Transport} still returns
+ * a new address object per datagram, and its bytes are copied out through
+ * {@link InetAddress#getAddress()}; {@link NeonSocket} copies them once and shares them
+ * with the source filter. The gain is in what follows the
+ * receive, such as the relay's rate limiter lookup by slot.
+ *
+ * <p>Not thread-safe: the table is owned by the thread that receives packets.
+ *
+ * @since 1.3
+ */
+public final class SourceAddressTable {
+
+    private static final int EMPTY = -1;
+    private static final long IPV4_MAPPED_PREFIX = 0xFFFF_0000_0000L;
+
+    private final int capacity;
+    private final int[] buckets;
+    private final int mask;
+
+    private final long[] keyHigh;
+    private final long[] keyLow;
+    private final int[] keyPort;
+    private final int[] keyScope;
+    private final InetSocketAddress[] addresses;
+
+    private final int[] freeSlots;
+    private int freeCount;
+    private int size;
+
+    /**
+     * Creates a table holding up to {@code capacity} distinct sources.
+     *
+     * @param capacity the maximum number of slots
+     */
+    public SourceAddressTable(int capacity) {
+        if (capacity <= 0 || capacity > (1 << 24)) {
+            throw new IllegalArgumentException("capacity must be between 1 and 16777216, got: " + capacity);
+        }
+        this.capacity = capacity;
+        int bucketCount = Integer.highestOneBit(Math.max(2, capacity * 2 - 1)) << 1;
+        this.buckets = new int[bucketCount];
+        this.mask = bucketCount - 1;
+        Arrays.fill(buckets, EMPTY);
+
+        this.keyHigh = new long[capacity];
+        this.keyLow = new long[capacity];
+        this.keyPort = new int[capacity];
+        this.keyScope = new int[capacity];
+        this.addresses = new InetSocketAddress[capacity];
+
+        this.freeSlots = new int[capacity];
+        for (int i = 0; i < capacity; i++) {
+            freeSlots[i] = capacity - 1 - i;
+        }
+        this.freeCount = capacity;
+    }
+
+    /**
+     * Returns the slot for a source, assigning one on first sight.
+     *
+     * @param address the source IP address
+     * @param port the source port
+     * @return the slot, or -1 if the table is full
+     */
+    public int intern(InetAddress address, int port) {
+        return intern(address, address.getAddress(), port);
+    }
+
+    /**
+     * Returns the slot for a source whose raw address the caller already holds, assigning
+     * one on first sight.
+     *
+     * @param address the source IP address
+     * @param raw the bytes of {@code address}, as returned by {@link InetAddress#getAddress()}
+     * @param port the source port
+     * @return the slot, or -1 if the table is full
+     */
+    public int intern(InetAddress address, byte[] raw, int port) {
+        long high = high(raw);
+        long low = low(raw);
+        int scope = scope(address);
+
+        int bucket = hash(high, low, port, scope) & mask;
+        while (true) {
+            int slot = buckets[bucket];
+            if (slot == EMPTY) {
+                break;
+            }
+            if (keyLow[slot] == low && keyPort[slot] == port && keyHigh[slot] == high && keyScope[slot] == scope) {
+                return slot;
+            }
+            bucket = (bucket + 1) & mask;
+        }
+
+        if (freeCount == 0) {
+            return -1;
+        }
+        int slot = freeSlots[--freeCount];
+        keyHigh[slot] = high;
+        keyLow[slot] = low;
+        keyPort[slot] = port;
+        keyScope[slot] = scope;
+        addresses[slot] = new InetSocketAddress(address, port);
+        buckets[bucket] = slot;
+        size++;
+        return slot;
+    }
+
+    /**
+     * Looks up the slot of an address without assigning one.
+     *
+     * @param address the socket address
+     * @return the slot, or -1 if the address is not interned
+     */
+    public int slotOf(SocketAddress address) {
+        if (!(address instanceof InetSocketAddress inet) || inet.getAddress() == null) {
+            return -1;
+        }
+        int bucket = findBucket(inet.getAddress(), inet.getPort());
+        return bucket == EMPTY ? -1 : buckets[bucket];
+    }
+
+    /**
+     * Gets the canonical address of a slot.
+     *
+     * @param slot the slot
+     * @return the address, or null if the slot is free
+     */
+    public InetSocketAddress addressOf(int slot) {
+        return addresses[slot];
+    }
+
+    /**
+     * Frees a slot so it can be reused by another source.
+     *
+     * @param slot the slot to free
+     */
+    public void release(int slot) {
+        InetSocketAddress address = addresses[slot];
+        if (address == null) {
+            return;
+        }
+        int bucket = findBucket(address.getAddress(), address.getPort());
+        if (bucket != EMPTY) {
+            removeBucket(bucket);
+        }
+        addresses[slot] = null;
+        freeSlots[freeCount++] = slot;
+        size--;
+    }
+
+    /**
+     * Gets the number of interned sources.
+     */
+    public int size() {
+        return size;
+    }
+
+    /**
+     * Gets the maximum number of interned sources.
+     */
+    public int capacity() {
+        return capacity;
+    }
+
+    private int findBucket(InetAddress address, int port) {
+        byte[] raw = address.getAddress();
+        long high = high(raw);
+        long low = low(raw);
+        int scope = scope(address);
+
+        int bucket = hash(high, low, port, scope) & mask;
+        while (true) {
+            int slot = buckets[bucket];
+            if (slot == EMPTY) {
+                return EMPTY;
+            }
+            if (keyLow[slot] == low && keyPort[slot] == port && keyHigh[slot] == high && keyScope[slot] == scope) {
+                return bucket;
+            }
+            bucket = (bucket + 1) & mask;
+        }
+    }
+
+    /**
+     * Backward-shift deletion for linear probing: later entries of the same probe run
+     * are moved into the hole so lookups never stop early.
+     */
+    private void removeBucket(int bucket) {
+        int hole = bucket;
+        int next = bucket;
+        while (true) {
+            next = (next + 1) & mask;
+            int slot = buckets[next];
+            if (slot == EMPTY) {
+                break;
+            }
+            int home = hash(keyHigh[slot], keyLow[slot], keyPort[slot], keyScope[slot]) & mask;
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                buckets[hole] = slot;
+                hole = next;
+            }
+        }
+        buckets[hole] = EMPTY;
+    }
+
+    private static long high(byte[] raw) {
+        if (raw.length == 4) {
+            return 0L;
+        }
+        long value = 0;
+        for (int i = 0; i < 8; i++) {
+            value = (value << 8) | (raw[i] & 0xFF);
+        }
+        return value;
+    }
+
+    private static long low(byte[] raw) {
+        if (raw.length == 4) {
+            return IPV4_MAPPED_PREFIX
+                | (raw[0] & 0xFFL) << 24 | (raw[1] & 0xFFL) << 16 | (raw[2] & 0xFFL) << 8 | (raw[3] & 0xFFL);
+        }
+        long value = 0;
+        for (int i = 8; i < 16; i++) {
+            value = (value << 8) | (raw[i] & 0xFF);
+        }
+        return value;
+    }
+
+    private static int scope(InetAddress address) {
+        return address instanceof Inet6Address inet6 ? inet6.getScopeId() : 0;
+    }
+
+    private static int hash(long high, long low, int port, int scope) {
+        long h = (high * 0x9E3779B97F4A7C15L) ^ low ^ ((long) port << 32 | (scope & 0xFFFFFFFFL));
+        h *= 0xC2B2AE3D27D4EB4FL;
+        return (int) (h ^ (h >>> 29) ^ (h >>> 47));
+    }
+}
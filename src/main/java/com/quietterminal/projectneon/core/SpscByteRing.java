@@ -0,0 +1,244 @@
+package com.quietterminal.projectneon.core;
+
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.VarHandle;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+/**
+ * Single-producer single-consumer ring of variable-length records over a direct or mapped
+ * {@link ByteBuffer}.
+ *
+ * <p>The whole ring state lives in the buffer, so the other side may be native code (see
+ * {@code neon_ring.h}) or another process mapping the same file. The layout, in native byte
+ * order, is:
+ * <pre>
+ * [0..8)      consumer position (head)
+ * [64..72)    producer position (tail), on its own cache line
+ * [128..)     data region, a power of two of at least 64 bytes
+ * </pre>
+ * Positions only ever grow; the data index is the position masked by the capacity. Each
+ * record is a 4-byte length followed by its bytes, padded to 8 bytes. A length of -1 marks
+ * unused space at the end of the data region and tells the consumer to continue from index 0.
+ * Records are published by a release store of the tail and freed by a release store of the
+ * head, so neither side ever takes a lock or calls into the other.
+ *
+ * <p>One thread may produce and one other thread may consume at a time.
+ *
+ * @since 1.3
+ */
+public final class SpscByteRing {
+
+    /**
+     * Bytes reserved in front of the data region for the two positions.
+     */
+    public static final int HEADER_SIZE = 128;
+
+    /**
+     * Bytes in front of every record.
+     */
+    public static final int RECORD_HEADER_SIZE = 4;
+
+    private static final int HEAD_OFFSET = 0;
+    private static final int TAIL_OFFSET = 64;
+    private static final int ALIGNMENT = 8;
+    private static final int WRAP_MARKER = -1;
+    private static final int MIN_CAPACITY = 64;
+
+    private static final VarHandle POSITION =
+        MethodHandles.byteBufferViewVarHandle(long[].class, ByteOrder.nativeOrder());
+
+    private final ByteBuffer buffer;
+    private final int capacity;
+    private final int mask;
+
+    private long cachedHead;
+    private long cachedTail;
+
+    /**
+     * Wraps a buffer that holds, or will hold, a ring.
+     *
+     * @param buffer a direct or mapped buffer of {@link #HEADER_SIZE} plus a power of two bytes
+     */
+    public SpscByteRing(ByteBuffer buffer) {
+        if (buffer == null || !buffer.isDirect()) {
+            throw new IllegalArgumentException("Ring buffer must be direct");
+        }
+        int capacity = buffer.capacity() - HEADER_SIZE;
+        if (capacity < MIN_CAPACITY || Integer.bitCount(capacity) != 1) {
+            throw new IllegalArgumentException(
+                "Ring data region must be a power of two of at least " + MIN_CAPACITY + " bytes, got: " + capacity);
+        }
+        this.buffer = buffer.duplicate().order(ByteOrder.nativeOrder());
+        this.capacity = capacity;
+        this.mask = capacity - 1;
+        this.cachedHead = head();
+        this.cachedTail = tail();
+    }
+
+    /**
+     * Allocates an empty ring with a data region of the given size.
+     *
+     * @param capacity the data region size, a power of two
+     */
+    public static SpscByteRing allocate(int capacity) {
+        if (capacity < MIN_CAPACITY || Integer.bitCount(capacity) != 1) {
+            throw new IllegalArgumentException("capacity must be a power of two of at least " + MIN_CAPACITY + ", got: " + capacity);
+        }
+        return new SpscByteRing(ByteBuffer.allocateDirect(HEADER_SIZE + capacity));
+    }
+
+    /**
+     * Gets the size of the data region.
+     */
+    public int capacity() {
+        return capacity;
+    }
+
+    /**
+     * Gets the largest record this ring always has room for once drained.
+     */
+    public int maxRecordLength() {
+        return capacity / 2 - RECORD_HEADER_SIZE;
+    }
+
+    /**
+     * Checks whether the ring holds no records. Exact only on the consumer thread.
+     */
+    public boolean isEmpty() {
+        return head() == tail();
+    }
+
+    /**
+     * Appends a record made of a two-byte prefix and a payload. Producer side only.
+     *
+     * @return false if the ring is full or the record is too long
+     */
+    public boolean offer(byte first, byte second, byte[] payload, int offset, int length) {
+        int recordLength = 2 + length;
+        int index = claim(recordLength);
+        if (index < 0) {
+            return false;
+        }
+        int data = HEADER_SIZE + index + RECORD_HEADER_SIZE;
+        buffer.put(data, first);
+        buffer.put(data + 1, second);
+        buffer.put(data + 2, payload, offset, length);
+        publish(index, recordLength);
+        return true;
+    }
+
+    /**
+     * Appends a record. Producer side only.
+     *
+     * @return false if the ring is full or the record is too long
+     */
+    public boolean offer(byte[] record, int offset, int length) {
+        int index = claim(length);
+        if (index < 0) {
+            return false;
+        }
+        buffer.put(HEADER_SIZE + index + RECORD_HEADER_SIZE, record, offset, length);
+        publish(index, length);
+        return true;
+    }
+
+    /**
+     * Gets the length of the oldest record without consuming it. Consumer side only.
+     *
+     * @return the record length, or -1 if the ring is empty
+     */
+    public int peekLength() {
+        int index = front();
+        return index < 0 ? -1 : buffer.getInt(HEADER_SIZE + index);
+    }
+
+    /**
+     * Copies the oldest record into {@code dst} and consumes it. Consumer side only.
+     *
+     * @param dst a buffer of at least {@link #peekLength()} bytes
+     * @return the record length, or -1 if the ring is empty
+     */
+    public int poll(byte[] dst) {
+        int index = front();
+        if (index < 0) {
+            return -1;
+        }
+        int length = buffer.getInt(HEADER_SIZE + index);
+        if (length > dst.length) {
+            throw new IllegalArgumentException("Record of " + length + " bytes does not fit in " + dst.length);
+        }
+        buffer.get(HEADER_SIZE + index + RECORD_HEADER_SIZE, dst, 0, length);
+        POSITION.setRelease(buffer, HEAD_OFFSET, head() + align(RECORD_HEADER_SIZE + length));
+        return length;
+    }
+
+    /**
+     * Returns the data index of the oldest record, skipping a wrap marker, or -1 if empty.
+     */
+    private int front() {
+        long head = head();
+        if (head == cachedTail) {
+            cachedTail = (long) POSITION.getAcquire(buffer, TAIL_OFFSET);
+            if (head == cachedTail) {
+                return -1;
+            }
+        }
+        int index = (int) (head & mask);
+        if (buffer.getInt(HEADER_SIZE + index) == WRAP_MARKER) {
+            head += capacity - index;
+            POSITION.setRelease(buffer, HEAD_OFFSET, head);
+            return front();
+        }
+        return index;
+    }
+
+    /**
+     * Reserves space for a record, writing a wrap marker first if needed.
+     *
+     * @return the data index of the record, or -1 if it does not fit
+     */
+    private int claim(int length) {
+        if (length < 0 || length > maxRecordLength()) {
+            return -1;
+        }
+        int size = align(RECORD_HEADER_SIZE + length);
+        long tail = tail();
+        int index = (int) (tail & mask);
+        int padding = capacity - index < size ? capacity - index : 0;
+        if (!hasRoom(tail, padding + size)) {
+            return -1;
+        }
+        if (padding > 0) {
+            buffer.putInt(HEADER_SIZE + index, WRAP_MARKER);
+            POSITION.setRelease(buffer, TAIL_OFFSET, tail + padding);
+            index = 0;
+        }
+        return index;
+    }
+
+    private void publish(int index, int length) {
+        buffer.putInt(HEADER_SIZE + index, length);
+        POSITION.setRelease(buffer, TAIL_OFFSET, tail() + align(RECORD_HEADER_SIZE + length));
+    }
+
+    private boolean hasRoom(long tail, int size) {
+        if (tail + size - cachedHead <= capacity) {
+            return true;
+        }
+        cachedHead = (long) POSITION.getAcquire(buffer, HEAD_OFFSET);
+        return tail + size - cachedHead <= capacity;
+    }
+
+    private long head() {
+        return (long) POSITION.getOpaque(buffer, HEAD_OFFSET);
+    }
+
+    private long tail() {
+        return (long) POSITION.getOpaque(buffer, TAIL_OFFSET);
+    }
+
+    private static int align(int size) {
+        return (size + ALIGNMENT - 1) & -ALIGNMENT;
+    }
+}
@@ -2,6 +2,7 @@ package com.quietterminal.projectneon.core;
 
 import java.io.IOException;
 import java.net.SocketAddress;
+import java.nio.ByteBuffer;
 
 /**
  * Abstract transport layer for Neon protocol communication.
@@ -15,6 +16,12 @@ import java.net.SocketAddress;
  *   <li>Managing socket options and timeouts</li>
  * </ul>
  *
+ * <p>Data moves through caller-owned {@link ByteBuffer}s, one datagram per call, so an
+ * implementation can copy straight between its own storage and the caller's pooled
+ * buffers. {@link NeonSocket} layers Neon framing, filtering and encryption on top of any
+ * transport and is itself a transport, so the relay, host, client and reliability
+ * managers run unchanged over UDP or any other implementation.
+ *
  * @since 1.1
  */
 public interface Transport extends AutoCloseable {
@@ -25,7 +32,11 @@ public interface Transport extends AutoCloseable {
     enum Type {
         UDP,
         TCP,
-        QUIC
+        QUIC,
+        /** In-process endpoints, see {@link LoopbackTransport}. @since 1.3 */
+        LOOPBACK,
+        /** Processes on one machine, see {@link SharedMemoryTransport}. @since 1.3 */
+        SHARED_MEMORY
     }
 
     /**
@@ -51,6 +62,16 @@ public interface Transport extends AutoCloseable {
      */
     SocketAddress getLocalAddress();
 
+    /**
+     * Sends the remaining bytes of a buffer as one datagram to the specified address.
+     * The buffer's position is advanced past the bytes sent.
+     *
+     * @param data the data to send
+     * @param address the destination address
+     * @throws IOException if sending fails
+     */
+    void send(ByteBuffer data, SocketAddress address) throws IOException;
+
     /**
      * Sends raw bytes to the specified address.
      *
@@ -58,7 +79,9 @@ public interface Transport extends AutoCloseable {
      * @param address the destination address
      * @throws IOException if sending fails
      */
-    void send(byte[] data, SocketAddress address) throws IOException;
+    default void send(byte[] data, SocketAddress address) throws IOException {
+        send(ByteBuffer.wrap(data), address);
+    }
 
     /**
      * Sends a Neon packet to the specified address.
@@ -72,13 +95,17 @@ public interface Transport extends AutoCloseable {
     }
 
     /**
-     * Receives a packet from the transport.
-     * Returns null if no packet is available (non-blocking) or throws on timeout.
+     * Receives one datagram into the buffer, starting at its position, and advances the
+     * position past it. Bytes beyond the buffer's remaining space are discarded, so a
+     * datagram that fills the buffer may have been truncated.
+     * Returns null if no datagram is available (non-blocking) or throws on timeout.
      *
-     * @return the received packet or null
+     * @param buffer the buffer to receive into
+     * @return the source address, or null if nothing was received
+     * @throws java.net.SocketTimeoutException if the receive timeout expires in blocking mode
      * @throws IOException if receiving fails
      */
-    ReceivedData receive() throws IOException;
+    SocketAddress receive(ByteBuffer buffer) throws IOException;
 
     /**
      * Sets blocking mode for the transport.
@@ -95,6 +122,16 @@ public interface Transport extends AutoCloseable {
      */
     boolean isBlocking();
 
+    /**
+     * Sets the IP don't-fragment bit on outgoing datagrams, for path MTU discovery.
+     *
+     * @param enabled true to set the bit
+     * @return false if the transport does not support the option
+     */
+    default boolean setDontFragment(boolean enabled) {
+        return false;
+    }
+
     /**
      * Sets the receive timeout in milliseconds.
      * Set to 0 for infinite timeout.
@@ -118,18 +155,4 @@ public interface Transport extends AutoCloseable {
      */
     @Override
     void close() throws IOException;
-
-    /**
-     * Container for received data with source address.
-     */
-    record ReceivedData(byte[] data, SocketAddress source) {
-        /**
-         * Returns the length of the received data.
-         *
-         * @return the data length
-         */
-        public int length() {
-            return data.length;
-        }
-    }
 }
@@ -6,7 +6,7 @@ import java.net.DatagramSocket;
 import java.net.InetSocketAddress;
 import java.net.SocketAddress;
 import java.net.SocketException;
-import java.net.SocketTimeoutException;
+import java.nio.ByteBuffer;
 import java.nio.channels.DatagramChannel;
 
 /**
@@ -20,7 +20,6 @@ public class UdpTransport implements Transport {
     private final DatagramChannel channel;
     private final DatagramSocket socket;
     private final ByteBufferPool bufferPool;
-    private final NeonConfig config;
 
     /**
      * Creates a UDP transport with default configuration.
@@ -38,7 +37,9 @@ public class UdpTransport implements Transport {
      * @throws IOException if creation fails
      */
     public UdpTransport(NeonConfig config) throws IOException {
-        this.config = config;
+        if (config == null) {
+            throw new IllegalArgumentException("config cannot be null");
+        }
         this.channel = DatagramChannel.open();
         this.socket = channel.socket();
         this.bufferPool = new ByteBufferPool(
@@ -48,6 +49,26 @@ public class UdpTransport implements Transport {
         );
     }
 
+    /**
+     * Creates a UDP transport bound to the specified port, closing it again if binding fails.
+     *
+     * @param port the port to bind to, or 0 for any available port
+     * @param config the configuration
+     * @return the bound transport
+     * @throws IOException if creation or binding fails
+     * @since 1.3
+     */
+    public static UdpTransport bound(int port, NeonConfig config) throws IOException {
+        UdpTransport transport = new UdpTransport(config);
+        try {
+            transport.bind(port);
+        } catch (IOException e) {
+            transport.close();
+            throw e;
+        }
+        return transport;
+    }
+
     @Override
     public Type getType() {
         return Type.UDP;
@@ -65,38 +86,49 @@ public class UdpTransport implements Transport {
     }
 
     @Override
-    public void send(byte[] data, SocketAddress address) throws IOException {
-        DatagramPacket packet = new DatagramPacket(data, data.length, address);
-        socket.send(packet);
+    public void send(ByteBuffer data, SocketAddress address) throws IOException {
+        channel.send(data, address);
     }
 
+    /**
+     * {@inheritDoc}
+     *
+     * <p>In blocking mode the receive goes through the channel's socket adaptor, since
+     * only the adaptor honours the {@link #setTimeout receive timeout}.
+     */
     @Override
-    public ReceivedData receive() throws IOException {
-        byte[] buffer = bufferPool.acquire();
-        DatagramPacket datagram = new DatagramPacket(buffer, buffer.length);
+    public SocketAddress receive(ByteBuffer buffer) throws IOException {
+        if (!channel.isBlocking()) {
+            return channel.receive(buffer);
+        }
 
+        boolean heap = buffer.hasArray();
+        byte[] array = heap ? buffer.array() : bufferPool.acquire();
         try {
+            int offset = heap ? buffer.arrayOffset() + buffer.position() : 0;
+            int capacity = heap ? buffer.remaining() : Math.min(array.length, buffer.remaining());
+            DatagramPacket datagram = new DatagramPacket(array, offset, capacity);
             socket.receive(datagram);
-            int length = datagram.getLength();
-
-            if (config.isEnforceBufferSize() && length == buffer.length) {
-                bufferPool.release(buffer);
-                return null;
+            if (heap) {
+                buffer.position(buffer.position() + datagram.getLength());
+            } else {
+                buffer.put(array, 0, datagram.getLength());
             }
-
-            byte[] data = new byte[length];
-            System.arraycopy(buffer, 0, data, 0, length);
-            bufferPool.release(buffer);
-            return new ReceivedData(data, datagram.getSocketAddress());
-        } catch (SocketTimeoutException e) {
-            bufferPool.release(buffer);
-            throw e;
-        } catch (IOException e) {
-            bufferPool.release(buffer);
-            if (!channel.isBlocking()) {
-                return null;
+            return datagram.getSocketAddress();
+        } finally {
+            if (!heap) {
+                bufferPool.release(array);
             }
-            throw e;
+        }
+    }
+
+    @Override
+    public boolean setDontFragment(boolean enabled) {
+        try {
+            channel.setOption(jdk.net.ExtendedSocketOptions.IP_DONTFRAGMENT, enabled);
+            return true;
+        } catch (UnsupportedOperationException | IOException e) {
+            return false;
         }
     }
 
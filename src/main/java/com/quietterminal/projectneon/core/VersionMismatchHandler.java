@@ -198,6 +198,24 @@ public final class VersionMismatchHandler {
         validate(header.version());
     }
 
+    /**
+     * Negotiates the protocol version to use with a peer.
+     *
+     * <p>Picks the lower of the peer's highest supported version and this handler's
+     * maximum (the current version in strict mode), then checks it as usual. A peer
+     * advertising version 2 therefore gets version 1 from a handler that only supports
+     * version 1, while older peers keep working against a handler that accepts both.
+     *
+     * @param peerMaxVersion the highest version the peer supports
+     * @return the negotiated version, or empty if no common version is acceptable
+     * @since 1.3
+     */
+    public Optional<Byte> negotiate(byte peerMaxVersion) {
+        int localMax = (strictMode ? currentVersion : maxCompatibleVersion) & 0xFF;
+        byte chosen = (byte) Math.min(peerMaxVersion & 0xFF, localMax);
+        return check(chosen).isAccepted() ? Optional.of(chosen) : Optional.empty();
+    }
+
     private SuggestedAction determineSuggestedAction(byte receivedVersion) {
         int received = receivedVersion & 0xFF;
         int current = currentVersion & 0xFF;
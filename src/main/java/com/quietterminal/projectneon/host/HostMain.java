@@ -1,13 +1,18 @@
 package com.quietterminal.projectneon.host;
 
+import com.quietterminal.projectneon.core.NeonConfig;
+import com.quietterminal.projectneon.core.SharedMemoryTransport;
 import com.quietterminal.projectneon.util.LoggerConfig;
 
+import java.nio.file.Path;
 import java.util.Random;
 import java.util.logging.Level;
 import java.util.logging.Logger;
 
 /**
  * CLI entry point for the Neon host.
+ * Usage: {@code neon-host [sessionId] [relayAddr] [shmFile]}, where {@code shmFile} is the
+ * file of a relay started with {@code --shm} on the same machine.
  * This class is internal and not part of the public API.
  */
 class HostMain {
@@ -29,7 +34,7 @@ class HostMain {
                     sessionId = Integer.parseInt(args[0]);
                 } catch (NumberFormatException e) {
                     logger.log(Level.SEVERE, "Invalid session ID argument: {0}", args[0]);
-                    System.err.println("Invalid session ID. Usage: java -jar neon-host.jar [sessionId] [relayAddr]");
+                    System.err.println("Invalid session ID. Usage: java -jar neon-host.jar [sessionId] [relayAddr] [shmFile]");
                     return;
                 }
             } else {
@@ -38,8 +43,11 @@ class HostMain {
             }
 
             String relayAddr = args.length > 1 ? args[1] : "127.0.0.1:7777";
+            String sharedMemoryFile = args.length > 2 ? args[2] : null;
 
-            try (NeonHost host = new NeonHost(sessionId, relayAddr)) {
+            try (NeonHost host = sharedMemoryFile != null
+                    ? new NeonHost(sessionId, relayAddr, new NeonConfig(), SharedMemoryTransport.open(Path.of(sharedMemoryFile)))
+                    : new NeonHost(sessionId, relayAddr)) {
                 host.setClientConnectCallback((clientId, name, session) ->
                     System.out.println("Client connected: " + name +
                         " (ID: " + (clientId & 0xFF) + ", Session: " + session + ")")
@@ -61,6 +69,9 @@ class HostMain {
 
                 System.out.println("Starting host on session " + sessionId);
                 System.out.println("Relay address: " + relayAddr);
+                if (sharedMemoryFile != null) {
+                    System.out.println("Shared-memory file: " + sharedMemoryFile);
+                }
                 System.out.println("\nHost running. Waiting for clients...");
                 System.out.println("Press Ctrl+C to exit.\n");
 
@@ -9,6 +9,7 @@ import java.net.InetSocketAddress;
 import java.net.SocketAddress;
 import java.util.*;
 import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicInteger;
 import java.util.concurrent.atomic.AtomicReference;
 import java.util.function.BiConsumer;
 import java.util.function.Consumer;
@@ -35,21 +36,27 @@ public class NeonHost implements AutoCloseable, Lifecycle {
     private final NeonConfig config;
     private final int sessionId;
     private SocketAddress relayAddr;
-    private byte nextClientId = FIRST_CLIENT_ID;
-    private short nextSequence = 0;
+    private int nextClientId = FIRST_CLIENT_ID;
+    private final boolean[] issuedClientIds = new boolean[256];
+    private final AtomicInteger nextSequence = new AtomicInteger();
 
     private final Map<Byte, String> connectedClients = new ConcurrentHashMap<>();
     private final AckStateMachine ackStateMachine;
+    private final VersionMismatchHandler versionHandler;
     private final Map<Short, Byte> sequenceToClient = new ConcurrentHashMap<>();
     private final Map<Byte, Long> clientTokens = new ConcurrentHashMap<>();
     private final Map<Byte, DisconnectedClient> disconnectedClients = new ConcurrentHashMap<>();
     private final java.security.SecureRandom secureRandom = new java.security.SecureRandom();
+    private final SessionTokenSigner tokenSigner;
+    private final SessionCipher.Suite cipherSuite;
+    private final byte[] sessionSecret;
 
     private TriConsumer<Byte, String, Integer> clientConnectCallback;
     private BiConsumer<String, String> clientDenyCallback;
     private Consumer<Byte> pingReceivedCallback;
     private BiConsumer<Byte, Byte> unhandledPacketCallback;
     private Consumer<Byte> clientDisconnectCallback;
+    private volatile GameMessageRings messageRings;
 
     private final AtomicReference<Lifecycle.State> lifecycleState = new AtomicReference<>(Lifecycle.State.CREATED);
     private final List<Lifecycle.StateChangeListener> stateChangeListeners = new java.util.concurrent.CopyOnWriteArrayList<>();
@@ -66,6 +73,17 @@ public class NeonHost implements AutoCloseable, Lifecycle {
      * Creates a host with custom configuration.
      */
     public NeonHost(int sessionId, String relayAddress, NeonConfig config) throws IOException {
+        this(sessionId, relayAddress, config, null);
+    }
+
+    /**
+     * Creates a host that reaches the relay over the given bound transport, which it takes
+     * ownership of and closes on close().
+     *
+     * @param transport the transport, or null to open a UDP socket on an ephemeral port
+     * @since 1.3
+     */
+    public NeonHost(int sessionId, String relayAddress, NeonConfig config, Transport transport) throws IOException {
         if (sessionId <= 0) {
             throw new IllegalArgumentException("Session ID must be a positive integer, got: " + sessionId);
         }
@@ -76,10 +94,22 @@ public class NeonHost implements AutoCloseable, Lifecycle {
 
         this.sessionId = sessionId;
         this.config = config;
-        this.socket = new NeonSocket(config);
+        this.socket = transport != null ? new NeonSocket(transport, config) : new NeonSocket(config);
         this.socket.setBlocking(true);
         this.socket.setSoTimeout(config.getHostSocketTimeoutMs());
         this.ackStateMachine = AckStateMachine.fromConfig(config, true);
+        byte maxHeaderVersion = (byte) config.getMaxHeaderVersion();
+        this.versionHandler = VersionMismatchHandler.lenient(PacketHeader.VERSION, maxHeaderVersion)
+            .currentVersion(maxHeaderVersion);
+        this.tokenSigner = SessionTokenSigner.fromConfig(config);
+        this.cipherSuite = SessionCipher.Suite.fromConfigName(config.getSessionEncryption());
+        if (cipherSuite != null) {
+            this.sessionSecret = new byte[KeyExchange.SECRET_LENGTH];
+            secureRandom.nextBytes(sessionSecret);
+            this.socket.setSessionCipher(new SessionCipher(cipherSuite, sessionSecret));
+        } else {
+            this.sessionSecret = null;
+        }
 
         String[] parts = relayAddress.split(":");
         if (parts.length != 2) {
@@ -176,7 +206,7 @@ public class NeonHost implements AutoCloseable, Lifecycle {
             HOST_CLIENT_ID, sessionId, hostToken
         );
         NeonPacket packet = NeonPacket.create(
-            PacketType.CONNECT_ACCEPT, nextSequence++, HOST_CLIENT_ID, (byte) 0, registration
+            PacketType.CONNECT_ACCEPT, nextSequence(), HOST_CLIENT_ID, (byte) 0, registration
         );
         socket.sendPacket(packet, relayAddr);
 
@@ -241,6 +271,11 @@ public class NeonHost implements AutoCloseable, Lifecycle {
      * Processes incoming packets. Returns the number of packets processed.
      */
     public int processPackets() throws IOException {
+        GameMessageRings rings = messageRings;
+        if (rings != null) {
+            rings.drainOutgoing(this::sendGamePacket);
+        }
+
         int count = 0;
         while (true) {
             try {
@@ -262,12 +297,18 @@ public class NeonHost implements AutoCloseable, Lifecycle {
         switch (packet.payload()) {
             case PacketPayload.ConnectRequest request -> handleConnectRequest(request, header);
             case PacketPayload.ReconnectRequest request -> handleReconnectRequest(request, header);
+            case PacketPayload.ConnectAccept accept -> handleTokenRotation(accept);
             case PacketPayload.Ping ping -> {
                 if (pingReceivedCallback != null) {
                     pingReceivedCallback.accept(header.clientId());
                 }
                 sendPong(ping.timestamp(), header.clientId());
             }
+            case PacketPayload.MtuProbe probe -> {
+                if (header.packetType() == PacketType.PING.getValue()) {
+                    echoMtuProbe(probe, packet, header.clientId());
+                }
+            }
             case PacketPayload.Ack ack -> {
                 for (Short seq : ack.acknowledgedSequences()) {
                     if (ackStateMachine.acknowledge(seq)) {
@@ -298,6 +339,10 @@ public class NeonHost implements AutoCloseable, Lifecycle {
                     new Object[]{disconnectedClientId, sessionId});
             }
             default -> {
+                GameMessageRings rings = messageRings;
+                if (rings != null) {
+                    rings.deliver(header.packetType(), header.clientId(), packet.payload().toBytes());
+                }
                 if (unhandledPacketCallback != null) {
                     unhandledPacketCallback.accept(header.packetType(), header.clientId());
                 }
@@ -316,15 +361,56 @@ public class NeonHost implements AutoCloseable, Lifecycle {
             return;
         }
 
-        byte assignedId = nextClientId++;
+        Optional<Byte> headerVersion = versionHandler.negotiate(request.clientVersion());
+        if (headerVersion.isEmpty()) {
+            String reason = VersionMismatchHandler.createDenyPayload(
+                versionHandler.check(request.clientVersion())).reason();
+            sendConnectDeny(clientName, reason);
+            if (clientDenyCallback != null) {
+                clientDenyCallback.accept(clientName, reason);
+            }
+            return;
+        }
+
+        if (cipherSuite != null && request.keyShare().length != KeyExchange.PUBLIC_KEY_LENGTH) {
+            sendConnectDeny(clientName, "Encryption required");
+            if (clientDenyCallback != null) {
+                clientDenyCallback.accept(clientName, "Encryption required");
+            }
+            return;
+        }
+
+        int allocated = allocateClientId();
+        if (allocated < 0) {
+            sendConnectDeny(clientName, "No client ids left");
+            if (clientDenyCallback != null) {
+                clientDenyCallback.accept(clientName, "No client ids left");
+            }
+            return;
+        }
+        byte assignedId = (byte) allocated;
+        byte[] keyShare = PacketPayload.NO_KEY_SHARE;
+        if (cipherSuite != null) {
+            try {
+                keyShare = new KeyExchange().acceptShare(request.keyShare(), cipherSuite, sessionSecret, sessionId, assignedId);
+            } catch (IllegalArgumentException e) {
+                sendConnectDeny(clientName, "Invalid key share");
+                return;
+            }
+        }
+        issuedClientIds[allocated] = true;
+        SessionCipher cipher = socket.getSessionCipher();
+        if (cipher != null) {
+            cipher.resetSender(assignedId);
+        }
         connectedClients.put(assignedId, clientName);
 
-        long clientToken = secureRandom.nextLong();
+        long clientToken = newToken(assignedId);
         clientTokens.put(assignedId, clientToken);
 
-        PacketPayload.ConnectAccept accept = new PacketPayload.ConnectAccept(assignedId, sessionId, clientToken);
+        PacketPayload.ConnectAccept accept = new PacketPayload.ConnectAccept(assignedId, sessionId, clientToken, keyShare);
         NeonPacket acceptPacket = NeonPacket.create(
-            PacketType.CONNECT_ACCEPT, nextSequence++, HOST_CLIENT_ID, (byte) 0, accept
+            PacketType.CONNECT_ACCEPT, nextSequence(), HOST_CLIENT_ID, (byte) 0, accept
         );
         socket.sendPacket(acceptPacket, relayAddr);
 
@@ -338,9 +424,10 @@ public class NeonHost implements AutoCloseable, Lifecycle {
             Thread.currentThread().interrupt();
         }
 
-        short seq = nextSequence++;
+        short seq = nextSequence();
+        byte sessionFlags = config.isPacketChecksumEnabled() ? PacketPayload.SessionConfig.FLAG_CHECKSUM : 0;
         PacketPayload.SessionConfig sessionConfig = new PacketPayload.SessionConfig(
-            PacketHeader.VERSION, (short) 60, (short) 1024
+            headerVersion.get(), (short) 60, (short) 1024, sessionFlags
         );
         NeonPacket configPacket = NeonPacket.create(
             PacketType.SESSION_CONFIG, seq, HOST_CLIENT_ID, assignedId, sessionConfig
@@ -352,7 +439,7 @@ public class NeonHost implements AutoCloseable, Lifecycle {
 
         PacketPayload.PacketTypeRegistry registry = new PacketPayload.PacketTypeRegistry(List.of());
         NeonPacket registryPacket = NeonPacket.create(
-            PacketType.PACKET_TYPE_REGISTRY, nextSequence++, HOST_CLIENT_ID, assignedId, registry
+            PacketType.PACKET_TYPE_REGISTRY, nextSequence(), HOST_CLIENT_ID, assignedId, registry
         );
         socket.sendPacket(registryPacket, relayAddr);
     }
@@ -389,12 +476,12 @@ public class NeonHost implements AutoCloseable, Lifecycle {
         clientTokens.put(clientId, providedToken);
         disconnectedClients.remove(clientId);
 
-        long newToken = secureRandom.nextLong();
+        long newToken = newToken(clientId);
         clientTokens.put(clientId, newToken);
 
         PacketPayload.ConnectAccept accept = new PacketPayload.ConnectAccept(clientId, sessionId, newToken);
         NeonPacket acceptPacket = NeonPacket.create(
-            PacketType.CONNECT_ACCEPT, nextSequence++, HOST_CLIENT_ID, clientId, accept
+            PacketType.CONNECT_ACCEPT, nextSequence(), HOST_CLIENT_ID, clientId, accept
         );
         socket.sendPacket(acceptPacket, relayAddr);
 
@@ -406,22 +493,138 @@ public class NeonHost implements AutoCloseable, Lifecycle {
             new Object[]{clientId, sessionId});
     }
 
+    /**
+     * Records a token the relay issued when it rebound a connected client on its own, so a
+     * later reconnect through the host accepts the client's current token.
+     */
+    private void handleTokenRotation(PacketPayload.ConnectAccept accept) {
+        byte clientId = accept.assignedClientId();
+        if (tokenSigner == null || accept.sessionId() != sessionId || !connectedClients.containsKey(clientId)
+                || !tokenSigner.verify(accept.sessionToken(), sessionId, clientId)) {
+            logger.log(Level.FINE, "Ignoring token update for client {0} [SessionID={1}]",
+                new Object[]{clientId, sessionId});
+            return;
+        }
+        clientTokens.put(clientId, accept.sessionToken());
+    }
+
+    /**
+     * Issues a session token. With a shared key configured the token is signed, so the
+     * relay can validate reconnects without asking the host.
+     */
+    private long newToken(byte clientId) {
+        return tokenSigner != null ? tokenSigner.issue(sessionId, clientId) : secureRandom.nextLong();
+    }
+
+    /**
+     * Takes the next packet sequence number. Atomic because game packets may be sent from
+     * engine threads while the processing thread sends protocol packets.
+     */
+    private short nextSequence() {
+        return (short) nextSequence.getAndIncrement();
+    }
+
+    /**
+     * Picks a free client id, starting after the last one handed out, or returns -1 when none
+     * is left. Ids of connected clients and ids reserved for a reconnect are skipped. In an
+     * encrypted session an id is never handed out twice: every member derives a sender's key
+     * from the session secret and its id alone, so a second client under the same id would
+     * restart the nonce counter under the first client's key.
+     */
+    private int allocateClientId() {
+        long now = System.currentTimeMillis();
+        int range = 256 - FIRST_CLIENT_ID;
+        for (int i = 0; i < range; i++) {
+            int candidate = FIRST_CLIENT_ID + (nextClientId - FIRST_CLIENT_ID + i) % range;
+            byte id = (byte) candidate;
+            if ((cipherSuite != null && issuedClientIds[candidate]) || connectedClients.containsKey(id)) {
+                continue;
+            }
+            DisconnectedClient reserved = disconnectedClients.get(id);
+            if (reserved != null) {
+                if (now - reserved.disconnectTime() <= config.getHostSessionTokenTimeoutMs()) {
+                    continue;
+                }
+                disconnectedClients.remove(id);
+            }
+            nextClientId = candidate + 1;
+            return candidate;
+        }
+        return -1;
+    }
+
     private void sendConnectDeny(String clientName, String reason) throws IOException {
         PacketPayload.ConnectDeny deny = new PacketPayload.ConnectDeny(reason);
         NeonPacket packet = NeonPacket.create(
-            PacketType.CONNECT_DENY, nextSequence++, HOST_CLIENT_ID, (byte) 0, deny
+            PacketType.CONNECT_DENY, nextSequence(), HOST_CLIENT_ID, (byte) 0, deny
         );
         socket.sendPacket(packet, relayAddr);
     }
 
+    /**
+     * Sends a game packet to a client, or to every client when {@code destinationId} is 0.
+     * Safe to call from any thread.
+     *
+     * @param packetType a game packet type, {@code 0x10} or above
+     */
+    public void sendGamePacket(byte packetType, byte destinationId, byte[] payload) throws IOException {
+        if (payload == null) {
+            throw new IllegalArgumentException("payload cannot be null");
+        }
+        sendGamePacket(packetType, destinationId, payload, 0, payload.length);
+    }
+
+    /**
+     * Sends {@code length} bytes of {@code buffer} starting at {@code offset} as a game packet.
+     * The bytes are copied straight into the outgoing datagram.
+     */
+    public void sendGamePacket(byte packetType, byte destinationId, byte[] buffer, int offset, int length) throws IOException {
+        if ((packetType & 0xFF) < PacketType.GAME_PACKET.getValue()) {
+            throw new IllegalArgumentException("Game packet types start at 0x10, got: " + packetType);
+        }
+        PacketHeader header = PacketHeader.create(packetType, nextSequence(), HOST_CLIENT_ID, destinationId);
+        socket.sendEncoded(NeonPacket.encode(header, null, buffer, offset, length), relayAddr);
+    }
+
+    /**
+     * Attaches rings through which an engine sends and receives game packets without a call
+     * per message. Outgoing messages are sent from {@link #processPackets()}; every received
+     * game packet is appended to the incoming ring in addition to the unhandled packet callback.
+     *
+     * @param rings the rings, or null to detach
+     */
+    public void setMessageRings(GameMessageRings rings) {
+        this.messageRings = rings;
+    }
+
     private void sendPong(long originalTimestamp, byte destinationId) throws IOException {
         PacketPayload.Pong pong = new PacketPayload.Pong(originalTimestamp);
         NeonPacket packet = NeonPacket.create(
-            PacketType.PONG, nextSequence++, HOST_CLIENT_ID, destinationId, pong
+            PacketType.PONG, nextSequence(), HOST_CLIENT_ID, destinationId, pong
         );
         socket.sendPacket(packet, relayAddr);
     }
 
+    /**
+     * Echoes a path MTU probe as a PONG of the same datagram size, so the probe only counts
+     * as confirmed once the return path has carried it too. Probes are transport traffic
+     * and do not reach the ping callback.
+     */
+    private void echoMtuProbe(PacketPayload.MtuProbe probe, NeonPacket received, byte destinationId) throws IOException {
+        int receivedHeaderSize = received.isV2() ? received.headerV2().encodedSize() : PacketHeader.HEADER_SIZE;
+        PacketPayload.MtuProbe echo = new PacketPayload.MtuProbe(probe.probeId(),
+            probe.padding() + receivedHeaderSize - PacketHeader.HEADER_SIZE);
+        NeonPacket packet = NeonPacket.create(
+            PacketType.PONG, nextSequence(), HOST_CLIENT_ID, destinationId, echo
+        );
+        try {
+            socket.sendPacket(packet, relayAddr);
+        } catch (java.net.SocketException e) {
+            logger.log(Level.FINE, "Path MTU probe echo of {0} bytes could not be sent: {1}",
+                new Object[]{echo.padding() + 8, e.getMessage()});
+        }
+    }
+
     private void checkPendingAcks() throws IOException {
         AckStateMachine.ProcessResult result = ackStateMachine.process();
 
@@ -479,7 +682,7 @@ public class NeonHost implements AutoCloseable, Lifecycle {
             try {
                 PacketPayload.DisconnectNotice notice = new PacketPayload.DisconnectNotice();
                 NeonPacket packet = NeonPacket.create(
-                    PacketType.DISCONNECT_NOTICE, nextSequence++, HOST_CLIENT_ID, (byte) 0, notice
+                    PacketType.DISCONNECT_NOTICE, nextSequence(), HOST_CLIENT_ID, (byte) 0, notice
                 );
                 socket.sendPacket(packet, relayAddr);
             } catch (IOException e) {
@@ -0,0 +1,146 @@
+package com.quietterminal.projectneon.jni;
+
+import com.quietterminal.projectneon.client.NeonClient;
+import com.quietterminal.projectneon.core.PacketPayload;
+import com.quietterminal.projectneon.core.SpscByteRing;
+import com.quietterminal.projectneon.host.NeonHost;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
+
+/**
+ * Queues client and host events as compact records in a ring shared with native code,
+ * so the native layer can drain a whole frame's events at once instead of taking an
+ * upcall per event.
+ *
+ * <p>Each record is an event type byte followed by its fields in native byte order;
+ * strings are UTF-8, NUL-terminated and truncated to {@link #MAX_STRING_BYTES}. The
+ * layout is decoded by {@code decode_event} in {@code neon_jni.c}. Events that do not fit
+ * in the ring are dropped.
+ *
+ * <p>Events are produced on whichever thread calls {@code processPackets()}, which must
+ * be one thread at a time.
+ *
+ * @since 1.3
+ */
+final class NativeEventQueue {
+
+    static final byte PONG = 1;
+    static final byte SESSION_CONFIG = 2;
+    static final byte PACKET_TYPE = 3;
+    static final byte UNHANDLED_PACKET = 4;
+    static final byte WRONG_DESTINATION = 5;
+    static final byte DISCONNECT = 6;
+    static final byte CLIENT_CONNECT = 7;
+    static final byte CLIENT_DENY = 8;
+    static final byte PING_RECEIVED = 9;
+    static final byte CLIENT_DISCONNECT = 10;
+
+    /**
+     * Longest string carried in an event, in UTF-8 bytes excluding the terminator.
+     */
+    static final int MAX_STRING_BYTES = 255;
+
+    private final SpscByteRing ring;
+    private final byte[] scratch = new byte[1 + 8 + 2 * (MAX_STRING_BYTES + 1)];
+    private final ByteBuffer record = ByteBuffer.wrap(scratch).order(ByteOrder.nativeOrder());
+    private long dropped;
+
+    NativeEventQueue(SpscByteRing ring) {
+        if (ring.maxRecordLength() < scratch.length) {
+            throw new IllegalArgumentException("Event ring too small: " + ring.capacity());
+        }
+        this.ring = ring;
+    }
+
+    /**
+     * Routes a client's callbacks into a native event ring. Called from native code when
+     * the client handle is created.
+     */
+    static NativeEventQueue attach(NeonClient client, ByteBuffer buffer) {
+        NativeEventQueue queue = new NativeEventQueue(new SpscByteRing(buffer));
+        client.setPongCallback((responseTime, timestamp) ->
+            queue.begin(PONG).putLong(responseTime).putLong(timestamp).flush());
+        client.setSessionConfigCallback((version, tickRate, maxPacketSize) ->
+            queue.begin(SESSION_CONFIG).put(version).putShort(tickRate).putShort(maxPacketSize).flush());
+        client.setPacketTypeRegistryCallback(registry -> {
+            for (PacketPayload.PacketTypeEntry entry : registry.entries()) {
+                queue.begin(PACKET_TYPE).put(entry.packetId()).putString(entry.name())
+                    .putString(entry.description()).flush();
+            }
+        });
+        client.setUnhandledPacketCallback((packetType, from) ->
+            queue.begin(UNHANDLED_PACKET).put(packetType).put(from).flush());
+        client.setWrongDestinationCallback((myId, destination) ->
+            queue.begin(WRONG_DESTINATION).put(myId).put(destination).flush());
+        client.setDisconnectCallback(clientId -> queue.begin(DISCONNECT).put(clientId).flush());
+        return queue;
+    }
+
+    /**
+     * Routes a host's callbacks into a native event ring. Called from native code when
+     * the host handle is created.
+     */
+    static NativeEventQueue attach(NeonHost host, ByteBuffer buffer) {
+        NativeEventQueue queue = new NativeEventQueue(new SpscByteRing(buffer));
+        host.setClientConnectCallback((clientId, name, sessionId) ->
+            queue.begin(CLIENT_CONNECT).put(clientId).putInt(sessionId).putString(name).flush());
+        host.setClientDenyCallback((name, reason) ->
+            queue.begin(CLIENT_DENY).putString(name).putString(reason).flush());
+        host.setPingReceivedCallback(from -> queue.begin(PING_RECEIVED).put(from).flush());
+        host.setUnhandledPacketCallback((packetType, from) ->
+            queue.begin(UNHANDLED_PACKET).put(packetType).put(from).flush());
+        host.setClientDisconnectCallback(clientId -> queue.begin(CLIENT_DISCONNECT).put(clientId).flush());
+        return queue;
+    }
+
+    /**
+     * Gets the number of events dropped because the ring was full.
+     */
+    long getDroppedCount() {
+        return dropped;
+    }
+
+    private NativeEventQueue begin(byte type) {
+        record.clear();
+        record.put(type);
+        return this;
+    }
+
+    private NativeEventQueue put(byte value) {
+        record.put(value);
+        return this;
+    }
+
+    private NativeEventQueue putShort(short value) {
+        record.putShort(value);
+        return this;
+    }
+
+    private NativeEventQueue putInt(int value) {
+        record.putInt(value);
+        return this;
+    }
+
+    private NativeEventQueue putLong(long value) {
+        record.putLong(value);
+        return this;
+    }
+
+    private NativeEventQueue putString(String value) {
+        byte[] bytes = (value != null ? value : "").getBytes(StandardCharsets.UTF_8);
+        int length = Math.min(bytes.length, MAX_STRING_BYTES);
+        while (length < bytes.length && length > 0 && (bytes[length] & 0xC0) == 0x80) {
+            length--;
+        }
+        record.put(bytes, 0, length).put((byte) 0);
+        return this;
+    }
+
+    private void flush() {
+        if (!ring.offer(scratch, 0, record.position())) {
+            dropped++;
+        }
+    }
+}
@@ -1,7 +1,12 @@
 package com.quietterminal.projectneon.jni;
 
+import com.quietterminal.projectneon.client.NeonClient;
+import com.quietterminal.projectneon.core.GameMessageRings;
+import com.quietterminal.projectneon.core.SpscByteRing;
 import com.quietterminal.projectneon.util.LoggerConfig;
 
+import java.nio.ByteBuffer;
+import java.util.Optional;
 import java.util.logging.Level;
 import java.util.logging.Logger;
 
@@ -19,9 +24,22 @@ public class NeonClientJNI {
         LoggerConfig.configureLogger(logger);
     }
 
+    /**
+     * Set by {@code neon_runtime_init} when native code created the JVM. The library is
+     * then already part of the process, and loading it again from
+     * {@code java.library.path} could bring in a second copy with its own state.
+     */
+    static final String EMBEDDED_PROPERTY = "neon.jni.embedded";
+
+    private static final long STATE_HAS_ID = 1L << 8;
+    private static final long STATE_HAS_SESSION = 1L << 9;
+    private static final long STATE_CONNECTED = 1L << 10;
+
     static {
         try {
-            System.loadLibrary("neon_jni");
+            if (!Boolean.getBoolean(EMBEDDED_PROPERTY)) {
+                System.loadLibrary("neon_jni");
+            }
         } catch (UnsatisfiedLinkError e) {
             logger.log(Level.SEVERE, "Failed to load neon_jni library", e);
             System.err.println("Failed to load neon_jni library: " + e.getMessage());
@@ -121,6 +139,14 @@ public class NeonClientJNI {
      */
     public static native void neonClientSetWrongDestinationCallback(long clientPtr, long callback);
 
+    /**
+     * Allocates native game message rings and attaches them to the client.
+     * @param clientPtr Pointer to NeonClient
+     * @param ringCapacity Bytes per ring, rounded up to a power of two
+     * @return true if messaging was enabled, false otherwise
+     */
+    public static native boolean neonClientEnableMessaging(long clientPtr, int ringCapacity);
+
     /**
      * Frees the NeonClient instance.
      * @param clientPtr Pointer to NeonClient
@@ -132,4 +158,36 @@ public class NeonClientJNI {
      * @return Error message string, or null if no error
      */
     public static native String neonGetLastError();
+
+    /**
+     * Packs a client's connection state into one value. Called from native code after
+     * connect and processPackets so the native getters can answer from a cached copy
+     * without a JNI call of their own.
+     *
+     * <p>Bits 0-7 hold the client ID, bit 8 is set if a client ID is assigned, bit 9 if a
+     * session ID is known, bit 10 if connected, and bits 32-63 hold the session ID.
+     */
+    static long packState(NeonClient client) {
+        long state = 0;
+        Optional<Byte> clientId = client.getClientId();
+        if (clientId.isPresent()) {
+            state |= (clientId.get() & 0xFFL) | STATE_HAS_ID;
+        }
+        Optional<Integer> sessionId = client.getSessionId();
+        if (sessionId.isPresent()) {
+            state |= ((long) sessionId.get() << 32) | STATE_HAS_SESSION;
+        }
+        if (client.isConnected()) {
+            state |= STATE_CONNECTED;
+        }
+        return state;
+    }
+
+    /**
+     * Wraps native ring memory for a client or host. Called from native code once when
+     * messaging is enabled; the buffers stay owned by the native handle.
+     */
+    static GameMessageRings wrapMessageRings(ByteBuffer outgoing, ByteBuffer incoming) {
+        return new GameMessageRings(new SpscByteRing(outgoing), new SpscByteRing(incoming));
+    }
 }
@@ -18,7 +18,9 @@ public class NeonHostJNI {
 
     static {
         try {
-            System.loadLibrary("neon_jni");
+            if (!Boolean.getBoolean(NeonClientJNI.EMBEDDED_PROPERTY)) {
+                System.loadLibrary("neon_jni");
+            }
         } catch (UnsatisfiedLinkError e) {
             logger.log(Level.SEVERE, "Failed to load neon_jni library", e);
             System.err.println("Failed to load neon_jni library: " + e.getMessage());
@@ -89,6 +91,14 @@ public class NeonHostJNI {
      */
     public static native void neonHostSetUnhandledPacketCallback(long hostPtr, long callback);
 
+    /**
+     * Allocates native game message rings and attaches them to the host.
+     * @param hostPtr Pointer to NeonHost
+     * @param ringCapacity Bytes per ring, rounded up to a power of two
+     * @return true if messaging was enabled, false otherwise
+     */
+    public static native boolean neonHostEnableMessaging(long hostPtr, int ringCapacity);
+
     /**
      * Frees the NeonHost instance.
      * @param hostPtr Pointer to NeonHost
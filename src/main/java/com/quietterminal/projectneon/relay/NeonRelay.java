@@ -4,6 +4,7 @@ import com.quietterminal.projectneon.core.*;
 import com.quietterminal.projectneon.util.LoggerConfig;
 
 import java.io.IOException;
+import java.net.InetSocketAddress;
 import java.net.SocketAddress;
 import java.time.Instant;
 import java.util.*;
@@ -26,12 +27,24 @@ public class NeonRelay implements AutoCloseable, Lifecycle {
         LoggerConfig.configureLogger(logger);
     }
 
+    /** How long a path challenge stays answerable. */
+    private static final long PATH_CHALLENGE_TIMEOUT_MS = 5000;
+    /** Minimum interval between challenges to the same candidate address. */
+    private static final long PATH_CHALLENGE_RETRY_MS = 500;
+
     private final NeonSocket socket;
     private final SessionManager sessionManager;
     private final Map<SocketAddress, PendingConnection> pendingConnections;
     private final Map<SocketAddress, RateLimiter> rateLimiters;
+    private final Map<Long, RateLimiter> connectionLimiters;
+    private final Map<Long, PathChallenge> pathChallenges;
+    private final Map<Long, Long> currentTokens;
+    private final RateLimiter[] slotLimiters;
     private final NeonConfig config;
     private final RelaySemantics relaySemantics;
+    private final RetryCookie retryCookies;
+    private final SessionTokenSigner tokenSigner;
+    private final java.security.SecureRandom challengeSource = new java.security.SecureRandom();
     private long lastCleanupTime;
 
     private final AtomicReference<Lifecycle.State> lifecycleState = new AtomicReference<>(Lifecycle.State.CREATED);
@@ -49,33 +62,70 @@ public class NeonRelay implements AutoCloseable, Lifecycle {
      * Creates a relay with custom configuration.
      */
     public NeonRelay(String bindAddress, NeonConfig config) throws IOException {
+        this(bindUdp(bindAddress, config), config);
+    }
+
+    /**
+     * Creates a relay that serves peers over the given bound transport instead of its own
+     * UDP socket. The relay takes ownership of the transport and closes it on close().
+     *
+     * @since 1.3
+     */
+    public NeonRelay(Transport transport, NeonConfig config) throws IOException {
         if (config == null) {
             throw new IllegalArgumentException("config cannot be null");
         }
         config.validate();
 
         this.config = config;
-
-        String[] parts = bindAddress.split(":");
-        int port = parts.length == 2 ? Integer.parseInt(parts[1]) : config.getRelayPort();
-
-        this.socket = new NeonSocket(port, config);
+        this.socket = new NeonSocket(transport, config);
         this.socket.setBlocking(true);
         this.socket.setSoTimeout(config.getRelaySocketTimeoutMs());
+        this.socket.enableSourceInterning(config.getMaxRateLimiters());
+        if (config.getRelayAmplificationFactor() > 0) {
+            this.socket.enableAmplificationLimit(config.getRelayAmplificationFactor());
+        }
+        this.socket.setSourceFilter(CidrFilter.parse(config.getRelayAllowList(), config.getRelayBlockList()));
+        this.slotLimiters = new RateLimiter[config.getMaxRateLimiters()];
         this.sessionManager = new SessionManager();
         this.pendingConnections = new ConcurrentHashMap<>();
         this.rateLimiters = new ConcurrentHashMap<>();
+        this.connectionLimiters = new ConcurrentHashMap<>();
+        this.pathChallenges = new ConcurrentHashMap<>();
+        this.currentTokens = new ConcurrentHashMap<>();
         this.relaySemantics = new RelaySemantics();
+        this.retryCookies = config.isRelayConnectCookiesEnabled()
+            ? new RetryCookie(config.getRelayConnectCookieLifetimeMs())
+            : null;
+        this.tokenSigner = SessionTokenSigner.fromConfig(config);
         this.lastCleanupTime = System.currentTimeMillis();
 
         System.out.println("Relay listening on " + socket.getLocalAddress());
     }
 
+    private static Transport bindUdp(String bindAddress, NeonConfig config) throws IOException {
+        if (config == null) {
+            throw new IllegalArgumentException("config cannot be null");
+        }
+        config.validate();
+
+        String[] parts = bindAddress.split(":");
+        int port = parts.length == 2 ? Integer.parseInt(parts[1]) : config.getRelayPort();
+        return UdpTransport.bound(port, config);
+    }
+
     @Override
     public Lifecycle.State getState() {
         return lifecycleState.get();
     }
 
+    /**
+     * Checks whether a host has registered the session. Safe to call from any thread.
+     */
+    boolean hasHost(int sessionId) {
+        return sessionManager.getHost(sessionId).isPresent();
+    }
+
     @Override
     public void start() {
         Lifecycle.State current = lifecycleState.get();
@@ -177,6 +227,29 @@ public class NeonRelay implements AutoCloseable, Lifecycle {
         run();
     }
 
+    /**
+     * Hot-reloads the CIDR allow and block lists from a runtime configuration.
+     * The current values apply immediately, and later changes to {@code relay.allowList}
+     * or {@code relay.blockList} rebuild the filter and swap it in. An invalid list is
+     * logged and the previous filter stays in effect.
+     */
+    public void bindRuntimeConfig(RuntimeConfig runtime) {
+        RuntimeConfig.ConfigChangeListener reload = (key, oldValue, newValue) -> reloadSourceFilter(runtime);
+        runtime.addListener("relay.allowList", reload);
+        runtime.addListener("relay.blockList", reload);
+        reloadSourceFilter(runtime);
+    }
+
+    private void reloadSourceFilter(RuntimeConfig runtime) {
+        try {
+            CidrFilter filter = CidrFilter.parse(runtime.getString("relay.allowList"), runtime.getString("relay.blockList"));
+            socket.setSourceFilter(filter);
+            logger.log(Level.INFO, "Source filter loaded with {0} prefixes", filter.size());
+        } catch (IllegalArgumentException e) {
+            logger.log(Level.WARNING, "Ignoring invalid source filter: {0}", e.getMessage());
+        }
+    }
+
     /**
      * Processes incoming packets. Returns the number of packets processed.
      */
@@ -187,7 +260,7 @@ public class NeonRelay implements AutoCloseable, Lifecycle {
                 NeonSocket.ReceivedNeonPacket received = socket.receivePacket();
                 if (received == null) break;
 
-                handlePacket(received.packet(), received.source());
+                handlePacket(received.packet(), received.source(), received.checksummed(), received.sourceSlot());
                 count++;
             } catch (java.net.SocketTimeoutException e) {
                 break;
@@ -196,14 +269,32 @@ public class NeonRelay implements AutoCloseable, Lifecycle {
         return count;
     }
 
-    private void handlePacket(NeonPacket packet, SocketAddress source) throws IOException {
-        if (!rateLimiters.containsKey(source) && rateLimiters.size() >= config.getMaxRateLimiters()) {
-            logger.log(Level.WARNING, "Rate limiter capacity exceeded for {0} - dropping packet", source);
+    private void handlePacket(NeonPacket packet, SocketAddress source, boolean checksummed, int sourceSlot) throws IOException {
+        if (retryCookies != null && packet.payload() instanceof PacketPayload.ConnectRequest request
+                && !checkRetryCookie(request, source)) {
             return;
         }
 
-        RateLimiter limiter = rateLimiters.computeIfAbsent(source,
-            k -> new RateLimiter(config.getMaxPacketsPerSecond(), config));
+        PacketHeader header = packet.header();
+        PacketHeaderV2 headerV2 = packet.headerV2();
+        PeerInfo connection = null;
+        if (headerV2 != null && headerV2.connectionId() != 0) {
+            connection = sessionManager.getConnection(headerV2.connectionId());
+            if (connection == null || connection.clientId() != header.clientId()) {
+                logger.log(Level.FINE, "Dropping packet from {0}: unknown connection id {1}",
+                    new Object[]{source, headerV2.connectionId()});
+                return;
+            }
+        }
+
+        RateLimiter limiter = connection != null
+            ? connectionLimiters.computeIfAbsent(connection.connectionId(),
+                k -> new RateLimiter(config.getMaxPacketsPerSecond(), config))
+            : limiterFor(source, sourceSlot);
+        if (limiter == null) {
+            logger.log(Level.WARNING, "Rate limiter capacity exceeded for {0} - dropping packet", source);
+            return;
+        }
 
         if (!limiter.allowPacket()) {
             if (limiter.isThrottled()) {
@@ -215,24 +306,117 @@ public class NeonRelay implements AutoCloseable, Lifecycle {
             return;
         }
 
-        PacketHeader header = packet.header();
-
         if (header.magic() != PacketHeader.MAGIC) {
             logger.log(Level.WARNING, "Invalid magic number from {0}", source);
             return;
         }
 
+        if (connection != null && !connection.addr().equals(source)
+                && !(packet.payload() instanceof PacketPayload.ReconnectRequest)) {
+            validatePath(connection, packet.payload(), source);
+            return;
+        }
+
         switch (packet.payload()) {
             case PacketPayload.ConnectRequest request -> handleConnectRequest(request, source);
             case PacketPayload.ConnectAccept accept -> handleConnectAccept(accept, source, header);
             case PacketPayload.ReconnectRequest request -> handleReconnectRequest(request, source);
             case PacketPayload.DisconnectNotice ignored -> handleDisconnectNotice(source, header);
             default -> {
-                routePacket(packet, source);
+                routePacket(packet, source, connection, checksummed);
             }
         }
     }
 
+    /**
+     * Checks the retry cookie of a connect request before any per-source state is allocated.
+     * A request without a valid cookie is answered with a stateless retry deny carrying a
+     * fresh cookie bound to the source address.
+     *
+     * @return true if the request carries a valid cookie
+     */
+    private boolean checkRetryCookie(PacketPayload.ConnectRequest request, SocketAddress source) throws IOException {
+        if (!(source instanceof InetSocketAddress inet)) {
+            return false;
+        }
+        long now = System.currentTimeMillis();
+        if (retryCookies.verify(request.retryCookie(), inet, now)) {
+            socket.markSourceVerified(source);
+            return true;
+        }
+        if (request.retryCookie().length > 0) {
+            logger.log(Level.FINE, "Invalid or expired retry cookie from {0}", source);
+        }
+
+        PacketPayload.ConnectDeny retry = new PacketPayload.ConnectDeny("Retry", retryCookies.issue(inet, now));
+        PacketHeader header = PacketHeader.create(
+            PacketType.CONNECT_DENY.getValue(), (short) 0, (byte) 0, (byte) 0
+        );
+        socket.sendPacket(new NeonPacket(header, retry), source);
+        return false;
+    }
+
+    /**
+     * Finds the rate limiter for a source. Interned sources resolve through their slot
+     * with a single array load; the address map stays the record used by cleanup.
+     *
+     * @return the limiter, or null if the limiter capacity is exhausted
+     */
+    private RateLimiter limiterFor(SocketAddress source, int sourceSlot) {
+        if (sourceSlot >= 0) {
+            RateLimiter limiter = slotLimiters[sourceSlot];
+            if (limiter == null) {
+                limiter = rateLimiters.computeIfAbsent(source,
+                    k -> new RateLimiter(config.getMaxPacketsPerSecond(), config));
+                slotLimiters[sourceSlot] = limiter;
+            }
+            return limiter;
+        }
+
+        if (!rateLimiters.containsKey(source) && rateLimiters.size() >= config.getMaxRateLimiters()) {
+            return null;
+        }
+        return rateLimiters.computeIfAbsent(source,
+            k -> new RateLimiter(config.getMaxPacketsPerSecond(), config));
+    }
+
+    /**
+     * Follows a peer whose packets carry its connection id from a new source address. The
+     * new address is only adopted after it echoes a path challenge: the relay sends a PING
+     * with a random nonce to the new address and migrates the peer when the PONG with that
+     * nonce and the same connection id comes back. Until then packets from the new address
+     * are dropped and the peer stays reachable at its old address. Reconnect requests are
+     * exempt because they carry their own session token.
+     */
+    private void validatePath(PeerInfo peer, PacketPayload payload, SocketAddress source) throws IOException {
+        long now = System.currentTimeMillis();
+        PathChallenge pending = pathChallenges.get(peer.connectionId());
+        if (pending != null && pending.candidate().equals(source)
+                && now - pending.sentAt() <= PATH_CHALLENGE_TIMEOUT_MS) {
+            if (payload instanceof PacketPayload.Pong pong && pong.originalTimestamp() == pending.nonce()) {
+                pathChallenges.remove(peer.connectionId());
+                sessionManager.updatePeerAddress(peer.sessionId(), peer.clientId(), source);
+                socket.markSourceVerified(source);
+                rateLimiters.remove(peer.addr());
+                logger.log(Level.INFO, "Client {0} rebound from {1} to {2} [SessionID={3}]",
+                    new Object[]{peer.clientId(), peer.addr(), source, peer.sessionId()});
+                return;
+            }
+            if (now - pending.sentAt() < PATH_CHALLENGE_RETRY_MS) {
+                return;
+            }
+        }
+
+        long nonce = challengeSource.nextLong();
+        pathChallenges.put(peer.connectionId(), new PathChallenge(source, nonce, now));
+        PacketHeader header = PacketHeader.create(
+            PacketType.PING.getValue(), (short) 0, (byte) 0, peer.clientId()
+        );
+        socket.sendPacket(new NeonPacket(header, new PacketPayload.Ping(nonce)), source);
+        logger.log(Level.FINE, "Path challenge sent to {0} for client {1} [SessionID={2}]",
+            new Object[]{source, peer.clientId(), peer.sessionId()});
+    }
+
     private void handleConnectRequest(PacketPayload.ConnectRequest request, SocketAddress source) throws IOException {
         int sessionId = request.targetSessionId();
 
@@ -275,7 +459,7 @@ public class NeonRelay implements AutoCloseable, Lifecycle {
         }
 
         pendingConnections.put(source, new PendingConnection(
-            sessionId, request.desiredName(), Instant.now()
+            sessionId, request.desiredName(), request.clientVersion(), Instant.now()
         ));
 
         Optional<SocketAddress> hostAddr = sessionManager.getHost(sessionId);
@@ -283,7 +467,10 @@ public class NeonRelay implements AutoCloseable, Lifecycle {
             PacketHeader header = PacketHeader.create(
                 PacketType.CONNECT_REQUEST.getValue(), (short) 0, (byte) 0, (byte) 1
             );
-            NeonPacket forwardPacket = new NeonPacket(header, request);
+            PacketPayload.ConnectRequest forwarded = request.retryCookie().length > 0
+                ? request.withRetryCookie(PacketPayload.NO_COOKIE)
+                : request;
+            NeonPacket forwardPacket = new NeonPacket(header, forwarded);
             socket.sendPacket(forwardPacket, hostAddr.get());
         } else {
             PacketPayload.ConnectDeny deny = new PacketPayload.ConnectDeny("Session not found");
@@ -301,22 +488,35 @@ public class NeonRelay implements AutoCloseable, Lifecycle {
 
         if (clientId == 1) {
             sessionManager.registerHost(sessionId, source);
+            socket.markSourceVerified(source);
             System.out.println("Host registered for session " + sessionId + " from " + source);
         } else {
             SocketAddress clientAddr = findPendingClientAddress(sessionId);
+            long connectionId = 0;
             if (clientAddr != null) {
-                sessionManager.registerPeer(sessionId, clientId, clientAddr, false);
-                pendingConnections.remove(clientAddr);
+                PeerInfo peer = sessionManager.registerPeer(sessionId, clientId, clientAddr, false);
+                PendingConnection pending = pendingConnections.remove(clientAddr);
+                if (pending != null && pending.clientVersion() >= PacketHeaderV2.VERSION) {
+                    connectionId = peer.connectionId();
+                }
                 System.out.println("Client " + clientId + " joined session " + sessionId);
             }
+            if (tokenSigner != null && sessionManager.getHost(sessionId).filter(source::equals).isPresent()) {
+                currentTokens.put(tokenKey(sessionId, clientId), accept.sessionToken());
+            }
+            sessionManager.getPeerAddress(sessionId, clientId).ifPresent(socket::markSourceVerified);
 
-            routeToClient(sessionId, clientId, accept, header);
+            routeToClient(sessionId, clientId, accept, header, connectionId);
         }
     }
 
     private void handleReconnectRequest(PacketPayload.ReconnectRequest request, SocketAddress source) throws IOException {
         int sessionId = request.targetSessionId();
 
+        if (tokenSigner != null && rebindLocally(request, source)) {
+            return;
+        }
+
         Optional<SocketAddress> hostAddr = sessionManager.getHost(sessionId);
         if (hostAddr.isPresent()) {
             PacketHeader header = PacketHeader.create(
@@ -339,6 +539,67 @@ public class NeonRelay implements AutoCloseable, Lifecycle {
         }
     }
 
+    /**
+     * Rebinds a peer that is still part of its session after an address change, using the
+     * signed session token instead of a round trip to the host.
+     *
+     * <p>A signature alone would let a captured request be replayed forever, so the relay
+     * also remembers the current token of each peer, learned from the host's ConnectAccept.
+     * Only that token is accepted, and every successful rebind replaces it with a fresh one
+     * sent to both the client and the host. A correctly signed but superseded token is
+     * denied here rather than forwarded.
+     *
+     * @return true if the reconnect was handled
+     */
+    private boolean rebindLocally(PacketPayload.ReconnectRequest request, SocketAddress source) throws IOException {
+        int sessionId = request.targetSessionId();
+        byte clientId = request.previousClientId();
+        if (!tokenSigner.verify(request.sessionToken(), sessionId, clientId)) {
+            return false;
+        }
+        Optional<SocketAddress> previous = sessionManager.getPeerAddress(sessionId, clientId);
+        if (previous.isEmpty()) {
+            return false;
+        }
+
+        long key = tokenKey(sessionId, clientId);
+        Long current = currentTokens.get(key);
+        if (current == null || current != request.sessionToken()) {
+            PacketPayload.ConnectDeny deny = new PacketPayload.ConnectDeny("Invalid session token");
+            PacketHeader header = PacketHeader.create(
+                PacketType.CONNECT_DENY.getValue(), (short) 0, (byte) 0, (byte) 0
+            );
+            socket.sendPacket(new NeonPacket(header, deny), source);
+            logger.log(Level.WARNING, "Reconnect from {0} with a superseded token for client {1} [SessionID={2}]",
+                new Object[]{source, clientId, sessionId});
+            return true;
+        }
+
+        long freshToken = tokenSigner.issue(sessionId, clientId);
+        currentTokens.put(key, freshToken);
+        if (!previous.get().equals(source)) {
+            sessionManager.updatePeerAddress(sessionId, clientId, source);
+            rateLimiters.remove(previous.get());
+        }
+        socket.markSourceVerified(source);
+
+        PacketPayload.ConnectAccept accept = new PacketPayload.ConnectAccept(clientId, sessionId, freshToken);
+        PacketHeader header = PacketHeader.create(
+            PacketType.CONNECT_ACCEPT.getValue(), (short) 0, (byte) 1, clientId
+        );
+        routeToClient(sessionId, clientId, accept, header, 0);
+        Optional<SocketAddress> hostAddr = sessionManager.getHost(sessionId);
+        if (hostAddr.isPresent()) {
+            PacketHeader hostHeader = PacketHeader.create(
+                PacketType.CONNECT_ACCEPT.getValue(), (short) 0, clientId, (byte) 1
+            );
+            socket.sendPacket(new NeonPacket(hostHeader, accept), hostAddr.get());
+        }
+        logger.log(Level.INFO, "Client {0} rebound from {1} to {2} by session token [SessionID={3}]",
+            new Object[]{clientId, previous.get(), source, sessionId});
+        return true;
+    }
+
     private void handleDisconnectNotice(SocketAddress source, PacketHeader header) throws IOException {
         Optional<Integer> sessionId = sessionManager.getSessionForPeer(source);
         if (sessionId.isEmpty()) {
@@ -369,7 +630,14 @@ public class NeonRelay implements AutoCloseable, Lifecycle {
             new Object[]{clientId, session});
     }
 
-    private void routePacket(NeonPacket packet, SocketAddress source) throws IOException {
+    /**
+     * Forwards a packet to its destination(s). Forwarded packets keep the framing they
+     * arrived with, so a session that negotiated CRC32C trailers keeps them end to end.
+     * A packet that carried a connection id is routed within that connection's session
+     * rather than by looking up its source address.
+     */
+    private void routePacket(NeonPacket packet, SocketAddress source, PeerInfo connection,
+                             boolean checksummed) throws IOException {
         sessionManager.updateLastSeen(source);
 
         Optional<String> validationError = relaySemantics.validateForForwarding(packet);
@@ -379,17 +647,17 @@ public class NeonRelay implements AutoCloseable, Lifecycle {
             return;
         }
 
-        RelaySemantics.RoutingDecision decision = relaySemantics.determineRouting(
-            packet, source, sessionManager
-        );
+        RelaySemantics.RoutingDecision decision = connection != null
+            ? relaySemantics.determineRouting(packet, connection.sessionId(), source, sessionManager)
+            : relaySemantics.determineRouting(packet, source, sessionManager);
 
         switch (decision) {
             case RelaySemantics.RoutingDecision.Unicast unicast -> {
-                socket.sendPacket(unicast.packet(), unicast.destination());
+                forward(unicast.packet(), unicast.destination(), checksummed);
             }
             case RelaySemantics.RoutingDecision.Broadcast broadcast -> {
                 for (SocketAddress dest : broadcast.destinations()) {
-                    socket.sendPacket(broadcast.packet(), dest);
+                    forward(broadcast.packet(), dest, checksummed);
                 }
             }
             case RelaySemantics.RoutingDecision.Unroutable unroutable -> {
@@ -403,13 +671,41 @@ public class NeonRelay implements AutoCloseable, Lifecycle {
         }
     }
 
-    private void routeToClient(int sessionId, byte clientId, PacketPayload payload, PacketHeader originalHeader) throws IOException {
+    /**
+     * Sends a forwarded packet, dropping it if the datagram cannot be sent. With path MTU
+     * discovery enabled the socket sets the don't-fragment bit, so an oversized probe
+     * fails here instead of stopping the relay loop.
+     */
+    private void forward(NeonPacket packet, SocketAddress destination, boolean checksummed) throws IOException {
+        try {
+            socket.sendPacket(packet, destination, checksummed);
+        } catch (java.net.SocketException e) {
+            logger.log(Level.FINE, "Dropped forwarded packet to {0}: {1}",
+                new Object[]{destination, e.getMessage()});
+        }
+    }
+
+    /**
+     * Sends a relay-built packet to a client. A non-zero connection id is delivered in a
+     * version 2 header, which is how clients that advertised version 2 learn their id.
+     */
+    private void routeToClient(int sessionId, byte clientId, PacketPayload payload, PacketHeader originalHeader,
+                               long connectionId) throws IOException {
         Optional<SocketAddress> addr = sessionManager.getPeerAddress(sessionId, clientId);
         if (addr.isPresent()) {
-            PacketHeader header = PacketHeader.create(
-                originalHeader.packetType(), originalHeader.sequence(), originalHeader.clientId(), clientId
-            );
-            NeonPacket packet = new NeonPacket(header, payload);
+            NeonPacket packet;
+            if (connectionId != 0) {
+                PacketHeaderV2 headerV2 = PacketHeaderV2.create(
+                    originalHeader.packetType(), originalHeader.sequence() & 0xFFFF,
+                    originalHeader.clientId() & 0xFF, clientId & 0xFF
+                ).withConnectionId(connectionId);
+                packet = new NeonPacket(headerV2.toV1(), payload, headerV2);
+            } else {
+                PacketHeader header = PacketHeader.create(
+                    originalHeader.packetType(), originalHeader.sequence(), originalHeader.clientId(), clientId
+                );
+                packet = new NeonPacket(header, payload);
+            }
             socket.sendPacket(packet, addr.get());
         }
     }
@@ -447,6 +743,32 @@ public class NeonRelay implements AutoCloseable, Lifecycle {
             }
             return false;
         });
+        connectionLimiters.keySet().removeIf(id -> sessionManager.getConnection(id) == null);
+        currentTokens.keySet().removeIf(key ->
+            sessionManager.getPeerAddress((int) (key >> 8), (byte) (long) key).isEmpty());
+        pathChallenges.entrySet().removeIf(entry ->
+            now - entry.getValue().sentAt() > PATH_CHALLENGE_TIMEOUT_MS
+                || sessionManager.getConnection(entry.getKey()) == null);
+
+        AmplificationLimiter amplificationLimiter = socket.getAmplificationLimiter();
+        if (amplificationLimiter != null) {
+            amplificationLimiter.retainVerified(activeAddresses);
+        }
+
+        /*
+         * Peers whose packets carry a connection id are rate-limited per connection, so a
+         * migrated peer's address has no rateLimiters entry; keep every active peer's slot,
+         * or its amplification verification would be reset while it is still connected.
+         */
+        SourceAddressTable sourceTable = socket.getSourceTable();
+        for (int slot = 0; slot < sourceTable.capacity(); slot++) {
+            InetSocketAddress addr = sourceTable.addressOf(slot);
+            if (addr != null && !rateLimiters.containsKey(addr) && !activeAddresses.contains(addr)
+                    && !pendingConnections.containsKey(addr)) {
+                slotLimiters[slot] = null;
+                socket.releaseSource(slot);
+            }
+        }
 
         lastCleanupTime = now;
     }
@@ -456,29 +778,55 @@ public class NeonRelay implements AutoCloseable, Lifecycle {
         socket.close();
     }
 
+    private static long tokenKey(int sessionId, byte clientId) {
+        return (long) sessionId << 8 | (clientId & 0xFF);
+    }
+
     /**
      * Tracks pending client connections.
      */
-    private record PendingConnection(int sessionId, String name, Instant requestTime) {}
+    private record PendingConnection(int sessionId, String name, byte clientVersion, Instant requestTime) {}
+
+    /**
+     * Outstanding path challenge for a connection seen at a new address.
+     */
+    private record PathChallenge(SocketAddress candidate, long nonce, long sentAt) {}
 }
 
 /**
  * Manages sessions and peer routing.
+ *
+ * <p>Every registered peer also gets a relay-assigned 64-bit connection id. The low
+ * {@link #SLOT_BITS} bits index a dense peer table and the next {@link #SALT_BITS} bits are
+ * a random salt, so {@link #getConnection(long)} is an array load plus one comparison and
+ * stale or guessed ids are rejected.
  */
 class SessionManager implements RelaySemantics.PeerLookup {
+    static final int SLOT_BITS = 16;
+    static final int SALT_BITS = 63 - SLOT_BITS;
+    private static final int SLOT_MASK = (1 << SLOT_BITS) - 1;
+    private static final int INITIAL_SLOTS = 64;
+
     private final Map<Integer, List<PeerInfo>> sessions = new ConcurrentHashMap<>();
     private final Map<Integer, SocketAddress> hosts = new ConcurrentHashMap<>();
     private final Map<SocketAddress, PeerInfo> peerLookup = new ConcurrentHashMap<>();
 
+    private PeerInfo[] connections = new PeerInfo[INITIAL_SLOTS];
+    private final ArrayDeque<Integer> freeSlots = new ArrayDeque<>();
+    private int nextSlot = 0;
+    private final java.security.SecureRandom saltSource = new java.security.SecureRandom();
+
     public void registerHost(int sessionId, SocketAddress addr) {
         hosts.put(sessionId, addr);
         registerPeer(sessionId, (byte) 1, addr, true);
     }
 
-    public void registerPeer(int sessionId, byte clientId, SocketAddress addr, boolean isHost) {
-        PeerInfo peer = new PeerInfo(addr, clientId, sessionId, Instant.now(), isHost);
+    public PeerInfo registerPeer(int sessionId, byte clientId, SocketAddress addr, boolean isHost) {
+        PeerInfo peer = new PeerInfo(addr, clientId, sessionId, Instant.now(), isHost, allocateConnectionId());
         sessions.computeIfAbsent(sessionId, k -> new ArrayList<>()).add(peer);
         peerLookup.put(addr, peer);
+        connections[slotOf(peer.connectionId())] = peer;
+        return peer;
     }
 
     public void updatePeerAddress(int sessionId, byte clientId, SocketAddress newAddr) {
@@ -494,10 +842,31 @@ class SessionManager implements RelaySemantics.PeerLookup {
                 peerLookup.remove(oldPeer.addr());
             }
 
-            PeerInfo newPeer = new PeerInfo(newAddr, clientId, sessionId, Instant.now(), oldPeer != null && oldPeer.isHost());
+            boolean isHost = oldPeer != null && oldPeer.isHost();
+            long connectionId = oldPeer != null ? oldPeer.connectionId() : allocateConnectionId();
+            PeerInfo newPeer = new PeerInfo(newAddr, clientId, sessionId, Instant.now(), isHost, connectionId);
             peers.add(newPeer);
             peerLookup.put(newAddr, newPeer);
+            connections[slotOf(connectionId)] = newPeer;
+            if (isHost) {
+                hosts.put(sessionId, newAddr);
+            }
+        }
+    }
+
+    /**
+     * Looks up a peer by its connection id.
+     *
+     * @return the peer, or null if the id is unknown or stale
+     */
+    public PeerInfo getConnection(long connectionId) {
+        int slot = slotOf(connectionId);
+        PeerInfo[] table = connections;
+        if (connectionId <= 0 || slot >= table.length) {
+            return null;
         }
+        PeerInfo peer = table[slot];
+        return peer != null && peer.connectionId() == connectionId ? peer : null;
     }
 
     public Optional<SocketAddress> getHost(int sessionId) {
@@ -554,9 +923,10 @@ class SessionManager implements RelaySemantics.PeerLookup {
         PeerInfo peer = peerLookup.get(addr);
         if (peer != null) {
             PeerInfo updated = new PeerInfo(
-                peer.addr(), peer.clientId(), peer.sessionId(), Instant.now(), peer.isHost()
+                peer.addr(), peer.clientId(), peer.sessionId(), Instant.now(), peer.isHost(), peer.connectionId()
             );
             peerLookup.put(addr, updated);
+            connections[slotOf(peer.connectionId())] = updated;
 
             List<PeerInfo> peers = sessions.get(peer.sessionId());
             if (peers != null) {
@@ -569,6 +939,7 @@ class SessionManager implements RelaySemantics.PeerLookup {
     public void removePeer(SocketAddress addr) {
         PeerInfo peer = peerLookup.remove(addr);
         if (peer != null) {
+            releaseConnectionId(peer.connectionId());
             List<PeerInfo> peers = sessions.get(peer.sessionId());
             if (peers != null) {
                 peers.removeIf(p -> p.addr().equals(addr));
@@ -595,6 +966,7 @@ class SessionManager implements RelaySemantics.PeerLookup {
         for (SocketAddress addr : toRemove) {
             PeerInfo peer = peerLookup.remove(addr);
             if (peer != null) {
+                releaseConnectionId(peer.connectionId());
                 List<PeerInfo> peers = sessions.get(peer.sessionId());
                 if (peers != null) {
                     peers.removeIf(p -> p.addr().equals(addr));
@@ -607,6 +979,40 @@ class SessionManager implements RelaySemantics.PeerLookup {
             }
         }
     }
+
+    private long allocateConnectionId() {
+        Integer free = freeSlots.poll();
+        int slot;
+        if (free != null) {
+            slot = free;
+        } else {
+            if (nextSlot > SLOT_MASK) {
+                throw new IllegalStateException("Connection table exhausted (" + (SLOT_MASK + 1) + " slots)");
+            }
+            slot = nextSlot++;
+            if (slot >= connections.length) {
+                connections = Arrays.copyOf(connections, Math.min(connections.length * 2, SLOT_MASK + 1));
+            }
+        }
+        long salt;
+        do {
+            salt = saltSource.nextLong() >>> (64 - SALT_BITS);
+        } while (salt == 0);
+        return (salt << SLOT_BITS) | slot;
+    }
+
+    private void releaseConnectionId(long connectionId) {
+        int slot = slotOf(connectionId);
+        if (slot < connections.length && connections[slot] != null
+                && connections[slot].connectionId() == connectionId) {
+            connections[slot] = null;
+            freeSlots.push(slot);
+        }
+    }
+
+    private static int slotOf(long connectionId) {
+        return (int) (connectionId & SLOT_MASK);
+    }
 }
 
 /**
@@ -617,7 +1023,8 @@ record PeerInfo(
     byte clientId,
     int sessionId,
     Instant lastSeen,
-    boolean isHost
+    boolean isHost,
+    long connectionId
 ) {}
 
 /**
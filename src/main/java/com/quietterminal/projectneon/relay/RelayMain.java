@@ -1,12 +1,21 @@
 package com.quietterminal.projectneon.relay;
 
+import com.quietterminal.projectneon.core.NeonConfig;
+import com.quietterminal.projectneon.core.RuntimeConfig;
+import com.quietterminal.projectneon.core.SharedMemoryTransport;
+import com.quietterminal.projectneon.core.UdpTransport;
 import com.quietterminal.projectneon.util.LoggerConfig;
 
+import java.io.IOException;
+import java.nio.file.Path;
 import java.util.logging.Level;
 import java.util.logging.Logger;
 
 /**
  * CLI entry point for the Neon relay server.
+ * Usage: {@code neon-relay [--bind host:port] [--config neon.properties] [--shm file]}, where
+ * the optional properties file uses the {@link RuntimeConfig} keys and {@code --shm} serves a
+ * host on the same machine through a {@link SharedMemoryTransport} file.
  * This class is internal and not part of the public API.
  */
 class RelayMain {
@@ -23,25 +32,57 @@ class RelayMain {
             System.out.println("=== Project Neon Relay Server ===");
             System.out.println();
 
-            String bindAddress = DEFAULT_BIND_ADDRESS;
-            if (args.length > 0 && args[0].equals("--bind") && args.length > 1) {
-                bindAddress = args[1];
+            String bindAddress = option(args, "--bind", DEFAULT_BIND_ADDRESS);
+            String configFile = option(args, "--config", null);
+            String sharedMemoryFile = option(args, "--shm", null);
+            NeonConfig config = new NeonConfig();
+            if (configFile != null) {
+                RuntimeConfig runtime = RuntimeConfig.create();
+                runtime.loadFromFile(Path.of(configFile));
+                config = runtime.toNeonConfig();
+                System.out.println("Config file: " + configFile);
             }
 
             System.out.println("Starting relay server...");
             System.out.println("Bind address: " + bindAddress);
+            if (sharedMemoryFile != null) {
+                System.out.println("Shared-memory host file: " + sharedMemoryFile);
+            }
             System.out.println("\nRelay running. Waiting for connections...");
             System.out.println("Press Ctrl+C to exit.\n");
 
-            try (NeonRelay relay = new NeonRelay(bindAddress)) {
+            try (NeonRelay relay = sharedMemoryFile != null
+                    ? new NeonRelay(sharedMemory(Path.of(sharedMemoryFile), bindAddress, config), config)
+                    : new NeonRelay(bindAddress, config)) {
                 relay.startAndRun();
             }
 
         } catch (Exception e) {
-            String bindAddr = args.length > 1 ? args[1] : DEFAULT_BIND_ADDRESS;
+            String bindAddr = option(args, "--bind", DEFAULT_BIND_ADDRESS);
             logger.log(Level.SEVERE, "Relay error [BindAddress=" + bindAddr + "]", e);
             System.err.println("Error: " + e.getMessage());
             e.printStackTrace();
         }
     }
+
+    private static SharedMemoryTransport sharedMemory(Path file, String bindAddress, NeonConfig config) throws IOException {
+        String[] parts = bindAddress.split(":");
+        int port = parts.length == 2 ? Integer.parseInt(parts[1]) : config.getRelayPort();
+        UdpTransport udp = UdpTransport.bound(port, config);
+        try {
+            return SharedMemoryTransport.create(file, SharedMemoryTransport.DEFAULT_RING_CAPACITY, udp);
+        } catch (IOException e) {
+            udp.close();
+            throw e;
+        }
+    }
+
+    private static String option(String[] args, String name, String defaultValue) {
+        for (int i = 0; i + 1 < args.length; i++) {
+            if (args[i].equals(name)) {
+                return args[i + 1];
+            }
+        }
+        return defaultValue;
+    }
 }
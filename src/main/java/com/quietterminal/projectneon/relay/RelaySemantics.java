@@ -66,8 +66,26 @@ public class RelaySemantics {
             return new RoutingDecision.Unroutable(destId, "Source not in any session");
         }
 
-        int session = sessionId.get();
+        return determineRouting(packet, sessionId.get(), source, sessionLookup);
+    }
+
+    /**
+     * Determines the routing decision for a packet whose session is already known, such as
+     * one attributed to a peer by its connection id.
+     *
+     * @param packet The packet to route
+     * @param session The session the sender belongs to
+     * @param source The sender's address, excluded from broadcasts
+     * @param sessionLookup Function to look up peer addresses
+     * @return The routing decision
+     */
+    public RoutingDecision determineRouting(
+            NeonPacket packet,
+            int session,
+            SocketAddress source,
+            PeerLookup sessionLookup) {
 
+        byte destId = packet.header().destinationId();
         if (destId == 0) {
             java.util.List<SocketAddress> targets = sessionLookup.getAllPeersExcept(session, source);
             if (targets.isEmpty()) {
@@ -0,0 +1,90 @@
+package com.quietterminal.projectneon.relay;
+
+import com.quietterminal.projectneon.client.NeonClient;
+import com.quietterminal.projectneon.core.NeonConfig;
+import com.quietterminal.projectneon.host.NeonHost;
+import com.quietterminal.projectneon.util.LoggerConfig;
+import com.quietterminal.projectneon.util.VirtualThreads;
+
+import java.net.DatagramSocket;
+import java.util.logging.Level;
+import java.util.logging.Logger;
+
+/**
+ * Short relay, host and client session over loopback, run at build time to record the
+ * classes a relay or host loads into a class-data-sharing archive. Connects a client,
+ * exchanges pings and game packets in both directions, disconnects and exits.
+ * Usage: {@code java -XX:ArchiveClassesAtExit=neon-relay.jsa -cp neon-relay.jar <this class>}.
+ * This class is internal and not part of the public API.
+ *
+ * @since 1.3
+ */
+class TrainingRun {
+    private static final Logger logger;
+
+    static {
+        logger = Logger.getLogger(TrainingRun.class.getName());
+        LoggerConfig.configureLogger(logger);
+    }
+
+    private static final int SESSION_ID = 1;
+    private static final int ROUNDS = 200;
+    private static final byte GAME_PACKET_TYPE = 0x10;
+    private static final byte HOST_ID = 1;
+    private static final long REGISTRATION_TIMEOUT_MS = 10_000;
+
+    public static void main(String[] args) throws Exception {
+        int port;
+        try (DatagramSocket probe = new DatagramSocket(0)) {
+            port = probe.getLocalPort();
+        }
+        String address = "127.0.0.1:" + port;
+        NeonConfig config = new NeonConfig()
+            .setMaxPacketsPerSecond(100_000)
+            .setHostProcessingLoopSleepMs(1);
+
+        try (NeonRelay relay = new NeonRelay(address, config);
+             NeonHost host = new NeonHost(SESSION_ID, address, config);
+             NeonClient client = new NeonClient("training", config)) {
+            VirtualThreads.startVirtualThread(() -> {
+                try {
+                    relay.startAndRun();
+                } catch (Exception e) {
+                    logger.log(Level.FINE, "Training relay stopped", e);
+                }
+            });
+            host.startAsync();
+            awaitRegistration(relay);
+
+            if (!client.connect(SESSION_ID, address)) {
+                throw new IllegalStateException("Training client failed to connect");
+            }
+            byte clientId = client.getClientId().orElseThrow();
+            byte[] payload = new byte[64];
+            for (int i = 0; i < ROUNDS; i++) {
+                client.sendGamePacket(GAME_PACKET_TYPE, HOST_ID, payload);
+                host.sendGamePacket(GAME_PACKET_TYPE, clientId, payload);
+                if (i % 50 == 0) {
+                    client.sendPing();
+                }
+                client.processPackets();
+                Thread.sleep(1);
+            }
+            logger.log(Level.INFO, "Training run complete [Clients={0}]", host.getClientCount());
+        }
+    }
+
+    /**
+     * Waits for the host's registration to reach the relay; a connect request that arrives
+     * first is denied with "Session not found".
+     */
+    private static void awaitRegistration(NeonRelay relay) throws InterruptedException {
+        long deadline = System.currentTimeMillis() + REGISTRATION_TIMEOUT_MS;
+        while (!relay.hasHost(SESSION_ID)) {
+            if (System.currentTimeMillis() > deadline) {
+                throw new IllegalStateException("Training host did not register with the relay");
+            }
+            Thread.sleep(5);
+        }
+    }
+}
@@ -60,6 +60,14 @@ int main(int argc, char** argv) {
     printf("Session ID: %u\n", session_id);
     printf("Relay address: %s\n\n", relay_addr);
 
+    NeonRuntimeOptions runtime = {0};
+    runtime.class_path = getenv("NEON_CLASS_PATH") != NULL ? getenv("NEON_CLASS_PATH") : "target/classes";
+    runtime.cds_archive = getenv("NEON_CDS_ARCHIVE");
+    if (!neon_runtime_init(&runtime)) {
+        fprintf(stderr, "Failed to start Java runtime: %s\n", neon_get_last_error());
+        return 1;
+    }
+
     NeonClientHandle* client = neon_client_new(client_name);
     if (client == NULL) {
         fprintf(stderr, "Failed to create client: %s\n", neon_get_last_error());
@@ -119,5 +127,6 @@ int main(int argc, char** argv) {
     neon_client_free(client);
     printf("Client freed. Exiting.\n");
 
+    neon_runtime_shutdown();
     return 0;
 }
@@ -47,6 +47,14 @@ int main(int argc, char** argv) {
     printf("Session ID: %u\n", session_id);
     printf("Relay address: %s\n\n", relay_addr);
 
+    NeonRuntimeOptions runtime = {0};
+    runtime.class_path = getenv("NEON_CLASS_PATH") != NULL ? getenv("NEON_CLASS_PATH") : "target/classes";
+    runtime.cds_archive = getenv("NEON_CDS_ARCHIVE");
+    if (!neon_runtime_init(&runtime)) {
+        fprintf(stderr, "Failed to start Java runtime: %s\n", neon_get_last_error());
+        return 1;
+    }
+
     NeonHostHandle* host = neon_host_new(session_id, relay_addr);
     if (host == NULL) {
         fprintf(stderr, "Failed to create host: %s\n", neon_get_last_error());
@@ -64,9 +72,14 @@ int main(int argc, char** argv) {
     printf("Session ID: %u\n", neon_host_get_session_id(host));
     printf("Initial client count: %zu\n", neon_host_get_client_count(host));
 
-    printf("\nRunning for 60 seconds (processing packets manually)...\n");
-    printf("Note: In production, you would typically call neon_host_start() in a separate thread\n");
-    printf("      instead of manually processing packets in a loop.\n\n");
+    if (!neon_host_start(host)) {
+        fprintf(stderr, "Failed to start host: %s\n", neon_get_last_error());
+        neon_host_free(host);
+        neon_runtime_shutdown();
+        return 1;
+    }
+
+    printf("\nRegistered with the relay; running for 60 seconds...\n\n");
 
     for (int i = 0; i < 60; i++) {
         sleep_ms(1000);
@@ -82,5 +95,6 @@ int main(int argc, char** argv) {
     neon_host_free(host);
     printf("Host freed. Exiting.\n");
 
+    neon_runtime_shutdown();
     return 0;
 }
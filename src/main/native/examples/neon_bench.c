@@ -0,0 +1,399 @@
+/*
+ * Project Neon JNI bridge benchmark.
+ *
+ * Measures, from C, what each call across the bridge costs:
+ *   - neon_client_process_packets with no traffic, per thread count
+ *   - the cached getters
+ *   - with a relay running: game message throughput and host callback delivery
+ *     from 1..max_threads sending clients
+ *
+ * Usage: neon_bench [iterations] [max_threads] [relay_addr] [session_id]
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <string.h>
+#include "../project_neon.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#define sleep_ms(ms) Sleep(ms)
+typedef HANDLE bench_thread;
+#else
+#include <pthread.h>
+#include <time.h>
+typedef pthread_t bench_thread;
+
+static void sleep_ms(long ms) {
+    struct timespec ts = {ms / 1000, (ms % 1000) * 1000000L};
+    nanosleep(&ts, NULL);
+}
+#endif
+
+#define MAX_THREADS 64
+#define MESSAGE_TYPE 0x10
+#define MESSAGE_SIZE 32
+#define HOST_CLIENT_ID 1
+#define FLUSH_EVERY 64
+#define DRAIN_TIMEOUT_MS 10000
+
+typedef void (*bench_fn)(void* arg);
+
+typedef struct {
+    bench_fn fn;
+    void* arg;
+} ThreadStart;
+
+static uint64_t now_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+#ifdef _WIN32
+static DWORD WINAPI thread_main(LPVOID param) {
+    ThreadStart* start = (ThreadStart*)param;
+    start->fn(start->arg);
+    return 0;
+}
+
+static bool thread_start(bench_thread* thread, ThreadStart* start) {
+    *thread = CreateThread(NULL, 0, thread_main, start, 0, NULL);
+    return *thread != NULL;
+}
+
+static void thread_join(bench_thread thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+#else
+static void* thread_main(void* param) {
+    ThreadStart* start = (ThreadStart*)param;
+    start->fn(start->arg);
+    return NULL;
+}
+
+static bool thread_start(bench_thread* thread, ThreadStart* start) {
+    return pthread_create(thread, NULL, thread_main, start) == 0;
+}
+
+static void thread_join(bench_thread thread) {
+    pthread_join(thread, NULL);
+}
+#endif
+
+/* Runs fn(args[i]) on count threads at once and returns the wall time in ns */
+static uint64_t run_threads(int count, bench_fn fn, void** args) {
+    bench_thread threads[MAX_THREADS];
+    ThreadStart starts[MAX_THREADS];
+    uint64_t start = now_ns();
+    for (int i = 0; i < count; i++) {
+        starts[i].fn = fn;
+        starts[i].arg = args[i];
+        if (!thread_start(&threads[i], &starts[i])) {
+            fprintf(stderr, "Failed to start thread %d\n", i);
+            exit(1);
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        thread_join(threads[i]);
+    }
+    return now_ns() - start;
+}
+
+static void report(const char* name, int threads, uint64_t operations, uint64_t elapsed_ns, const char* unit) {
+    double seconds = (double)elapsed_ns / 1e9;
+    printf("%-28s threads=%-3d %12.1f ns/%s %14.0f %ss/s\n", name, threads,
+           operations > 0 ? (double)elapsed_ns * threads / (double)operations : 0.0, unit,
+           seconds > 0 ? (double)operations / seconds : 0.0, unit);
+}
+
+/* ========== Idle calls ========== */
+
+typedef struct {
+    NeonClientHandle* client;
+    long iterations;
+} IdleArgs;
+
+static void idle_process_packets(void* param) {
+    IdleArgs* args = (IdleArgs*)param;
+    for (long i = 0; i < args->iterations; i++) {
+        neon_client_process_packets(args->client);
+    }
+}
+
+static void bench_idle(NeonClientHandle** clients, int max_threads, long iterations) {
+    IdleArgs args[MAX_THREADS];
+    void* params[MAX_THREADS];
+    for (int i = 0; i < max_threads; i++) {
+        args[i].client = clients[i];
+        args[i].iterations = iterations;
+        params[i] = &args[i];
+    }
+
+    /* Warm up so the JIT has compiled the Java side before anything is timed */
+    idle_process_packets(&args[0]);
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        uint64_t elapsed = run_threads(threads, idle_process_packets, params);
+        report("process_packets (idle)", threads, (uint64_t)iterations * threads, elapsed, "call");
+    }
+}
+
+static void bench_getters(NeonClientHandle* client, NeonHostHandle* host, long iterations) {
+    volatile uint64_t sink = 0;
+    uint64_t start;
+
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        sink += neon_client_get_id(client);
+    }
+    report("client_get_id", 1, (uint64_t)iterations, now_ns() - start, "call");
+
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        sink += neon_client_is_connected(client);
+    }
+    report("client_is_connected", 1, (uint64_t)iterations, now_ns() - start, "call");
+
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        sink += neon_client_get_session_id(client);
+    }
+    report("client_get_session_id", 1, (uint64_t)iterations, now_ns() - start, "call");
+
+    if (host != NULL) {
+        start = now_ns();
+        for (long i = 0; i < iterations; i++) {
+            sink += neon_host_get_client_count(host);
+        }
+        report("host_get_client_count", 1, (uint64_t)iterations, now_ns() - start, "call");
+    }
+    (void)sink;
+}
+
+/* ========== Live traffic ========== */
+
+typedef struct {
+    NeonHostHandle* host;
+    atomic_bool stop;
+    atomic_ullong messages;
+    atomic_ullong pings;
+} HostPump;
+
+static HostPump g_pump;
+
+static void on_ping_received(uint8_t from_client_id) {
+    (void)from_client_id;
+    atomic_fetch_add_explicit(&g_pump.pings, 1, memory_order_relaxed);
+}
+
+static void pump_host(void* param) {
+    HostPump* pump = (HostPump*)param;
+    NeonMessage message;
+    while (!atomic_load_explicit(&pump->stop, memory_order_acquire)) {
+        neon_host_process_packets(pump->host);
+        unsigned long long received = 0;
+        while (neon_host_peek_message(pump->host, &message)) {
+            neon_host_release_message(pump->host);
+            received++;
+        }
+        if (received > 0) {
+            atomic_fetch_add_explicit(&pump->messages, received, memory_order_release);
+        }
+    }
+}
+
+typedef struct {
+    NeonClientHandle* client;
+    long count;
+} SenderArgs;
+
+static void send_messages(void* param) {
+    SenderArgs* args = (SenderArgs*)param;
+    uint8_t payload[MESSAGE_SIZE];
+    memset(payload, 0xAB, sizeof(payload));
+    for (long i = 0; i < args->count; i++) {
+        while (!neon_client_send_message(args->client, MESSAGE_TYPE, HOST_CLIENT_ID, payload, sizeof(payload))) {
+            neon_client_process_packets(args->client);
+        }
+        if (i % FLUSH_EVERY == FLUSH_EVERY - 1) {
+            neon_client_process_packets(args->client);
+        }
+    }
+    neon_client_process_packets(args->client);
+}
+
+static void send_pings(void* param) {
+    SenderArgs* args = (SenderArgs*)param;
+    for (long i = 0; i < args->count; i++) {
+        neon_client_send_ping(args->client);
+        if (i % FLUSH_EVERY == FLUSH_EVERY - 1) {
+            neon_client_process_packets(args->client);
+        }
+    }
+    neon_client_process_packets(args->client);
+}
+
+/* Waits until the counter reaches target or the timeout passes; returns the value reached */
+static unsigned long long await_count(atomic_ullong* counter, unsigned long long target) {
+    uint64_t deadline = now_ns() + (uint64_t)DRAIN_TIMEOUT_MS * 1000000ull;
+    unsigned long long value;
+    while ((value = atomic_load_explicit(counter, memory_order_acquire)) < target && now_ns() < deadline) {
+        sleep_ms(1);
+    }
+    return value;
+}
+
+static void bench_live(NeonClientHandle** clients, int max_threads, long iterations) {
+    SenderArgs args[MAX_THREADS];
+    void* params[MAX_THREADS];
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        unsigned long long base = atomic_load(&g_pump.messages);
+        for (int i = 0; i < threads; i++) {
+            args[i].client = clients[i];
+            args[i].count = iterations;
+            params[i] = &args[i];
+        }
+        uint64_t start = now_ns();
+        run_threads(threads, send_messages, params);
+        unsigned long long target = (unsigned long long)iterations * threads;
+        unsigned long long received = await_count(&g_pump.messages, base + target) - base;
+        report("game messages (delivered)", threads, received, now_ns() - start, "msg");
+        if (received < target) {
+            printf("  %llu of %llu messages lost or late\n", target - received, target);
+        }
+    }
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        unsigned long long base = atomic_load(&g_pump.pings);
+        long pings = iterations / 10 > 0 ? iterations / 10 : 1;
+        for (int i = 0; i < threads; i++) {
+            args[i].client = clients[i];
+            args[i].count = pings;
+            params[i] = &args[i];
+        }
+        uint64_t start = now_ns();
+        run_threads(threads, send_pings, params);
+        unsigned long long target = (unsigned long long)pings * threads;
+        unsigned long long received = await_count(&g_pump.pings, base + target) - base;
+        report("host ping callbacks", threads, received, now_ns() - start, "event");
+        if (received < target) {
+            printf("  %llu of %llu pings lost or late\n", target - received, target);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    long iterations = 100000;
+    int max_threads = 4;
+    const char* relay_addr = NULL;
+    uint32_t session_id = 4242;
+
+    if (argc > 1) {
+        iterations = atol(argv[1]);
+    }
+    if (argc > 2) {
+        max_threads = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        relay_addr = argv[3];
+    }
+    if (argc > 4) {
+        session_id = (uint32_t)atoi(argv[4]);
+    }
+    if (iterations <= 0 || max_threads <= 0 || max_threads > MAX_THREADS) {
+        fprintf(stderr, "Usage: %s [iterations] [max_threads 1-%d] [relay_addr] [session_id]\n", argv[0], MAX_THREADS);
+        return 1;
+    }
+
+    NeonRuntimeOptions runtime = {0};
+    runtime.class_path = getenv("NEON_CLASS_PATH") != NULL ? getenv("NEON_CLASS_PATH") : "target/classes";
+    runtime.cds_archive = getenv("NEON_CDS_ARCHIVE");
+    uint64_t init_start = now_ns();
+    if (!neon_runtime_init(&runtime)) {
+        fprintf(stderr, "Failed to start Java runtime: %s\n", neon_get_last_error());
+        return 1;
+    }
+    printf("=== Neon JNI Bridge Benchmark ===\n");
+    printf("runtime init: %.1f ms, iterations: %ld, max threads: %d\n\n",
+           (double)(now_ns() - init_start) / 1e6, iterations, max_threads);
+
+    NeonClientHandle* clients[MAX_THREADS];
+    for (int i = 0; i < max_threads; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "Bench%d", i);
+        clients[i] = neon_client_new(name);
+        if (clients[i] == NULL) {
+            fprintf(stderr, "Failed to create client: %s\n", neon_get_last_error());
+            return 1;
+        }
+        neon_client_set_auto_ping(clients[i], false);
+    }
+
+    bench_idle(clients, max_threads, iterations);
+
+    NeonHostHandle* host = NULL;
+    bench_thread pump_thread;
+    ThreadStart pump_start = {pump_host, &g_pump};
+
+    if (relay_addr != NULL) {
+        host = neon_host_new(session_id, relay_addr);
+        if (host == NULL || !neon_host_enable_messaging(host, 1u << 20)) {
+            fprintf(stderr, "Failed to create host: %s\n", neon_get_last_error());
+            return 1;
+        }
+        neon_host_set_ping_received_callback(host, on_ping_received);
+        /* Registers the session with the relay; the pump thread then drives the host */
+        if (!neon_host_start(host)) {
+            fprintf(stderr, "Failed to start host: %s\n", neon_get_last_error());
+            return 1;
+        }
+        g_pump.host = host;
+        if (!thread_start(&pump_thread, &pump_start)) {
+            fprintf(stderr, "Failed to start host thread\n");
+            return 1;
+        }
+        for (int i = 0; i < max_threads; i++) {
+            if (!neon_client_connect(clients[i], session_id, relay_addr)
+                    || !neon_client_enable_messaging(clients[i], 1u << 20)) {
+                fprintf(stderr, "Client %d failed to connect: %s\n", i, neon_get_last_error());
+                return 1;
+            }
+        }
+    }
+
+    bench_getters(clients[0], host, iterations * 10);
+
+    if (host != NULL) {
+        bench_live(clients, max_threads, iterations);
+        atomic_store_explicit(&g_pump.stop, true, memory_order_release);
+        thread_join(pump_thread);
+        neon_host_free(host);
+    } else {
+        printf("\n(pass a relay address to measure message throughput and callback delivery)\n");
+    }
+
+    for (int i = 0; i < max_threads; i++) {
+        neon_client_free(clients[i]);
+    }
+    neon_runtime_shutdown();
+    return 0;
+}
@@ -1,10 +1,18 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* syscall() for the futex wake-up */
+#endif
+
 #include <jni.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 #include "project_neon.h"
+#include "neon_ring.h"
+#include "neon_queue.h"
 #include "com_quietterminal_projectneon_jni_NeonClientJNI.h"
 #include "com_quietterminal_projectneon_jni_NeonHostJNI.h"
+#include "com_quietterminal_projectneon_core_SharedMemoryTransport.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -14,26 +22,132 @@
 #define THREAD_LOCAL __thread
 #endif
 
+#ifdef __linux__
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
 static JavaVM *g_jvm = NULL;
+static bool g_ownsJvm = false;
 static THREAD_LOCAL char g_error_buffer[512] = {0};
+
+/* JNIEnv of the current thread, and whether this library attached it */
+static THREAD_LOCAL JNIEnv *t_env = NULL;
+static THREAD_LOCAL bool t_attached = false;
 static jclass g_neonClientClass = NULL;
 static jclass g_neonHostClass = NULL;
-
+static jclass g_neonClientJNIClass = NULL;
+static jclass g_nativeEventQueueClass = NULL;
+
+/*
+ * Method IDs are resolved once in JNI_OnLoad and stay valid for as long as the
+ * global class references above are held, so entry points never call GetMethodID.
+ */
+static jmethodID g_clientInit = NULL;
+static jmethodID g_clientConnect = NULL;
+static jmethodID g_clientProcessPackets = NULL;
+static jmethodID g_clientSendPing = NULL;
+static jmethodID g_clientSetAutoPing = NULL;
+static jmethodID g_clientClose = NULL;
+static jmethodID g_clientPackState = NULL;
+static jmethodID g_clientSetMessageRings = NULL;
+static jmethodID g_wrapMessageRings = NULL;
+static jmethodID g_attachClientEvents = NULL;
+static jmethodID g_hostInit = NULL;
+static jmethodID g_hostStart = NULL;
+static jmethodID g_hostProcessPackets = NULL;
+static jmethodID g_hostGetClientCount = NULL;
+static jmethodID g_hostClose = NULL;
+static jmethodID g_hostSetMessageRings = NULL;
+static jmethodID g_attachHostEvents = NULL;
+
+/* Bit layout of NeonClientJNI.packState() */
+#define CLIENT_STATE_ID_MASK     0xFFLL
+#define CLIENT_STATE_HAS_ID      (1LL << 8)
+#define CLIENT_STATE_HAS_SESSION (1LL << 9)
+#define CLIENT_STATE_CONNECTED   (1LL << 10)
+
+#define MESSAGE_HEADER_SIZE 2
+#define MIN_RING_CAPACITY 4096u
+#define MAX_RING_CAPACITY (1u << 30)
+
+/*
+ * Game message rings shared with GameMessageRings on the Java side. The engine
+ * consumes incoming; outgoing messages are submitted from any thread to the native
+ * submit queue and moved into the outgoing ring by whichever thread holds flushing.
+ * Neither direction makes a JNI call.
+ */
+typedef struct NeonMessaging {
+    void *memory;
+    NeonRing outgoing;
+    NeonRing incoming;
+    NeonQueue submit;
+    int64_t flushing;
+} NeonMessaging;
+
+/* Message reserved by neon_*_begin_message on this thread, awaiting commit */
+static THREAD_LOCAL uint8_t *t_pendingRecord = NULL;
+static THREAD_LOCAL const NeonMessaging *t_pendingMessaging = NULL;
+static THREAD_LOCAL size_t t_pendingMax = 0;
+
+#define AUTO_PING_UNCHANGED (-1)
+
+#define EVENT_RING_CAPACITY (64u * 1024u)
+#define MAX_REGISTRY_ENTRIES 256
+
+/*
+ * Event queue filled by NativeEventQueue on the Java side. Records read by the last
+ * poll stay in the ring until the next one, so event strings can point into it.
+ */
+typedef struct NeonEvents {
+    void *memory;
+    NeonRing ring;
+    int64_t position;
+} NeonEvents;
+
+/*
+ * Functions that call into the JVM hold owner for their duration; a second thread
+ * entering the same handle fails instead of racing the non-thread-safe Java object.
+ */
 struct NeonClientHandle {
     jobject javaObject;
+    int64_t owner;
     PongCallback pongCallback;
     SessionConfigCallback sessionConfigCallback;
     PacketTypeRegistryCallback packetTypeRegistryCallback;
     UnhandledPacketCallback unhandledPacketCallback;
     WrongDestinationCallback wrongDestinationCallback;
+
+    /* Snapshot refreshed after connect and process_packets; getters read it without a JNI call */
+    int32_t clientId;
+    int32_t sessionId;
+    int32_t connected;
+
+    /* Requests from threads that found the handle busy, applied by the next process_packets */
+    int64_t pingRequested;
+    int64_t autoPingRequest;
+
+    NeonMessaging messaging;
+    NeonEvents events;
 };
 
 struct NeonHostHandle {
     jobject javaObject;
+    int64_t owner;
     ClientConnectCallback clientConnectCallback;
     ClientDenyCallback clientDenyCallback;
     PingReceivedCallback pingReceivedCallback;
     HostUnhandledPacketCallback unhandledPacketCallback;
+
+    /* Session ID is fixed at creation; client count is refreshed after process_packets */
+    int32_t sessionId;
+    int32_t clientCount;
+
+    NeonMessaging messaging;
+    NeonEvents events;
 };
 
 static void set_error(const char *msg) {
@@ -41,65 +155,669 @@ static void set_error(const char *msg) {
     g_error_buffer[sizeof(g_error_buffer) - 1] = '\0';
 }
 
-static JNIEnv* get_jni_env() {
-    JNIEnv *env = NULL;
-    if (g_jvm == NULL) {
-        set_error("JVM not initialized");
-        return NULL;
+/*
+ * Threads this library attaches are detached by a thread-exit destructor, so
+ * engine worker threads never leak a Java thread object.
+ */
+#ifdef _WIN32
+static DWORD g_detachKey = FLS_OUT_OF_INDEXES;
+static INIT_ONCE g_detachKeyOnce = INIT_ONCE_STATIC_INIT;
+
+static void WINAPI detach_on_exit(void *value) {
+    if (value != NULL && g_jvm != NULL) {
+        (*g_jvm)->DetachCurrentThread(g_jvm);
+    }
+}
+
+static BOOL CALLBACK create_detach_key(PINIT_ONCE once, PVOID param, PVOID *context) {
+    g_detachKey = FlsAlloc(detach_on_exit);
+    return TRUE;
+}
+
+static void set_detach_on_exit(bool enabled) {
+    InitOnceExecuteOnce(&g_detachKeyOnce, create_detach_key, NULL, NULL);
+    if (g_detachKey != FLS_OUT_OF_INDEXES) {
+        FlsSetValue(g_detachKey, enabled ? (PVOID)1 : NULL);
+    }
+}
+#else
+static pthread_key_t g_detachKey;
+static pthread_once_t g_detachKeyOnce = PTHREAD_ONCE_INIT;
+static bool g_detachKeyCreated = false;
+
+static void detach_on_exit(void *value) {
+    if (g_jvm != NULL) {
+        (*g_jvm)->DetachCurrentThread(g_jvm);
+    }
+}
+
+static void create_detach_key(void) {
+    g_detachKeyCreated = pthread_key_create(&g_detachKey, detach_on_exit) == 0;
+}
+
+static void set_detach_on_exit(bool enabled) {
+    pthread_once(&g_detachKeyOnce, create_detach_key);
+    if (g_detachKeyCreated) {
+        pthread_setspecific(g_detachKey, enabled ? (void*)1 : NULL);
+    }
+}
+#endif
+
+/*
+ * Returns the current thread's JNIEnv for vm, attaching the thread as a daemon on first use.
+ * Takes the VM explicitly so neon_runtime_init can attach before it publishes g_jvm.
+ */
+static JNIEnv* attach_env(JavaVM *vm) {
+    if (t_env != NULL) {
+        return t_env;
     }
 
-    jint result = (*g_jvm)->GetEnv(g_jvm, (void**)&env, JNI_VERSION_1_8);
+    JNIEnv *env = NULL;
+    jint result = (*vm)->GetEnv(vm, (void**)&env, JNI_VERSION_1_8);
     if (result == JNI_EDETACHED) {
-        result = (*g_jvm)->AttachCurrentThread(g_jvm, (void**)&env, NULL);
+        JavaVMAttachArgs args = { JNI_VERSION_1_8, "neon-native", NULL };
+        result = (*vm)->AttachCurrentThreadAsDaemon(vm, (void**)&env, &args);
         if (result != JNI_OK) {
             set_error("Failed to attach thread to JVM");
             return NULL;
         }
+        t_attached = true;
+        set_detach_on_exit(true);
     } else if (result != JNI_OK) {
         set_error("Failed to get JNI environment");
         return NULL;
     }
+    t_env = env;
     return env;
 }
 
+/*
+ * Returns the current thread's JNIEnv, attaching the thread as a daemon on first use.
+ * The env is cached per thread, so after the first call this is a thread-local read.
+ */
+static JNIEnv* get_jni_env() {
+    if (g_jvm == NULL) {
+        set_error("JVM not initialized");
+        return NULL;
+    }
+    return attach_env(g_jvm);
+}
+
+static jclass find_global_class(JNIEnv *env, const char *name) {
+    jclass localClass = (*env)->FindClass(env, name);
+    if (localClass == NULL) {
+        return NULL;
+    }
+    jclass globalClass = (*env)->NewGlobalRef(env, localClass);
+    (*env)->DeleteLocalRef(env, localClass);
+    return globalClass;
+}
+
+static void release_jni_cache(JNIEnv *env) {
+    if (g_neonClientClass != NULL) {
+        (*env)->DeleteGlobalRef(env, g_neonClientClass);
+        g_neonClientClass = NULL;
+    }
+    if (g_neonHostClass != NULL) {
+        (*env)->DeleteGlobalRef(env, g_neonHostClass);
+        g_neonHostClass = NULL;
+    }
+    if (g_neonClientJNIClass != NULL) {
+        (*env)->DeleteGlobalRef(env, g_neonClientJNIClass);
+        g_neonClientJNIClass = NULL;
+    }
+    if (g_nativeEventQueueClass != NULL) {
+        (*env)->DeleteGlobalRef(env, g_nativeEventQueueClass);
+        g_nativeEventQueueClass = NULL;
+    }
+}
+
+/*
+ * Resolves every class and method ID used by the entry points.
+ * Fails as a whole, so a signature mismatch surfaces at load time instead of on first call.
+ */
+static jint init_jni_cache(JNIEnv *env) {
+    /*
+     * Already resolved, or being resolved further up this thread's stack: looking up
+     * the JNI classes runs their static initializers, which may load this library again.
+     */
+    if (g_neonClientClass != NULL) {
+        return JNI_OK;
+    }
+
+    g_neonClientClass = find_global_class(env, "com/quietterminal/projectneon/client/NeonClient");
+    g_neonHostClass = find_global_class(env, "com/quietterminal/projectneon/host/NeonHost");
+    g_neonClientJNIClass = find_global_class(env, "com/quietterminal/projectneon/jni/NeonClientJNI");
+    g_nativeEventQueueClass = find_global_class(env, "com/quietterminal/projectneon/jni/NativeEventQueue");
+    if (g_neonClientClass == NULL || g_neonHostClass == NULL || g_neonClientJNIClass == NULL
+            || g_nativeEventQueueClass == NULL) {
+        goto fail;
+    }
+
+#define RESOLVE(target, lookup) do { target = (lookup); if (target == NULL) goto fail; } while (0)
+    RESOLVE(g_clientInit, (*env)->GetMethodID(env, g_neonClientClass, "<init>", "(Ljava/lang/String;)V"));
+    RESOLVE(g_clientConnect, (*env)->GetMethodID(env, g_neonClientClass, "connect", "(ILjava/lang/String;)Z"));
+    RESOLVE(g_clientProcessPackets, (*env)->GetMethodID(env, g_neonClientClass, "processPackets", "()I"));
+    RESOLVE(g_clientSendPing, (*env)->GetMethodID(env, g_neonClientClass, "sendPing", "()V"));
+    RESOLVE(g_clientSetAutoPing, (*env)->GetMethodID(env, g_neonClientClass, "setAutoPing", "(Z)V"));
+    RESOLVE(g_clientClose, (*env)->GetMethodID(env, g_neonClientClass, "close", "()V"));
+    RESOLVE(g_clientPackState, (*env)->GetStaticMethodID(env, g_neonClientJNIClass, "packState",
+        "(Lcom/quietterminal/projectneon/client/NeonClient;)J"));
+    RESOLVE(g_clientSetMessageRings, (*env)->GetMethodID(env, g_neonClientClass, "setMessageRings",
+        "(Lcom/quietterminal/projectneon/core/GameMessageRings;)V"));
+    RESOLVE(g_wrapMessageRings, (*env)->GetStaticMethodID(env, g_neonClientJNIClass, "wrapMessageRings",
+        "(Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;)Lcom/quietterminal/projectneon/core/GameMessageRings;"));
+    RESOLVE(g_attachClientEvents, (*env)->GetStaticMethodID(env, g_nativeEventQueueClass, "attach",
+        "(Lcom/quietterminal/projectneon/client/NeonClient;Ljava/nio/ByteBuffer;)Lcom/quietterminal/projectneon/jni/NativeEventQueue;"));
+    RESOLVE(g_attachHostEvents, (*env)->GetStaticMethodID(env, g_nativeEventQueueClass, "attach",
+        "(Lcom/quietterminal/projectneon/host/NeonHost;Ljava/nio/ByteBuffer;)Lcom/quietterminal/projectneon/jni/NativeEventQueue;"));
+    RESOLVE(g_hostInit, (*env)->GetMethodID(env, g_neonHostClass, "<init>", "(ILjava/lang/String;)V"));
+    RESOLVE(g_hostStart, (*env)->GetMethodID(env, g_neonHostClass, "start", "()V"));
+    RESOLVE(g_hostProcessPackets, (*env)->GetMethodID(env, g_neonHostClass, "processPackets", "()I"));
+    RESOLVE(g_hostGetClientCount, (*env)->GetMethodID(env, g_neonHostClass, "getClientCount", "()I"));
+    RESOLVE(g_hostClose, (*env)->GetMethodID(env, g_neonHostClass, "close", "()V"));
+    RESOLVE(g_hostSetMessageRings, (*env)->GetMethodID(env, g_neonHostClass, "setMessageRings",
+        "(Lcom/quietterminal/projectneon/core/GameMessageRings;)V"));
+#undef RESOLVE
+    return JNI_OK;
+
+fail:
+    (*env)->ExceptionDescribe(env);
+    (*env)->ExceptionClear(env);
+    release_jni_cache(env);
+    return JNI_ERR;
+}
+
+/* Clears a pending Java exception, recording it as the last error. Returns true if one was pending. */
+static bool check_exception(JNIEnv *env, const char *msg) {
+    if (!(*env)->ExceptionCheck(env)) {
+        return false;
+    }
+    (*env)->ExceptionDescribe(env);
+    (*env)->ExceptionClear(env);
+    set_error(msg);
+    return true;
+}
+
+static void refresh_client_state(JNIEnv *env, NeonClientHandle *handle) {
+    jlong state = (*env)->CallStaticLongMethod(env, g_neonClientJNIClass, g_clientPackState, handle->javaObject);
+    if (check_exception(env, "Exception reading client state")) {
+        return;
+    }
+    neon_store_release32(&handle->clientId, (state & CLIENT_STATE_HAS_ID) ? (int32_t)(state & CLIENT_STATE_ID_MASK) : -1);
+    neon_store_release32(&handle->sessionId, (state & CLIENT_STATE_HAS_SESSION) ? (int32_t)(state >> 32) : -1);
+    neon_store_release32(&handle->connected, (state & CLIENT_STATE_CONNECTED) != 0);
+}
+
+static bool handle_enter(int64_t *owner) {
+    if (!neon_cas64(owner, 0, 1)) {
+        set_error("Handle is in use on another thread");
+        return false;
+    }
+    return true;
+}
+
+static void handle_exit(int64_t *owner) {
+    neon_ring_store_release(owner, 0);
+}
+
+/*
+ * Allocates both rings in one block, wraps them in direct ByteBuffers and hands them to
+ * the Java object through its setMessageRings method. Called once; every message after
+ * that goes through the rings without crossing into the JVM.
+ */
+static bool messaging_enable(JNIEnv *env, NeonMessaging *messaging, jobject target, jmethodID setter, jint requested) {
+    if (messaging->memory != NULL) {
+        set_error("Messaging already enabled");
+        return false;
+    }
+    if (requested <= 0 || (uint32_t)requested > MAX_RING_CAPACITY) {
+        set_error("Invalid ring capacity");
+        return false;
+    }
+
+    uint32_t capacity = MIN_RING_CAPACITY;
+    while (capacity < (uint32_t)requested) {
+        capacity <<= 1;
+    }
+    size_t ringSize = NEON_RING_HEADER_SIZE + (size_t)capacity;
+    uint8_t *memory = (uint8_t*)calloc(1, 2 * ringSize + capacity);
+    if (memory == NULL) {
+        set_error("Failed to allocate message rings");
+        return false;
+    }
+
+    jobject outgoing = (*env)->NewDirectByteBuffer(env, memory, (jlong)ringSize);
+    jobject incoming = outgoing != NULL ? (*env)->NewDirectByteBuffer(env, memory + ringSize, (jlong)ringSize) : NULL;
+    jobject rings = NULL;
+    bool attached = false;
+    if (outgoing == NULL || incoming == NULL) {
+        (*env)->ExceptionClear(env);
+        set_error("Direct buffer access is not supported by this JVM");
+    } else {
+        rings = (*env)->CallStaticObjectMethod(env, g_neonClientJNIClass, g_wrapMessageRings, outgoing, incoming);
+        if (!check_exception(env, "Failed to create message rings")) {
+            (*env)->CallVoidMethod(env, target, setter, rings);
+            attached = !check_exception(env, "Failed to attach message rings");
+        }
+    }
+
+    (*env)->DeleteLocalRef(env, outgoing);
+    (*env)->DeleteLocalRef(env, incoming);
+    (*env)->DeleteLocalRef(env, rings);
+    if (!attached) {
+        free(memory);
+        return false;
+    }
+
+    neon_ring_attach(&messaging->outgoing, memory, capacity);
+    neon_ring_attach(&messaging->incoming, memory + ringSize, capacity);
+    neon_queue_init(&messaging->submit, memory + 2 * ringSize, capacity);
+    messaging->flushing = 0;
+    messaging->memory = memory;
+    return true;
+}
+
+/* Detaches the rings from the Java object before their memory is freed */
+static void messaging_release(JNIEnv *env, NeonMessaging *messaging, jobject target, jmethodID setter) {
+    if (messaging->memory == NULL) {
+        return;
+    }
+    (*env)->CallVoidMethod(env, target, setter, NULL);
+    if ((*env)->ExceptionCheck(env)) {
+        (*env)->ExceptionClear(env);
+    }
+    free(messaging->memory);
+    messaging->memory = NULL;
+}
+
+/*
+ * Moves committed messages from the submit queue into the outgoing ring. Only one thread
+ * flushes at a time; a thread that finds another flushing leaves its message to it. After
+ * letting go, the flusher probes the queue again so a message committed meanwhile is not
+ * stranded. The probe must not consume: peeking is reserved for the flag holder.
+ * Messages that do not fit in the ring wait for the next flush.
+ */
+static void messaging_flush(NeonMessaging *messaging) {
+    while (neon_cas64(&messaging->flushing, 0, 1)) {
+        bool ringFull = false;
+        uint32_t length;
+        const uint8_t *message;
+        while ((message = neon_queue_peek(&messaging->submit, &length)) != NULL) {
+            uint8_t *record = neon_ring_reserve(&messaging->outgoing, length);
+            if (record == NULL) {
+                ringFull = true;
+                break;
+            }
+            memcpy(record, message, length);
+            neon_ring_commit(&messaging->outgoing, length);
+            neon_queue_release(&messaging->submit);
+        }
+        neon_exchange64(&messaging->flushing, 0);
+        if (ringFull || !neon_queue_pending(&messaging->submit)) {
+            return;
+        }
+    }
+}
+
+static uint32_t messaging_max_length(const NeonMessaging *messaging) {
+    uint32_t queueMax = neon_queue_max_record(&messaging->submit);
+    uint32_t ringMax = neon_ring_max_record(&messaging->outgoing);
+    return (queueMax < ringMax ? queueMax : ringMax) - MESSAGE_HEADER_SIZE;
+}
+
+static uint8_t* messaging_begin(NeonMessaging *messaging, size_t max_length) {
+    if (messaging->memory == NULL) {
+        set_error("Messaging not enabled");
+        return NULL;
+    }
+    if (t_pendingRecord != NULL) {
+        set_error("Previous message on this thread not committed");
+        return NULL;
+    }
+    if (max_length > messaging_max_length(messaging)) {
+        set_error("Message too large for ring");
+        return NULL;
+    }
+    uint8_t *record = neon_queue_claim(&messaging->submit, (uint32_t)(max_length + MESSAGE_HEADER_SIZE));
+    if (record == NULL) {
+        messaging_flush(messaging);
+        set_error("Send ring full");
+        return NULL;
+    }
+    t_pendingRecord = record;
+    t_pendingMessaging = messaging;
+    t_pendingMax = max_length;
+    return record + MESSAGE_HEADER_SIZE;
+}
+
+static bool messaging_commit(NeonMessaging *messaging, uint8_t packet_type, uint8_t destination_id, size_t length) {
+    if (t_pendingRecord == NULL || t_pendingMessaging != messaging || length > t_pendingMax) {
+        set_error("No message reserved for this length");
+        return false;
+    }
+    t_pendingRecord[0] = packet_type;
+    t_pendingRecord[1] = destination_id;
+    neon_queue_commit(t_pendingRecord, (uint32_t)(length + MESSAGE_HEADER_SIZE));
+    t_pendingRecord = NULL;
+    t_pendingMessaging = NULL;
+    messaging_flush(messaging);
+    return true;
+}
+
+static bool messaging_send(NeonMessaging *messaging, uint8_t packet_type, uint8_t destination_id, const void *data, size_t length) {
+    uint8_t *payload = messaging_begin(messaging, length);
+    if (payload == NULL) {
+        return false;
+    }
+    if (length > 0) {
+        memcpy(payload, data, length);
+    }
+    return messaging_commit(messaging, packet_type, destination_id, length);
+}
+
+static bool messaging_peek(NeonMessaging *messaging, NeonMessage *message) {
+    if (messaging->memory == NULL || message == NULL) {
+        return false;
+    }
+    uint32_t length;
+    const uint8_t *record = neon_ring_peek(&messaging->incoming, &length);
+    if (record == NULL) {
+        return false;
+    }
+    message->packet_type = record[0];
+    message->peer_id = record[1];
+    message->length = length - MESSAGE_HEADER_SIZE;
+    message->data = record + MESSAGE_HEADER_SIZE;
+    return true;
+}
+
+static void messaging_next(NeonMessaging *messaging) {
+    uint32_t length;
+    if (messaging->memory != NULL && neon_ring_peek(&messaging->incoming, &length) != NULL) {
+        neon_ring_release(&messaging->incoming);
+    }
+}
+
+/* Allocates the event ring and routes the Java object's callbacks into it */
+static bool events_init(JNIEnv *env, NeonEvents *events, jobject target, jmethodID attach) {
+    size_t ringSize = NEON_RING_HEADER_SIZE + (size_t)EVENT_RING_CAPACITY;
+    void *memory = calloc(1, ringSize);
+    if (memory == NULL) {
+        set_error("Failed to allocate event queue");
+        return false;
+    }
+
+    jobject buffer = (*env)->NewDirectByteBuffer(env, memory, (jlong)ringSize);
+    if (buffer == NULL) {
+        (*env)->ExceptionClear(env);
+        set_error("Direct buffer access is not supported by this JVM");
+        free(memory);
+        return false;
+    }
+    jobject queue = (*env)->CallStaticObjectMethod(env, g_nativeEventQueueClass, attach, target, buffer);
+    (*env)->DeleteLocalRef(env, buffer);
+    (*env)->DeleteLocalRef(env, queue);
+    if (check_exception(env, "Failed to create event queue")) {
+        free(memory);
+        return false;
+    }
+
+    neon_ring_attach(&events->ring, memory, EVENT_RING_CAPACITY);
+    events->position = 0;
+    events->memory = memory;
+    return true;
+}
+
+static const char* read_event_string(const uint8_t **cursor, const uint8_t *end) {
+    const uint8_t *terminator = memchr(*cursor, '\0', (size_t)(end - *cursor));
+    if (terminator == NULL) {
+        return NULL;
+    }
+    const char *value = (const char*)*cursor;
+    *cursor = terminator + 1;
+    return value;
+}
+
+/* Decodes one NativeEventQueue record; the layout must match the Java encoder */
+static bool decode_event(const uint8_t *record, uint32_t length, NeonEvent *event) {
+    const uint8_t *end = record + length;
+    const uint8_t *p = record + 1;
+    if (length < 1) {
+        return false;
+    }
+
+#define NEED(bytes) do { if ((size_t)(end - p) < (bytes)) return false; } while (0)
+    event->type = (NeonEventType)record[0];
+    switch (record[0]) {
+        case NEON_EVENT_PONG:
+            NEED(16);
+            memcpy(&event->data.pong.response_time_ms, p, 8);
+            memcpy(&event->data.pong.original_timestamp, p + 8, 8);
+            return true;
+        case NEON_EVENT_SESSION_CONFIG:
+            NEED(5);
+            event->data.session_config.version = p[0];
+            memcpy(&event->data.session_config.tick_rate, p + 1, 2);
+            memcpy(&event->data.session_config.max_packet_size, p + 3, 2);
+            return true;
+        case NEON_EVENT_PACKET_TYPE:
+            NEED(1);
+            event->data.packet_type.id = *p++;
+            event->data.packet_type.name = read_event_string(&p, end);
+            event->data.packet_type.description = event->data.packet_type.name != NULL ? read_event_string(&p, end) : NULL;
+            return event->data.packet_type.description != NULL;
+        case NEON_EVENT_UNHANDLED_PACKET:
+            NEED(2);
+            event->data.unhandled_packet.packet_type = p[0];
+            event->data.unhandled_packet.from_client_id = p[1];
+            return true;
+        case NEON_EVENT_WRONG_DESTINATION:
+            NEED(2);
+            event->data.wrong_destination.my_id = p[0];
+            event->data.wrong_destination.packet_destination_id = p[1];
+            return true;
+        case NEON_EVENT_DISCONNECT:
+        case NEON_EVENT_CLIENT_DISCONNECT:
+            NEED(1);
+            event->data.disconnect.client_id = p[0];
+            return true;
+        case NEON_EVENT_PING_RECEIVED:
+            NEED(1);
+            event->data.ping_received.from_client_id = p[0];
+            return true;
+        case NEON_EVENT_CLIENT_CONNECT:
+            NEED(5);
+            event->data.client_connect.client_id = p[0];
+            memcpy(&event->data.client_connect.session_id, p + 1, 4);
+            p += 5;
+            event->data.client_connect.name = read_event_string(&p, end);
+            return event->data.client_connect.name != NULL;
+        case NEON_EVENT_CLIENT_DENY:
+            event->data.client_deny.name = read_event_string(&p, end);
+            event->data.client_deny.reason = event->data.client_deny.name != NULL ? read_event_string(&p, end) : NULL;
+            return event->data.client_deny.reason != NULL;
+        default:
+            return false;
+    }
+#undef NEED
+}
+
+/* Reads the next decodable event after the current batch, skipping malformed records */
+static bool events_next(NeonEvents *events, NeonEvent *event) {
+    uint32_t length;
+    const uint8_t *record;
+    while ((record = neon_ring_read_at(&events->ring, &events->position, &length)) != NULL) {
+        if (decode_event(record, length, event)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static size_t events_poll(NeonEvents *events, NeonEvent *out, size_t max) {
+    if (events->memory == NULL || out == NULL) {
+        return 0;
+    }
+    neon_ring_release_to(&events->ring, events->position);
+    size_t count = 0;
+    while (count < max && events_next(events, &out[count])) {
+        count++;
+    }
+    return count;
+}
+
+/* Carries out ping and auto-ping calls made while another thread held the handle */
+static void apply_client_requests(JNIEnv *env, NeonClientHandle *handle) {
+    int64_t autoPing = neon_exchange64(&handle->autoPingRequest, AUTO_PING_UNCHANGED);
+    if (autoPing != AUTO_PING_UNCHANGED) {
+        (*env)->CallVoidMethod(env, handle->javaObject, g_clientSetAutoPing, autoPing ? JNI_TRUE : JNI_FALSE);
+        check_exception(env, "Exception during setAutoPing");
+    }
+    if (neon_exchange64(&handle->pingRequested, 0) != 0) {
+        (*env)->CallVoidMethod(env, handle->javaObject, g_clientSendPing);
+        check_exception(env, "Exception during sendPing");
+    }
+}
+
+static bool client_has_callbacks(const NeonClientHandle *handle) {
+    return handle->pongCallback != NULL || handle->sessionConfigCallback != NULL
+        || handle->packetTypeRegistryCallback != NULL || handle->unhandledPacketCallback != NULL
+        || handle->wrongDestinationCallback != NULL;
+}
+
+static bool host_has_callbacks(const NeonHostHandle *handle) {
+    return handle->clientConnectCallback != NULL || handle->clientDenyCallback != NULL
+        || handle->pingReceivedCallback != NULL || handle->unhandledPacketCallback != NULL;
+}
+
+/*
+ * Delivers every queued event to the registered callbacks. Consecutive packet type
+ * events are gathered into one registry callback, as the registry arrives in one packet.
+ */
+static void dispatch_client_events(NeonClientHandle *handle) {
+    NeonEvents *events = &handle->events;
+    if (events->memory == NULL || !client_has_callbacks(handle)) {
+        return;
+    }
+
+    uint8_t ids[MAX_REGISTRY_ENTRIES];
+    const char *names[MAX_REGISTRY_ENTRIES];
+    const char *descriptions[MAX_REGISTRY_ENTRIES];
+    size_t entries = 0;
+    NeonEvent event;
+
+    neon_ring_release_to(&events->ring, events->position);
+    for (;;) {
+        bool more = events_next(events, &event);
+        if (entries > 0 && (!more || event.type != NEON_EVENT_PACKET_TYPE || entries == MAX_REGISTRY_ENTRIES)) {
+            if (handle->packetTypeRegistryCallback != NULL) {
+                handle->packetTypeRegistryCallback(entries, ids, names, descriptions);
+            }
+            entries = 0;
+        }
+        if (!more) {
+            break;
+        }
+
+        switch (event.type) {
+            case NEON_EVENT_PONG:
+                if (handle->pongCallback != NULL) {
+                    handle->pongCallback(event.data.pong.response_time_ms, event.data.pong.original_timestamp);
+                }
+                break;
+            case NEON_EVENT_SESSION_CONFIG:
+                if (handle->sessionConfigCallback != NULL) {
+                    handle->sessionConfigCallback(event.data.session_config.version,
+                        event.data.session_config.tick_rate, event.data.session_config.max_packet_size);
+                }
+                break;
+            case NEON_EVENT_PACKET_TYPE:
+                ids[entries] = event.data.packet_type.id;
+                names[entries] = event.data.packet_type.name;
+                descriptions[entries] = event.data.packet_type.description;
+                entries++;
+                break;
+            case NEON_EVENT_UNHANDLED_PACKET:
+                if (handle->unhandledPacketCallback != NULL) {
+                    handle->unhandledPacketCallback(event.data.unhandled_packet.packet_type,
+                        event.data.unhandled_packet.from_client_id);
+                }
+                break;
+            case NEON_EVENT_WRONG_DESTINATION:
+                if (handle->wrongDestinationCallback != NULL) {
+                    handle->wrongDestinationCallback(event.data.wrong_destination.my_id,
+                        event.data.wrong_destination.packet_destination_id);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    neon_ring_release_to(&events->ring, events->position);
+}
+
+static void dispatch_host_events(NeonHostHandle *handle) {
+    NeonEvents *events = &handle->events;
+    if (events->memory == NULL || !host_has_callbacks(handle)) {
+        return;
+    }
+
+    NeonEvent event;
+    neon_ring_release_to(&events->ring, events->position);
+    while (events_next(events, &event)) {
+        switch (event.type) {
+            case NEON_EVENT_CLIENT_CONNECT:
+                if (handle->clientConnectCallback != NULL) {
+                    handle->clientConnectCallback(event.data.client_connect.client_id,
+                        event.data.client_connect.name, event.data.client_connect.session_id);
+                }
+                break;
+            case NEON_EVENT_CLIENT_DENY:
+                if (handle->clientDenyCallback != NULL) {
+                    handle->clientDenyCallback(event.data.client_deny.name, event.data.client_deny.reason);
+                }
+                break;
+            case NEON_EVENT_PING_RECEIVED:
+                if (handle->pingReceivedCallback != NULL) {
+                    handle->pingReceivedCallback(event.data.ping_received.from_client_id);
+                }
+                break;
+            case NEON_EVENT_UNHANDLED_PACKET:
+                if (handle->unhandledPacketCallback != NULL) {
+                    handle->unhandledPacketCallback(event.data.unhandled_packet.packet_type,
+                        event.data.unhandled_packet.from_client_id);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    neon_ring_release_to(&events->ring, events->position);
+}
+
 JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved) {
-    g_jvm = vm;
     JNIEnv *env;
 
     if ((*vm)->GetEnv(vm, (void**)&env, JNI_VERSION_1_8) != JNI_OK) {
         return JNI_ERR;
     }
 
-    jclass localClientClass = (*env)->FindClass(env, "com/quietterminal/projectneon/client/NeonClient");
-    if (localClientClass == NULL) {
+    if (init_jni_cache(env) != JNI_OK) {
         return JNI_ERR;
     }
-    g_neonClientClass = (*env)->NewGlobalRef(env, localClientClass);
-    (*env)->DeleteLocalRef(env, localClientClass);
-
-    jclass localHostClass = (*env)->FindClass(env, "com/quietterminal/projectneon/host/NeonHost");
-    if (localHostClass == NULL) {
-        return JNI_ERR;
-    }
-    g_neonHostClass = (*env)->NewGlobalRef(env, localHostClass);
-    (*env)->DeleteLocalRef(env, localHostClass);
 
+    g_jvm = vm;
     return JNI_VERSION_1_8;
 }
 
 JNIEXPORT void JNICALL JNI_OnUnload(JavaVM *vm, void *reserved) {
     JNIEnv *env;
     if ((*vm)->GetEnv(vm, (void**)&env, JNI_VERSION_1_8) == JNI_OK) {
-        if (g_neonClientClass != NULL) {
-            (*env)->DeleteGlobalRef(env, g_neonClientClass);
-            g_neonClientClass = NULL;
-        }
-        if (g_neonHostClass != NULL) {
-            (*env)->DeleteGlobalRef(env, g_neonHostClass);
-            g_neonHostClass = NULL;
-        }
+        release_jni_cache(env);
     }
     g_jvm = NULL;
+    t_env = NULL;
 }
 
 JNIEXPORT jlong JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_neonClientNew(JNIEnv *env, jclass cls, jstring name) {
@@ -108,43 +826,42 @@ JNIEXPORT jlong JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_neo
         return 0;
     }
 
-    const char *nameStr = (*env)->GetStringUTFChars(env, name, NULL);
-    if (nameStr == NULL) {
-        set_error("Failed to get client name string");
-        return 0;
-    }
-
-    jmethodID constructor = (*env)->GetMethodID(env, g_neonClientClass, "<init>", "(Ljava/lang/String;)V");
-    if (constructor == NULL) {
-        (*env)->ReleaseStringUTFChars(env, name, nameStr);
-        set_error("Failed to find NeonClient constructor");
-        return 0;
-    }
-
-    jobject clientObj = (*env)->NewObject(env, g_neonClientClass, constructor, name);
-    if (clientObj == NULL) {
-        (*env)->ReleaseStringUTFChars(env, name, nameStr);
-        set_error("Failed to create NeonClient instance");
+    jobject clientObj = (*env)->NewObject(env, g_neonClientClass, g_clientInit, name);
+    if (check_exception(env, "Failed to create NeonClient instance") || clientObj == NULL) {
         return 0;
     }
 
     NeonClientHandle *handle = (NeonClientHandle*)malloc(sizeof(NeonClientHandle));
     if (handle == NULL) {
         (*env)->DeleteLocalRef(env, clientObj);
-        (*env)->ReleaseStringUTFChars(env, name, nameStr);
         set_error("Failed to allocate client handle");
         return 0;
     }
 
     handle->javaObject = (*env)->NewGlobalRef(env, clientObj);
+    handle->owner = 0;
     handle->pongCallback = NULL;
     handle->sessionConfigCallback = NULL;
     handle->packetTypeRegistryCallback = NULL;
     handle->unhandledPacketCallback = NULL;
     handle->wrongDestinationCallback = NULL;
+    handle->clientId = -1;
+    handle->sessionId = -1;
+    handle->connected = 0;
+    handle->pingRequested = 0;
+    handle->autoPingRequest = AUTO_PING_UNCHANGED;
+    memset(&handle->messaging, 0, sizeof(handle->messaging));
+    memset(&handle->events, 0, sizeof(handle->events));
 
     (*env)->DeleteLocalRef(env, clientObj);
-    (*env)->ReleaseStringUTFChars(env, name, nameStr);
+
+    if (!events_init(env, &handle->events, handle->javaObject, g_attachClientEvents)) {
+        (*env)->CallVoidMethod(env, handle->javaObject, g_clientClose);
+        (*env)->ExceptionClear(env);
+        (*env)->DeleteGlobalRef(env, handle->javaObject);
+        free(handle);
+        return 0;
+    }
 
     return (jlong)(intptr_t)handle;
 }
@@ -154,50 +871,28 @@ JNIEXPORT jboolean JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_
         set_error("Invalid client handle");
         return JNI_FALSE;
     }
-
-    NeonClientHandle *handle = (NeonClientHandle*)(intptr_t)clientPtr;
-
-    const char *addrStr = (*env)->GetStringUTFChars(env, relayAddr, NULL);
-    if (addrStr == NULL) {
-        set_error("Failed to get relay address string");
-        return JNI_FALSE;
-    }
-
-    char host[256];
-    int port;
-    if (sscanf(addrStr, "%255[^:]:%d", host, &port) != 2) {
-        (*env)->ReleaseStringUTFChars(env, relayAddr, addrStr);
-        set_error("Invalid relay address format (expected host:port)");
+    if (relayAddr == NULL) {
+        set_error("Relay address cannot be null");
         return JNI_FALSE;
     }
 
-    jmethodID connectMethod = (*env)->GetMethodID(env, g_neonClientClass, "connect", "(ILjava/lang/String;I)V");
-    if (connectMethod == NULL) {
-        (*env)->ReleaseStringUTFChars(env, relayAddr, addrStr);
-        set_error("Failed to find connect method");
+    NeonClientHandle *handle = (NeonClientHandle*)(intptr_t)clientPtr;
+    if (!handle_enter(&handle->owner)) {
         return JNI_FALSE;
     }
 
-    jstring hostStr = (*env)->NewStringUTF(env, host);
-    if (hostStr == NULL) {
-        (*env)->ReleaseStringUTFChars(env, relayAddr, addrStr);
-        set_error("Failed to create host string");
+    jboolean connected = (*env)->CallBooleanMethod(env, handle->javaObject, g_clientConnect, sessionId, relayAddr);
+    if (check_exception(env, "Exception during connect")) {
+        handle_exit(&handle->owner);
         return JNI_FALSE;
     }
 
-    (*env)->CallVoidMethod(env, handle->javaObject, connectMethod, sessionId, hostStr, port);
-
-    (*env)->DeleteLocalRef(env, hostStr);
-    (*env)->ReleaseStringUTFChars(env, relayAddr, addrStr);
-
-    if ((*env)->ExceptionCheck(env)) {
-        (*env)->ExceptionDescribe(env);
-        (*env)->ExceptionClear(env);
-        set_error("Exception during connect");
-        return JNI_FALSE;
+    refresh_client_state(env, handle);
+    handle_exit(&handle->owner);
+    if (!connected) {
+        set_error("Connection denied");
     }
-
-    return JNI_TRUE;
+    return connected;
 }
 
 JNIEXPORT jint JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_neonClientProcessPackets(JNIEnv *env, jclass cls, jlong clientPtr) {
@@ -207,40 +902,35 @@ JNIEXPORT jint JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_neon
     }
 
     NeonClientHandle *handle = (NeonClientHandle*)(intptr_t)clientPtr;
-
-    jmethodID processMethod = (*env)->GetMethodID(env, g_neonClientClass, "processPackets", "()I");
-    if (processMethod == NULL) {
-        set_error("Failed to find processPackets method");
+    if (!handle_enter(&handle->owner)) {
         return -1;
     }
 
-    jint result = (*env)->CallIntMethod(env, handle->javaObject, processMethod);
-
-    if ((*env)->ExceptionCheck(env)) {
-        (*env)->ExceptionDescribe(env);
-        (*env)->ExceptionClear(env);
-        set_error("Exception during processPackets");
+    apply_client_requests(env, handle);
+    messaging_flush(&handle->messaging);
+    jint result = (*env)->CallIntMethod(env, handle->javaObject, g_clientProcessPackets);
+    if (check_exception(env, "Exception during processPackets")) {
+        handle_exit(&handle->owner);
         return -1;
     }
 
+    refresh_client_state(env, handle);
+    dispatch_client_events(handle);
+    handle_exit(&handle->owner);
     return result;
 }
 
+/*
+ * Trivial getters read the handle's state snapshot and make no JNI calls, the closest
+ * equivalent to critical natives now that the JDK no longer supports them.
+ */
 JNIEXPORT jint JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_neonClientGetId(JNIEnv *env, jclass cls, jlong clientPtr) {
     if (clientPtr == 0) {
         set_error("Invalid client handle");
         return -1;
     }
 
-    NeonClientHandle *handle = (NeonClientHandle*)(intptr_t)clientPtr;
-
-    jmethodID getIdMethod = (*env)->GetMethodID(env, g_neonClientClass, "getClientId", "()I");
-    if (getIdMethod == NULL) {
-        set_error("Failed to find getClientId method");
-        return -1;
-    }
-
-    return (*env)->CallIntMethod(env, handle->javaObject, getIdMethod);
+    return neon_load_acquire32(&((NeonClientHandle*)(intptr_t)clientPtr)->clientId);
 }
 
 JNIEXPORT jint JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_neonClientGetSessionId(JNIEnv *env, jclass cls, jlong clientPtr) {
@@ -249,15 +939,7 @@ JNIEXPORT jint JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_neon
         return -1;
     }
 
-    NeonClientHandle *handle = (NeonClientHandle*)(intptr_t)clientPtr;
-
-    jmethodID getSessionMethod = (*env)->GetMethodID(env, g_neonClientClass, "getSessionId", "()I");
-    if (getSessionMethod == NULL) {
-        set_error("Failed to find getSessionId method");
-        return -1;
-    }
-
-    return (*env)->CallIntMethod(env, handle->javaObject, getSessionMethod);
+    return neon_load_acquire32(&((NeonClientHandle*)(intptr_t)clientPtr)->sessionId);
 }
 
 JNIEXPORT jboolean JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_neonClientIsConnected(JNIEnv *env, jclass cls, jlong clientPtr) {
@@ -265,14 +947,7 @@ JNIEXPORT jboolean JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_
         return JNI_FALSE;
     }
 
-    NeonClientHandle *handle = (NeonClientHandle*)(intptr_t)clientPtr;
-
-    jmethodID isConnectedMethod = (*env)->GetMethodID(env, g_neonClientClass, "isConnected", "()Z");
-    if (isConnectedMethod == NULL) {
-        return JNI_FALSE;
-    }
-
-    return (*env)->CallBooleanMethod(env, handle->javaObject, isConnectedMethod);
+    return neon_load_acquire32(&((NeonClientHandle*)(intptr_t)clientPtr)->connected) ? JNI_TRUE : JNI_FALSE;
 }
 
 JNIEXPORT jboolean JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_neonClientSendPing(JNIEnv *env, jclass cls, jlong clientPtr) {
@@ -282,23 +957,15 @@ JNIEXPORT jboolean JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_
     }
 
     NeonClientHandle *handle = (NeonClientHandle*)(intptr_t)clientPtr;
-
-    jmethodID sendPingMethod = (*env)->GetMethodID(env, g_neonClientClass, "sendPing", "()V");
-    if (sendPingMethod == NULL) {
-        set_error("Failed to find sendPing method");
-        return JNI_FALSE;
-    }
-
-    (*env)->CallVoidMethod(env, handle->javaObject, sendPingMethod);
-
-    if ((*env)->ExceptionCheck(env)) {
-        (*env)->ExceptionDescribe(env);
-        (*env)->ExceptionClear(env);
-        set_error("Exception during sendPing");
-        return JNI_FALSE;
+    if (!neon_cas64(&handle->owner, 0, 1)) {
+        neon_exchange64(&handle->pingRequested, 1);
+        return JNI_TRUE;
     }
 
-    return JNI_TRUE;
+    (*env)->CallVoidMethod(env, handle->javaObject, g_clientSendPing);
+    bool failed = check_exception(env, "Exception during sendPing");
+    handle_exit(&handle->owner);
+    return failed ? JNI_FALSE : JNI_TRUE;
 }
 
 JNIEXPORT void JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_neonClientSetAutoPing(JNIEnv *env, jclass cls, jlong clientPtr, jboolean enabled) {
@@ -308,14 +975,15 @@ JNIEXPORT void JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_neon
     }
 
     NeonClientHandle *handle = (NeonClientHandle*)(intptr_t)clientPtr;
-
-    jmethodID setAutoPingMethod = (*env)->GetMethodID(env, g_neonClientClass, "setAutoPing", "(Z)V");
-    if (setAutoPingMethod == NULL) {
-        set_error("Failed to find setAutoPing method");
+    if (!neon_cas64(&handle->owner, 0, 1)) {
+        neon_exchange64(&handle->autoPingRequest, enabled ? 1 : 0);
         return;
     }
 
-    (*env)->CallVoidMethod(env, handle->javaObject, setAutoPingMethod, enabled);
+    neon_exchange64(&handle->autoPingRequest, AUTO_PING_UNCHANGED);
+    (*env)->CallVoidMethod(env, handle->javaObject, g_clientSetAutoPing, enabled);
+    check_exception(env, "Exception during setAutoPing");
+    handle_exit(&handle->owner);
 }
 
 JNIEXPORT void JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_neonClientSetPongCallback(JNIEnv *env, jclass cls, jlong clientPtr, jlong callback) {
@@ -368,20 +1036,37 @@ JNIEXPORT void JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_neon
     handle->wrongDestinationCallback = (WrongDestinationCallback)(intptr_t)callback;
 }
 
+JNIEXPORT jboolean JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_neonClientEnableMessaging(JNIEnv *env, jclass cls, jlong clientPtr, jint ringCapacity) {
+    if (clientPtr == 0) {
+        set_error("Invalid client handle");
+        return JNI_FALSE;
+    }
+
+    NeonClientHandle *handle = (NeonClientHandle*)(intptr_t)clientPtr;
+    if (!handle_enter(&handle->owner)) {
+        return JNI_FALSE;
+    }
+    bool enabled = messaging_enable(env, &handle->messaging, handle->javaObject, g_clientSetMessageRings, ringCapacity);
+    handle_exit(&handle->owner);
+    return enabled ? JNI_TRUE : JNI_FALSE;
+}
+
 JNIEXPORT void JNICALL Java_com_quietterminal_projectneon_jni_NeonClientJNI_neonClientFree(JNIEnv *env, jclass cls, jlong clientPtr) {
     if (clientPtr == 0) {
         return;
     }
 
     NeonClientHandle *handle = (NeonClientHandle*)(intptr_t)clientPtr;
+    if (!handle_enter(&handle->owner)) {
+        return;
+    }
 
-    jmethodID closeMethod = (*env)->GetMethodID(env, g_neonClientClass, "close", "()V");
-    if (closeMethod != NULL) {
-        (*env)->CallVoidMethod(env, handle->javaObject, closeMethod);
-        if ((*env)->ExceptionCheck(env)) {
-            (*env)->ExceptionClear(env);
-        }
+    (*env)->CallVoidMethod(env, handle->javaObject, g_clientClose);
+    if ((*env)->ExceptionCheck(env)) {
+        (*env)->ExceptionClear(env);
     }
+    messaging_release(env, &handle->messaging, handle->javaObject, g_clientSetMessageRings);
+    free(handle->events.memory);
 
     (*env)->DeleteGlobalRef(env, handle->javaObject);
     free(handle);
@@ -400,40 +1085,8 @@ JNIEXPORT jlong JNICALL Java_com_quietterminal_projectneon_jni_NeonHostJNI_neonH
         return 0;
     }
 
-    const char *addrStr = (*env)->GetStringUTFChars(env, relayAddr, NULL);
-    if (addrStr == NULL) {
-        set_error("Failed to get relay address string");
-        return 0;
-    }
-
-    char host[256];
-    int port;
-    if (sscanf(addrStr, "%255[^:]:%d", host, &port) != 2) {
-        (*env)->ReleaseStringUTFChars(env, relayAddr, addrStr);
-        set_error("Invalid relay address format (expected host:port)");
-        return 0;
-    }
-
-    jmethodID constructor = (*env)->GetMethodID(env, g_neonHostClass, "<init>", "(ILjava/lang/String;I)V");
-    if (constructor == NULL) {
-        (*env)->ReleaseStringUTFChars(env, relayAddr, addrStr);
-        set_error("Failed to find NeonHost constructor");
-        return 0;
-    }
-
-    jstring hostStr = (*env)->NewStringUTF(env, host);
-    if (hostStr == NULL) {
-        (*env)->ReleaseStringUTFChars(env, relayAddr, addrStr);
-        set_error("Failed to create host string");
-        return 0;
-    }
-
-    jobject hostObj = (*env)->NewObject(env, g_neonHostClass, constructor, sessionId, hostStr, port);
-    (*env)->DeleteLocalRef(env, hostStr);
-    (*env)->ReleaseStringUTFChars(env, relayAddr, addrStr);
-
-    if (hostObj == NULL) {
-        set_error("Failed to create NeonHost instance");
+    jobject hostObj = (*env)->NewObject(env, g_neonHostClass, g_hostInit, sessionId, relayAddr);
+    if (check_exception(env, "Failed to create NeonHost instance") || hostObj == NULL) {
         return 0;
     }
 
@@ -445,13 +1098,26 @@ JNIEXPORT jlong JNICALL Java_com_quietterminal_projectneon_jni_NeonHostJNI_neonH
     }
 
     handle->javaObject = (*env)->NewGlobalRef(env, hostObj);
+    handle->owner = 0;
     handle->clientConnectCallback = NULL;
     handle->clientDenyCallback = NULL;
     handle->pingReceivedCallback = NULL;
     handle->unhandledPacketCallback = NULL;
+    handle->sessionId = sessionId;
+    handle->clientCount = 0;
+    memset(&handle->messaging, 0, sizeof(handle->messaging));
+    memset(&handle->events, 0, sizeof(handle->events));
 
     (*env)->DeleteLocalRef(env, hostObj);
 
+    if (!events_init(env, &handle->events, handle->javaObject, g_attachHostEvents)) {
+        (*env)->CallVoidMethod(env, handle->javaObject, g_hostClose);
+        (*env)->ExceptionClear(env);
+        (*env)->DeleteGlobalRef(env, handle->javaObject);
+        free(handle);
+        return 0;
+    }
+
     return (jlong)(intptr_t)handle;
 }
 
@@ -462,23 +1128,14 @@ JNIEXPORT jboolean JNICALL Java_com_quietterminal_projectneon_jni_NeonHostJNI_ne
     }
 
     NeonHostHandle *handle = (NeonHostHandle*)(intptr_t)hostPtr;
-
-    jmethodID startMethod = (*env)->GetMethodID(env, g_neonHostClass, "start", "()V");
-    if (startMethod == NULL) {
-        set_error("Failed to find start method");
+    if (!handle_enter(&handle->owner)) {
         return JNI_FALSE;
     }
 
-    (*env)->CallVoidMethod(env, handle->javaObject, startMethod);
-
-    if ((*env)->ExceptionCheck(env)) {
-        (*env)->ExceptionDescribe(env);
-        (*env)->ExceptionClear(env);
-        set_error("Exception during start");
-        return JNI_FALSE;
-    }
-
-    return JNI_TRUE;
+    (*env)->CallVoidMethod(env, handle->javaObject, g_hostStart);
+    bool failed = check_exception(env, "Exception during start");
+    handle_exit(&handle->owner);
+    return failed ? JNI_FALSE : JNI_TRUE;
 }
 
 JNIEXPORT jint JNICALL Java_com_quietterminal_projectneon_jni_NeonHostJNI_neonHostProcessPackets(JNIEnv *env, jclass cls, jlong hostPtr) {
@@ -488,22 +1145,26 @@ JNIEXPORT jint JNICALL Java_com_quietterminal_projectneon_jni_NeonHostJNI_neonHo
     }
 
     NeonHostHandle *handle = (NeonHostHandle*)(intptr_t)hostPtr;
-
-    jmethodID processMethod = (*env)->GetMethodID(env, g_neonHostClass, "processPackets", "()I");
-    if (processMethod == NULL) {
-        set_error("Failed to find processPackets method");
+    if (!handle_enter(&handle->owner)) {
         return -1;
     }
 
-    jint result = (*env)->CallIntMethod(env, handle->javaObject, processMethod);
+    messaging_flush(&handle->messaging);
+    jint result = (*env)->CallIntMethod(env, handle->javaObject, g_hostProcessPackets);
+    if (check_exception(env, "Exception during processPackets")) {
+        handle_exit(&handle->owner);
+        return -1;
+    }
 
-    if ((*env)->ExceptionCheck(env)) {
-        (*env)->ExceptionDescribe(env);
-        (*env)->ExceptionClear(env);
-        set_error("Exception during processPackets");
+    jint clientCount = (*env)->CallIntMethod(env, handle->javaObject, g_hostGetClientCount);
+    if (check_exception(env, "Exception during getClientCount")) {
+        handle_exit(&handle->owner);
         return -1;
     }
 
+    neon_store_release32(&handle->clientCount, clientCount);
+    dispatch_host_events(handle);
+    handle_exit(&handle->owner);
     return result;
 }
 
@@ -513,15 +1174,7 @@ JNIEXPORT jint JNICALL Java_com_quietterminal_projectneon_jni_NeonHostJNI_neonHo
         return -1;
     }
 
-    NeonHostHandle *handle = (NeonHostHandle*)(intptr_t)hostPtr;
-
-    jmethodID getSessionMethod = (*env)->GetMethodID(env, g_neonHostClass, "getSessionId", "()I");
-    if (getSessionMethod == NULL) {
-        set_error("Failed to find getSessionId method");
-        return -1;
-    }
-
-    return (*env)->CallIntMethod(env, handle->javaObject, getSessionMethod);
+    return ((NeonHostHandle*)(intptr_t)hostPtr)->sessionId;
 }
 
 JNIEXPORT jint JNICALL Java_com_quietterminal_projectneon_jni_NeonHostJNI_neonHostGetClientCount(JNIEnv *env, jclass cls, jlong hostPtr) {
@@ -530,15 +1183,7 @@ JNIEXPORT jint JNICALL Java_com_quietterminal_projectneon_jni_NeonHostJNI_neonHo
         return 0;
     }
 
-    NeonHostHandle *handle = (NeonHostHandle*)(intptr_t)hostPtr;
-
-    jmethodID getClientCountMethod = (*env)->GetMethodID(env, g_neonHostClass, "getClientCount", "()I");
-    if (getClientCountMethod == NULL) {
-        set_error("Failed to find getClientCount method");
-        return 0;
-    }
-
-    return (*env)->CallIntMethod(env, handle->javaObject, getClientCountMethod);
+    return neon_load_acquire32(&((NeonHostHandle*)(intptr_t)hostPtr)->clientCount);
 }
 
 JNIEXPORT void JNICALL Java_com_quietterminal_projectneon_jni_NeonHostJNI_neonHostSetClientConnectCallback(JNIEnv *env, jclass cls, jlong hostPtr, jlong callback) {
@@ -581,25 +1226,226 @@ JNIEXPORT void JNICALL Java_com_quietterminal_projectneon_jni_NeonHostJNI_neonHo
     handle->unhandledPacketCallback = (HostUnhandledPacketCallback)(intptr_t)callback;
 }
 
+JNIEXPORT jboolean JNICALL Java_com_quietterminal_projectneon_jni_NeonHostJNI_neonHostEnableMessaging(JNIEnv *env, jclass cls, jlong hostPtr, jint ringCapacity) {
+    if (hostPtr == 0) {
+        set_error("Invalid host handle");
+        return JNI_FALSE;
+    }
+
+    NeonHostHandle *handle = (NeonHostHandle*)(intptr_t)hostPtr;
+    if (!handle_enter(&handle->owner)) {
+        return JNI_FALSE;
+    }
+    bool enabled = messaging_enable(env, &handle->messaging, handle->javaObject, g_hostSetMessageRings, ringCapacity);
+    handle_exit(&handle->owner);
+    return enabled ? JNI_TRUE : JNI_FALSE;
+}
+
 JNIEXPORT void JNICALL Java_com_quietterminal_projectneon_jni_NeonHostJNI_neonHostFree(JNIEnv *env, jclass cls, jlong hostPtr) {
     if (hostPtr == 0) {
         return;
     }
 
     NeonHostHandle *handle = (NeonHostHandle*)(intptr_t)hostPtr;
+    if (!handle_enter(&handle->owner)) {
+        return;
+    }
 
-    jmethodID closeMethod = (*env)->GetMethodID(env, g_neonHostClass, "close", "()V");
-    if (closeMethod != NULL) {
-        (*env)->CallVoidMethod(env, handle->javaObject, closeMethod);
-        if ((*env)->ExceptionCheck(env)) {
-            (*env)->ExceptionClear(env);
-        }
+    (*env)->CallVoidMethod(env, handle->javaObject, g_hostClose);
+    if ((*env)->ExceptionCheck(env)) {
+        (*env)->ExceptionClear(env);
     }
+    messaging_release(env, &handle->messaging, handle->javaObject, g_hostSetMessageRings);
+    free(handle->events.memory);
 
     (*env)->DeleteGlobalRef(env, handle->javaObject);
     free(handle);
 }
 
+/*
+ * Wake-up for SharedMemoryTransport. The word lives in a file mapped by two processes,
+ * so the futex must not be FUTEX_PRIVATE. Other platforms report -1 and the Java side
+ * falls back to timed parking.
+ */
+static int32_t* futex_word(JNIEnv *env, jobject buffer, jint offset) {
+    uint8_t *base = (uint8_t*)(*env)->GetDirectBufferAddress(env, buffer);
+    jlong capacity = (*env)->GetDirectBufferCapacity(env, buffer);
+    if (base == NULL || offset < 0 || (offset & 3) != 0 || (jlong)offset + 4 > capacity) {
+        return NULL;
+    }
+    return (int32_t*)(base + offset);
+}
+
+JNIEXPORT jint JNICALL Java_com_quietterminal_projectneon_core_SharedMemoryTransport_futexWait(JNIEnv *env, jclass cls, jobject buffer, jint offset, jint expected, jlong timeoutNanos) {
+#ifdef __linux__
+    int32_t *word = futex_word(env, buffer, offset);
+    if (word == NULL) {
+        return -1;
+    }
+    struct timespec timeout;
+    timeout.tv_sec = (time_t)(timeoutNanos / 1000000000LL);
+    timeout.tv_nsec = (long)(timeoutNanos % 1000000000LL);
+    if (syscall(SYS_futex, word, FUTEX_WAIT, expected, timeoutNanos > 0 ? &timeout : NULL, NULL, 0) != 0
+            && errno != EAGAIN && errno != ETIMEDOUT && errno != EINTR) {
+        return -1;
+    }
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+JNIEXPORT jint JNICALL Java_com_quietterminal_projectneon_core_SharedMemoryTransport_futexWake(JNIEnv *env, jclass cls, jobject buffer, jint offset, jint count) {
+#ifdef __linux__
+    int32_t *word = futex_word(env, buffer, offset);
+    if (word == NULL) {
+        return -1;
+    }
+    long woken = syscall(SYS_futex, word, FUTEX_WAKE, count, NULL, NULL, 0);
+    return woken < 0 ? -1 : (jint)woken;
+#else
+    return -1;
+#endif
+}
+
+static char* format_option(const char *prefix, const char *value) {
+    size_t length = strlen(prefix) + strlen(value) + 1;
+    char *option = (char*)malloc(length);
+    if (option != NULL) {
+        snprintf(option, length, "%s%s", prefix, value);
+    }
+    return option;
+}
+
+/*
+ * g_jvm is published only once the JNI cache is resolved, so a failed init leaves the
+ * runtime uninitialized and a retry resolves the cache again instead of reporting success.
+ */
+bool neon_runtime_init(const NeonRuntimeOptions* options) {
+    if (g_jvm != NULL) {
+        return true;
+    }
+
+    JavaVM *existing = NULL;
+    jsize count = 0;
+    if (JNI_GetCreatedJavaVMs(&existing, 1, &count) == JNI_OK && count > 0) {
+        /* Also reached on retry after a JVM this runtime created failed to resolve the cache. */
+        JNIEnv *env = attach_env(existing);
+        if (env == NULL || init_jni_cache(env) != JNI_OK) {
+            g_jvm = NULL; /* a nested JNI_OnLoad may have published it mid-resolution */
+            set_error("Project Neon classes not found in the running JVM");
+            return false;
+        }
+        g_jvm = existing;
+        return true;
+    }
+
+    if (options == NULL || options->class_path == NULL) {
+        set_error("Runtime options must include a class path");
+        return false;
+    }
+
+    /*
+     * Startup-oriented defaults: the AppCDS archive skips class parsing and verification,
+     * the serial collector starts no GC threads that would compete with the engine, and
+     * disabling perf data avoids creating the hsperfdata file.
+     */
+    size_t extra = options->jvm_options != NULL ? options->jvm_option_count : 0;
+    char **owned = (char**)calloc(3, sizeof(char*));
+    JavaVMOption *vmOptions = (JavaVMOption*)calloc(8 + extra, sizeof(JavaVMOption));
+    if (owned == NULL || vmOptions == NULL) {
+        free(owned);
+        free(vmOptions);
+        set_error("Failed to allocate JVM options");
+        return false;
+    }
+
+    jint n = 0;
+    size_t ownedCount = 0;
+    bool ok = (owned[ownedCount++] = format_option("-Djava.class.path=", options->class_path)) != NULL;
+    vmOptions[n++].optionString = owned[ownedCount - 1];
+    if (ok && options->cds_archive != NULL) {
+        ok = (owned[ownedCount++] = format_option("-XX:SharedArchiveFile=", options->cds_archive)) != NULL;
+        vmOptions[n++].optionString = owned[ownedCount - 1];
+        vmOptions[n++].optionString = "-XX:+AutoCreateSharedArchive";
+    }
+    if (ok && options->max_heap != NULL) {
+        ok = (owned[ownedCount++] = format_option("-Xmx", options->max_heap)) != NULL;
+        vmOptions[n++].optionString = owned[ownedCount - 1];
+    }
+    vmOptions[n++].optionString = (char*)(options->gc_option != NULL ? options->gc_option : "-XX:+UseSerialGC");
+    vmOptions[n++].optionString = "-XX:-UsePerfData";
+    vmOptions[n++].optionString = "-Dneon.jni.embedded=true";
+    for (size_t i = 0; i < extra; i++) {
+        vmOptions[n++].optionString = (char*)options->jvm_options[i];
+    }
+
+    JavaVM *vm = NULL;
+    JNIEnv *env = NULL;
+    jint result = JNI_ERR;
+    if (ok) {
+        JavaVMInitArgs args;
+        args.version = JNI_VERSION_1_8;
+        args.nOptions = n;
+        args.options = vmOptions;
+        args.ignoreUnrecognized = JNI_FALSE;
+        result = JNI_CreateJavaVM(&vm, (void**)&env, &args);
+    }
+
+    for (size_t i = 0; i < ownedCount; i++) {
+        free(owned[i]);
+    }
+    free(owned);
+    free(vmOptions);
+
+    if (result != JNI_OK) {
+        set_error(ok ? "Failed to create JVM" : "Failed to allocate JVM options");
+        return false;
+    }
+
+    /*
+     * A JVM cannot be created twice in one process, so on failure it stays alive but
+     * unpublished; a retry finds it through JNI_GetCreatedJavaVMs and still owns it.
+     */
+    g_ownsJvm = true;
+    t_env = env;
+    if (init_jni_cache(env) != JNI_OK) {
+        g_jvm = NULL;
+        set_error("Project Neon classes not found on the class path");
+        return false;
+    }
+    g_jvm = vm;
+    return true;
+}
+
+void neon_runtime_detach_thread(void) {
+    if (g_jvm == NULL || !t_attached) {
+        t_env = NULL;
+        return;
+    }
+    set_detach_on_exit(false);
+    (*g_jvm)->DetachCurrentThread(g_jvm);
+    t_env = NULL;
+    t_attached = false;
+}
+
+void neon_runtime_shutdown(void) {
+    if (g_jvm == NULL || !g_ownsJvm) {
+        return;
+    }
+
+    JNIEnv *env = get_jni_env();
+    if (env != NULL) {
+        release_jni_cache(env);
+    }
+    set_detach_on_exit(false);
+    (*g_jvm)->DestroyJavaVM(g_jvm);
+    g_jvm = NULL;
+    g_ownsJvm = false;
+    t_env = NULL;
+    t_attached = false;
+}
+
 NeonClientHandle* neon_client_new(const char* name) {
     JNIEnv *env = get_jni_env();
     if (env == NULL) {
@@ -658,45 +1504,17 @@ int neon_client_process_packets(NeonClientHandle* client) {
 }
 
 uint8_t neon_client_get_id(NeonClientHandle* client) {
-    if (client == NULL) {
-        return 0;
-    }
-
-    JNIEnv *env = get_jni_env();
-    if (env == NULL) {
-        return 0;
-    }
-
-    return (uint8_t)Java_com_quietterminal_projectneon_jni_NeonClientJNI_neonClientGetId(
-        env, NULL, (jlong)(intptr_t)client);
+    int32_t id = client != NULL ? neon_load_acquire32(&client->clientId) : -1;
+    return id < 0 ? 0 : (uint8_t)id;
 }
 
 uint32_t neon_client_get_session_id(NeonClientHandle* client) {
-    if (client == NULL) {
-        return 0;
-    }
-
-    JNIEnv *env = get_jni_env();
-    if (env == NULL) {
-        return 0;
-    }
-
-    return (uint32_t)Java_com_quietterminal_projectneon_jni_NeonClientJNI_neonClientGetSessionId(
-        env, NULL, (jlong)(intptr_t)client);
+    int32_t sessionId = client != NULL ? neon_load_acquire32(&client->sessionId) : -1;
+    return sessionId < 0 ? 0 : (uint32_t)sessionId;
 }
 
 bool neon_client_is_connected(NeonClientHandle* client) {
-    if (client == NULL) {
-        return false;
-    }
-
-    JNIEnv *env = get_jni_env();
-    if (env == NULL) {
-        return false;
-    }
-
-    return Java_com_quietterminal_projectneon_jni_NeonClientJNI_neonClientIsConnected(
-        env, NULL, (jlong)(intptr_t)client) == JNI_TRUE;
+    return client != NULL && neon_load_acquire32(&client->connected) != 0;
 }
 
 bool neon_client_send_ping(NeonClientHandle* client) {
@@ -728,6 +1546,15 @@ void neon_client_set_auto_ping(NeonClientHandle* client, bool enabled) {
         env, NULL, (jlong)(intptr_t)client, enabled ? JNI_TRUE : JNI_FALSE);
 }
 
+size_t neon_client_poll_events(NeonClientHandle* client, NeonEvent* out, size_t max) {
+    if (client == NULL || !handle_enter(&client->owner)) {
+        return 0;
+    }
+    size_t count = events_poll(&client->events, out, max);
+    handle_exit(&client->owner);
+    return count;
+}
+
 void neon_client_set_pong_callback(NeonClientHandle* client, PongCallback callback) {
     if (client == NULL) {
         return;
@@ -798,6 +1625,67 @@ void neon_client_set_wrong_destination_callback(NeonClientHandle* client, WrongD
         env, NULL, (jlong)(intptr_t)client, (jlong)(intptr_t)callback);
 }
 
+bool neon_client_enable_messaging(NeonClientHandle* client, uint32_t ring_capacity) {
+    if (client == NULL) {
+        set_error("Invalid client handle");
+        return false;
+    }
+    if (ring_capacity > MAX_RING_CAPACITY) {
+        set_error("Invalid ring capacity");
+        return false;
+    }
+
+    JNIEnv *env = get_jni_env();
+    if (env == NULL) {
+        return false;
+    }
+
+    return Java_com_quietterminal_projectneon_jni_NeonClientJNI_neonClientEnableMessaging(
+        env, NULL, (jlong)(intptr_t)client, (jint)ring_capacity) == JNI_TRUE;
+}
+
+/*
+ * Message functions only touch the submit queue and shared rings; they make no JNI
+ * calls and may be called from any thread.
+ */
+bool neon_client_send_message(NeonClientHandle* client, uint8_t packet_type, uint8_t destination_id, const void* data, size_t length) {
+    if (client == NULL) {
+        set_error("Invalid client handle");
+        return false;
+    }
+    return messaging_send(&client->messaging, packet_type, destination_id, data, length);
+}
+
+uint8_t* neon_client_begin_message(NeonClientHandle* client, size_t max_length) {
+    if (client == NULL) {
+        set_error("Invalid client handle");
+        return NULL;
+    }
+    return messaging_begin(&client->messaging, max_length);
+}
+
+bool neon_client_commit_message(NeonClientHandle* client, uint8_t packet_type, uint8_t destination_id, size_t length) {
+    if (client == NULL) {
+        set_error("Invalid client handle");
+        return false;
+    }
+    return messaging_commit(&client->messaging, packet_type, destination_id, length);
+}
+
+bool neon_client_peek_message(NeonClientHandle* client, NeonMessage* message) {
+    if (client == NULL) {
+        return false;
+    }
+    return messaging_peek(&client->messaging, message);
+}
+
+void neon_client_release_message(NeonClientHandle* client) {
+    if (client == NULL) {
+        return;
+    }
+    messaging_next(&client->messaging);
+}
+
 void neon_client_free(NeonClientHandle* client) {
     if (client == NULL) {
         return;
@@ -865,13 +1753,7 @@ uint32_t neon_host_get_session_id(NeonHostHandle* host) {
         return 0;
     }
 
-    JNIEnv *env = get_jni_env();
-    if (env == NULL) {
-        return 0;
-    }
-
-    return (uint32_t)Java_com_quietterminal_projectneon_jni_NeonHostJNI_neonHostGetSessionId(
-        env, NULL, (jlong)(intptr_t)host);
+    return (uint32_t)host->sessionId;
 }
 
 size_t neon_host_get_client_count(NeonHostHandle* host) {
@@ -879,13 +1761,16 @@ size_t neon_host_get_client_count(NeonHostHandle* host) {
         return 0;
     }
 
-    JNIEnv *env = get_jni_env();
-    if (env == NULL) {
+    return (size_t)neon_load_acquire32(&host->clientCount);
+}
+
+size_t neon_host_poll_events(NeonHostHandle* host, NeonEvent* out, size_t max) {
+    if (host == NULL || !handle_enter(&host->owner)) {
         return 0;
     }
-
-    return (size_t)Java_com_quietterminal_projectneon_jni_NeonHostJNI_neonHostGetClientCount(
-        env, NULL, (jlong)(intptr_t)host);
+    size_t count = events_poll(&host->events, out, max);
+    handle_exit(&host->owner);
+    return count;
 }
 
 void neon_host_set_client_connect_callback(NeonHostHandle* host, ClientConnectCallback callback) {
@@ -944,6 +1829,63 @@ void neon_host_set_unhandled_packet_callback(NeonHostHandle* host, HostUnhandled
         env, NULL, (jlong)(intptr_t)host, (jlong)(intptr_t)callback);
 }
 
+bool neon_host_enable_messaging(NeonHostHandle* host, uint32_t ring_capacity) {
+    if (host == NULL) {
+        set_error("Invalid host handle");
+        return false;
+    }
+    if (ring_capacity > MAX_RING_CAPACITY) {
+        set_error("Invalid ring capacity");
+        return false;
+    }
+
+    JNIEnv *env = get_jni_env();
+    if (env == NULL) {
+        return false;
+    }
+
+    return Java_com_quietterminal_projectneon_jni_NeonHostJNI_neonHostEnableMessaging(
+        env, NULL, (jlong)(intptr_t)host, (jint)ring_capacity) == JNI_TRUE;
+}
+
+bool neon_host_send_message(NeonHostHandle* host, uint8_t packet_type, uint8_t destination_id, const void* data, size_t length) {
+    if (host == NULL) {
+        set_error("Invalid host handle");
+        return false;
+    }
+    return messaging_send(&host->messaging, packet_type, destination_id, data, length);
+}
+
+uint8_t* neon_host_begin_message(NeonHostHandle* host, size_t max_length) {
+    if (host == NULL) {
+        set_error("Invalid host handle");
+        return NULL;
+    }
+    return messaging_begin(&host->messaging, max_length);
+}
+
+bool neon_host_commit_message(NeonHostHandle* host, uint8_t packet_type, uint8_t destination_id, size_t length) {
+    if (host == NULL) {
+        set_error("Invalid host handle");
+        return false;
+    }
+    return messaging_commit(&host->messaging, packet_type, destination_id, length);
+}
+
+bool neon_host_peek_message(NeonHostHandle* host, NeonMessage* message) {
+    if (host == NULL) {
+        return false;
+    }
+    return messaging_peek(&host->messaging, message);
+}
+
+void neon_host_release_message(NeonHostHandle* host) {
+    if (host == NULL) {
+        return;
+    }
+    messaging_next(&host->messaging);
+}
+
 void neon_host_free(NeonHostHandle* host) {
     if (host == NULL) {
         return;
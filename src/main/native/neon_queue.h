@@ -0,0 +1,120 @@
+/*
+ * Project Neon - multi-producer single-consumer command queue
+ *
+ * Lets any number of engine threads submit messages to one handle without a lock.
+ * Producers claim space with a CAS on the claim position, write their record, and
+ * commit it with a release store of its state word; records may be committed out
+ * of order. The single consumer reads committed records in claim order and stops at
+ * the first one still being written.
+ *
+ * Records are [int32 state][uint32 span][bytes], padded to 8. State 0 means not yet
+ * committed, NEON_QUEUE_WRAP marks the unused end of the data region, and anything
+ * else is the committed length. The consumer zeroes every record it consumes, so
+ * free space always reads as uncommitted.
+ *
+ * Unlike NeonRing this queue lives only in native memory. Internal header; not installed.
+ */
+
+#ifndef NEON_QUEUE_H
+#define NEON_QUEUE_H
+
+#include "neon_ring.h"
+
+#define NEON_QUEUE_RECORD_HEADER_SIZE 8
+#define NEON_QUEUE_WRAP (-1)
+
+typedef struct NeonQueue {
+    uint8_t *data;       /* capacity bytes, zeroed */
+    uint32_t capacity;   /* power of two */
+    int64_t head;        /* consumer position */
+    uint8_t padding[48];
+    int64_t claim;       /* producer position, on its own cache line */
+} NeonQueue;
+
+static inline void neon_queue_init(NeonQueue *queue, void *memory, uint32_t capacity) {
+    queue->data = (uint8_t*)memory;
+    queue->capacity = capacity;
+    queue->head = 0;
+    queue->claim = 0;
+}
+
+static inline uint32_t neon_queue_max_record(const NeonQueue *queue) {
+    return queue->capacity / 2 - NEON_QUEUE_RECORD_HEADER_SIZE;
+}
+
+/*
+ * Claims room for a record of up to max_length bytes and returns where to write it,
+ * or NULL if the queue is full. The record blocks the consumer until it is committed.
+ */
+static inline uint8_t* neon_queue_claim(NeonQueue *queue, uint32_t max_length) {
+    if (max_length > neon_queue_max_record(queue)) {
+        return NULL;
+    }
+    uint32_t size = neon_ring_align(NEON_QUEUE_RECORD_HEADER_SIZE + max_length);
+    int64_t claim;
+    uint32_t index;
+    uint32_t padding;
+    do {
+        claim = neon_ring_load_acquire(&queue->claim);
+        index = (uint32_t)claim & (queue->capacity - 1);
+        padding = queue->capacity - index < size ? queue->capacity - index : 0;
+        if (claim + padding + size - neon_ring_load_acquire(&queue->head) > queue->capacity) {
+            return NULL;
+        }
+    } while (!neon_cas64(&queue->claim, claim, claim + padding + size));
+
+    if (padding > 0) {
+        memcpy(queue->data + index + 4, &padding, sizeof(padding));
+        neon_store_release32((int32_t*)(queue->data + index), NEON_QUEUE_WRAP);
+        index = 0;
+    }
+    memcpy(queue->data + index + 4, &size, sizeof(size));
+    return queue->data + index + NEON_QUEUE_RECORD_HEADER_SIZE;
+}
+
+/* Publishes a record returned by neon_queue_claim; length must not exceed the claimed size */
+static inline void neon_queue_commit(uint8_t *record, uint32_t length) {
+    neon_store_release32((int32_t*)(record - NEON_QUEUE_RECORD_HEADER_SIZE), (int32_t)length);
+}
+
+/* Returns the oldest committed record without consuming it, or NULL if there is none. Consumer only */
+static inline const uint8_t* neon_queue_peek(NeonQueue *queue, uint32_t *length) {
+    for (;;) {
+        uint8_t *record = queue->data + ((uint32_t)queue->head & (queue->capacity - 1));
+        int32_t state = neon_load_acquire32((int32_t*)record);
+        if (state == 0) {
+            return NULL;
+        }
+        if (state == NEON_QUEUE_WRAP) {
+            uint32_t padding;
+            memcpy(&padding, record + 4, sizeof(padding));
+            memset(record, 0, NEON_QUEUE_RECORD_HEADER_SIZE);
+            neon_ring_store_release(&queue->head, queue->head + padding);
+            continue;
+        }
+        *length = (uint32_t)state;
+        return record + NEON_QUEUE_RECORD_HEADER_SIZE;
+    }
+}
+
+/*
+ * Reports whether the record at the consumer position has been started, without
+ * consuming anything, so it is safe from any thread. A wrap marker counts because the
+ * record after it may already be committed; a stale answer only costs one empty peek.
+ */
+static inline bool neon_queue_pending(const NeonQueue *queue) {
+    int64_t head = neon_ring_load_acquire(&queue->head);
+    const uint8_t *record = queue->data + ((uint32_t)head & (queue->capacity - 1));
+    return neon_load_acquire32((const int32_t*)record) != 0;
+}
+
+/* Consumes the record returned by the last successful peek. Consumer only */
+static inline void neon_queue_release(NeonQueue *queue) {
+    uint8_t *record = queue->data + ((uint32_t)queue->head & (queue->capacity - 1));
+    uint32_t size;
+    memcpy(&size, record + 4, sizeof(size));
+    memset(record, 0, size);
+    neon_ring_store_release(&queue->head, queue->head + size);
+}
+
+#endif /* NEON_QUEUE_H */
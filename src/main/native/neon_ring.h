@@ -0,0 +1,199 @@
+/*
+ * Project Neon - single-producer single-consumer byte ring
+ *
+ * Native half of com.quietterminal.projectneon.core.SpscByteRing. Both sides
+ * operate on the same memory, so the layout below must match the Java class:
+ *
+ *   [0..8)    consumer position (head), int64, native byte order
+ *   [64..72)  producer position (tail), int64, on its own cache line
+ *   [128..)   data region, a power of two bytes
+ *
+ * Records are a 4-byte length followed by the bytes, padded to 8. A length of -1
+ * marks the unused end of the data region. Positions only grow; the producer
+ * publishes with a release store of the tail and the consumer frees space with a
+ * release store of the head.
+ *
+ * Internal header; not installed.
+ */
+
+#ifndef NEON_RING_H
+#define NEON_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define NEON_RING_HEADER_SIZE 128
+#define NEON_RING_RECORD_HEADER_SIZE 4
+#define NEON_RING_HEAD_OFFSET 0
+#define NEON_RING_TAIL_OFFSET 64
+#define NEON_RING_WRAP_MARKER (-1)
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+/* x86/x64 only: volatile accesses are not reordered with each other by the CPU */
+static __inline int64_t neon_ring_load_acquire(int64_t *p) {
+    int64_t v = *(volatile int64_t*)p;
+    _ReadWriteBarrier();
+    return v;
+}
+static __inline void neon_ring_store_release(int64_t *p, int64_t v) {
+    _ReadWriteBarrier();
+    *(volatile int64_t*)p = v;
+}
+static __inline int32_t neon_load_acquire32(int32_t *p) {
+    int32_t v = *(volatile int32_t*)p;
+    _ReadWriteBarrier();
+    return v;
+}
+static __inline void neon_store_release32(int32_t *p, int32_t v) {
+    _ReadWriteBarrier();
+    *(volatile int32_t*)p = v;
+}
+/* Interlocked operations are full barriers */
+static __inline bool neon_cas64(int64_t *p, int64_t expected, int64_t desired) {
+    return _InterlockedCompareExchange64((volatile __int64*)p, desired, expected) == expected;
+}
+static __inline int64_t neon_exchange64(int64_t *p, int64_t v) {
+    return _InterlockedExchange64((volatile __int64*)p, v);
+}
+#else
+#define neon_ring_load_acquire(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define neon_ring_store_release(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define neon_load_acquire32(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define neon_store_release32(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+static inline bool neon_cas64(int64_t *p, int64_t expected, int64_t desired) {
+    return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+#define neon_exchange64(p, v) __atomic_exchange_n((p), (v), __ATOMIC_SEQ_CST)
+#endif
+
+typedef struct NeonRing {
+    uint8_t *data;
+    int64_t *head;
+    int64_t *tail;
+    uint32_t capacity;
+    int64_t cachedHead; /* producer side only */
+    int64_t cachedTail; /* consumer side only */
+} NeonRing;
+
+static inline uint32_t neon_ring_align(uint32_t size) {
+    return (size + 7u) & ~7u;
+}
+
+/* Attaches to ring memory of NEON_RING_HEADER_SIZE + capacity bytes; capacity must be a power of two */
+static inline void neon_ring_attach(NeonRing *ring, void *memory, uint32_t capacity) {
+    uint8_t *base = (uint8_t*)memory;
+    ring->head = (int64_t*)(base + NEON_RING_HEAD_OFFSET);
+    ring->tail = (int64_t*)(base + NEON_RING_TAIL_OFFSET);
+    ring->data = base + NEON_RING_HEADER_SIZE;
+    ring->capacity = capacity;
+    ring->cachedHead = neon_ring_load_acquire(ring->head);
+    ring->cachedTail = neon_ring_load_acquire(ring->tail);
+}
+
+static inline uint32_t neon_ring_max_record(const NeonRing *ring) {
+    return ring->capacity / 2 - NEON_RING_RECORD_HEADER_SIZE;
+}
+
+/*
+ * Reserves room for a record of up to max_length bytes and returns where to write
+ * it, or NULL if the ring is full. Nothing is visible to the consumer until commit.
+ */
+static inline uint8_t* neon_ring_reserve(NeonRing *ring, uint32_t max_length) {
+    if (max_length > neon_ring_max_record(ring)) {
+        return NULL;
+    }
+    uint32_t size = neon_ring_align(NEON_RING_RECORD_HEADER_SIZE + max_length);
+    int64_t tail = *ring->tail;
+    uint32_t index = (uint32_t)tail & (ring->capacity - 1);
+    uint32_t padding = ring->capacity - index < size ? ring->capacity - index : 0;
+
+    if (tail + padding + size - ring->cachedHead > ring->capacity) {
+        ring->cachedHead = neon_ring_load_acquire(ring->head);
+        if (tail + padding + size - ring->cachedHead > ring->capacity) {
+            return NULL;
+        }
+    }
+    if (padding > 0) {
+        int32_t marker = NEON_RING_WRAP_MARKER;
+        memcpy(ring->data + index, &marker, sizeof(marker));
+        neon_ring_store_release(ring->tail, tail + padding);
+        index = 0;
+    }
+    return ring->data + index + NEON_RING_RECORD_HEADER_SIZE;
+}
+
+/* Publishes the record written after the last reserve; length must not exceed the reserved size */
+static inline void neon_ring_commit(NeonRing *ring, uint32_t length) {
+    int64_t tail = *ring->tail;
+    uint32_t index = (uint32_t)tail & (ring->capacity - 1);
+    int32_t stored = (int32_t)length;
+    memcpy(ring->data + index, &stored, sizeof(stored));
+    neon_ring_store_release(ring->tail, tail + neon_ring_align(NEON_RING_RECORD_HEADER_SIZE + length));
+}
+
+/* Returns the oldest record without consuming it, or NULL if the ring is empty */
+static inline const uint8_t* neon_ring_peek(NeonRing *ring, uint32_t *length) {
+    for (;;) {
+        int64_t head = *ring->head;
+        if (head == ring->cachedTail) {
+            ring->cachedTail = neon_ring_load_acquire(ring->tail);
+            if (head == ring->cachedTail) {
+                return NULL;
+            }
+        }
+        uint32_t index = (uint32_t)head & (ring->capacity - 1);
+        int32_t stored;
+        memcpy(&stored, ring->data + index, sizeof(stored));
+        if (stored == NEON_RING_WRAP_MARKER) {
+            neon_ring_store_release(ring->head, head + (ring->capacity - index));
+            continue;
+        }
+        *length = (uint32_t)stored;
+        return ring->data + index + NEON_RING_RECORD_HEADER_SIZE;
+    }
+}
+
+/* Consumes the record returned by the last successful peek */
+static inline void neon_ring_release(NeonRing *ring) {
+    int64_t head = *ring->head;
+    uint32_t index = (uint32_t)head & (ring->capacity - 1);
+    int32_t stored;
+    memcpy(&stored, ring->data + index, sizeof(stored));
+    neon_ring_store_release(ring->head, head + neon_ring_align(NEON_RING_RECORD_HEADER_SIZE + (uint32_t)stored));
+}
+
+/*
+ * Reads records after the head without consuming them, for draining a batch that
+ * must stay readable until a later release_to. Start with *position equal to the
+ * head; returns NULL once the producer's tail is reached.
+ */
+static inline const uint8_t* neon_ring_read_at(NeonRing *ring, int64_t *position, uint32_t *length) {
+    for (;;) {
+        int64_t pos = *position;
+        if (pos == ring->cachedTail) {
+            ring->cachedTail = neon_ring_load_acquire(ring->tail);
+            if (pos == ring->cachedTail) {
+                return NULL;
+            }
+        }
+        uint32_t index = (uint32_t)pos & (ring->capacity - 1);
+        int32_t stored;
+        memcpy(&stored, ring->data + index, sizeof(stored));
+        if (stored == NEON_RING_WRAP_MARKER) {
+            *position = pos + (ring->capacity - index);
+            continue;
+        }
+        *length = (uint32_t)stored;
+        *position = pos + neon_ring_align(NEON_RING_RECORD_HEADER_SIZE + (uint32_t)stored);
+        return ring->data + index + NEON_RING_RECORD_HEADER_SIZE;
+    }
+}
+
+/* Consumes every record before a position returned through neon_ring_read_at */
+static inline void neon_ring_release_to(NeonRing *ring, int64_t position) {
+    neon_ring_store_release(ring->head, position);
+}
+
+#endif /* NEON_RING_H */
@@ -5,6 +5,12 @@
  * with game engines like Unreal Engine, Unity, or custom C/C++ engines.
  *
  * The implementation uses JNI to call into the Java-based Neon protocol library.
+ *
+ * Threading: one thread at a time may drive a handle with connect, process_packets,
+ * poll_events, enable_messaging, free or neon_host_start. A second thread calling one
+ * of these on a busy handle fails with "Handle is in use on another thread". Any
+ * thread may send messages and pings and read the getters at any time; see the game
+ * messages section.
  */
 
 #ifndef PROJECT_NEON_H
@@ -33,6 +39,88 @@ typedef void (*ClientDenyCallback)(const char* name, const char* reason);
 typedef void (*PingReceivedCallback)(uint8_t from_client_id);
 typedef void (*HostUnhandledPacketCallback)(uint8_t packet_type, uint8_t from_client_id);
 
+/* Event kinds reported by neon_client_poll_events and neon_host_poll_events */
+typedef enum NeonEventType {
+    NEON_EVENT_PONG = 1,
+    NEON_EVENT_SESSION_CONFIG = 2,
+    NEON_EVENT_PACKET_TYPE = 3,        /* one per packet type registry entry */
+    NEON_EVENT_UNHANDLED_PACKET = 4,
+    NEON_EVENT_WRONG_DESTINATION = 5,
+    NEON_EVENT_DISCONNECT = 6,         /* client: another client disconnected */
+    NEON_EVENT_CLIENT_CONNECT = 7,     /* host */
+    NEON_EVENT_CLIENT_DENY = 8,        /* host */
+    NEON_EVENT_PING_RECEIVED = 9,      /* host */
+    NEON_EVENT_CLIENT_DISCONNECT = 10  /* host */
+} NeonEventType;
+
+/*
+ * A polled event. Read the union member matching type. Strings point into the
+ * event queue and stay valid until the next poll_events call on the same handle.
+ */
+typedef struct NeonEvent {
+    NeonEventType type;
+    union {
+        struct { uint64_t response_time_ms; uint64_t original_timestamp; } pong;
+        struct { uint8_t version; uint16_t tick_rate; uint16_t max_packet_size; } session_config;
+        struct { uint8_t id; const char* name; const char* description; } packet_type;
+        struct { uint8_t packet_type; uint8_t from_client_id; } unhandled_packet;
+        struct { uint8_t my_id; uint8_t packet_destination_id; } wrong_destination;
+        struct { uint8_t client_id; } disconnect;
+        struct { uint8_t client_id; uint32_t session_id; const char* name; } client_connect;
+        struct { const char* name; const char* reason; } client_deny;
+        struct { uint8_t from_client_id; } ping_received;
+    } data;
+} NeonEvent;
+
+/*
+ * A received game message. data points into the shared receive ring and stays
+ * valid until the matching release_message call.
+ */
+typedef struct NeonMessage {
+    uint8_t packet_type;    /* game packet type, 0x10 and above */
+    uint8_t peer_id;        /* sending client ID (1 is the host) */
+    uint32_t length;
+    const uint8_t* data;
+} NeonMessage;
+
+/* ========== Runtime ========== */
+
+/*
+ * Options for starting an embedded JVM. Only class_path is required.
+ */
+typedef struct NeonRuntimeOptions {
+    const char* class_path;          /* Project Neon jar and its dependencies */
+    const char* cds_archive;         /* AppCDS archive; written on the first run if missing. NULL to disable */
+    const char* max_heap;            /* -Xmx value such as "256m"; NULL for the JVM default */
+    const char* gc_option;           /* GC selection flag; NULL for -XX:+UseSerialGC */
+    const char* const* jvm_options;  /* Additional raw JVM options; may be NULL */
+    size_t jvm_option_count;
+} NeonRuntimeOptions;
+
+/**
+ * Starts the Java runtime inside this process. Call once, before any other function,
+ * from the thread that will later call neon_runtime_shutdown. Does nothing if the
+ * library was loaded by a running JVM; options may then be NULL.
+ *
+ * Threads that call into the API are attached to the JVM on first use, and threads
+ * attached this way are detached automatically when they exit.
+ *
+ * @param options Runtime options
+ * @return true if the runtime is ready, false otherwise
+ */
+bool neon_runtime_init(const NeonRuntimeOptions* options);
+
+/**
+ * Detaches the calling thread from the JVM early. Optional; threads are detached on exit.
+ */
+void neon_runtime_detach_thread(void);
+
+/**
+ * Destroys a JVM created by neon_runtime_init. Free all handles first. The JVM cannot
+ * be started again in the same process.
+ */
+void neon_runtime_shutdown(void);
+
 /* ========== Client Functions ========== */
 
 /**
@@ -63,6 +151,7 @@ int neon_client_process_packets(NeonClientHandle* client);
 
 /**
  * Gets the assigned client ID.
+ * Reads state cached at the last connect or process_packets call; no JVM call is made.
  *
  * @param client Client handle
  * @return Client ID, or 0 if not connected
@@ -71,6 +160,7 @@ uint8_t neon_client_get_id(NeonClientHandle* client);
 
 /**
  * Gets the current session ID.
+ * Reads state cached at the last connect or process_packets call; no JVM call is made.
  *
  * @param client Client handle
  * @return Session ID, or 0 if not connected
@@ -79,6 +169,7 @@ uint32_t neon_client_get_session_id(NeonClientHandle* client);
 
 /**
  * Checks if the client is connected.
+ * Reads state cached at the last connect or process_packets call; no JVM call is made.
  *
  * @param client Client handle
  * @return true if connected, false otherwise
@@ -86,10 +177,11 @@ uint32_t neon_client_get_session_id(NeonClientHandle* client);
 bool neon_client_is_connected(NeonClientHandle* client);
 
 /**
- * Sends a ping to the host.
+ * Sends a ping to the host. Callable from any thread; if another thread is inside the
+ * handle, the ping is sent at the start of the next process_packets instead.
  *
  * @param client Client handle
- * @return true if sent successfully, false otherwise
+ * @return true if sent or queued, false otherwise
  */
 bool neon_client_send_ping(NeonClientHandle* client);
 
@@ -101,6 +193,25 @@ bool neon_client_send_ping(NeonClientHandle* client);
  */
 void neon_client_set_auto_ping(NeonClientHandle* client, bool enabled);
 
+/*
+ * Events are queued by the Java core during process_packets and read here without
+ * a JVM call. If any callback is set on a handle, process_packets instead delivers
+ * the queued events to the callbacks before returning, and poll_events finds the
+ * queue empty; use one style or the other. Events are dropped if the queue fills up
+ * between calls.
+ */
+
+/**
+ * Copies up to max queued events into out, oldest first.
+ * Strings in the events stay valid until the next call on this handle.
+ *
+ * @param client Client handle
+ * @param out Array of at least max events
+ * @param max Capacity of out
+ * @return Number of events written
+ */
+size_t neon_client_poll_events(NeonClientHandle* client, NeonEvent* out, size_t max);
+
 /* Callback setters */
 void neon_client_set_pong_callback(NeonClientHandle* client, PongCallback callback);
 void neon_client_set_session_config_callback(NeonClientHandle* client, SessionConfigCallback callback);
@@ -108,6 +219,62 @@ void neon_client_set_packet_type_registry_callback(NeonClientHandle* client, Pac
 void neon_client_set_unhandled_packet_callback(NeonClientHandle* client, UnhandledPacketCallback callback);
 void neon_client_set_wrong_destination_callback(NeonClientHandle* client, WrongDestinationCallback callback);
 
+/* ========== Game Messages ========== */
+
+/*
+ * Game messages travel through a pair of single-producer single-consumer rings in
+ * memory shared with the Java core. Sending and receiving only touch native memory and
+ * never call into the JVM: queued messages are sent, and received game packets are
+ * queued, during the next process_packets call. Any number of threads may send at once
+ * through a lock-free queue in front of the send ring, and each thread's messages keep
+ * their order. One thread may receive at a time. Messages received while the receive
+ * ring is full are dropped.
+ */
+
+/**
+ * Allocates the message rings. Call once, after creating the client.
+ *
+ * @param client Client handle
+ * @param ring_capacity Bytes per ring, rounded up to a power of two (minimum 4096)
+ * @return true if messaging is enabled, false otherwise
+ */
+bool neon_client_enable_messaging(NeonClientHandle* client, uint32_t ring_capacity);
+
+/**
+ * Queues a game message for sending. destination_id 0 broadcasts to the session.
+ *
+ * @return true if queued, false if messaging is not enabled or the ring is full
+ */
+bool neon_client_send_message(NeonClientHandle* client, uint8_t packet_type, uint8_t destination_id, const void* data, size_t length);
+
+/**
+ * Reserves space for a message of up to max_length bytes in the send queue. Write the
+ * payload to the returned pointer, then call neon_client_commit_message from the same
+ * thread. Other threads' messages queue behind it until it is committed.
+ *
+ * @return Where to write the payload, or NULL if the ring is full
+ */
+uint8_t* neon_client_begin_message(NeonClientHandle* client, size_t max_length);
+
+/**
+ * Queues the message written after neon_client_begin_message.
+ *
+ * @param length Bytes actually written, at most the reserved max_length
+ */
+bool neon_client_commit_message(NeonClientHandle* client, uint8_t packet_type, uint8_t destination_id, size_t length);
+
+/**
+ * Reads the oldest received message in place without consuming it.
+ *
+ * @return true if a message was available
+ */
+bool neon_client_peek_message(NeonClientHandle* client, NeonMessage* message);
+
+/**
+ * Consumes the message returned by the last neon_client_peek_message.
+ */
+void neon_client_release_message(NeonClientHandle* client);
+
 /**
  * Frees the client and releases resources.
  *
@@ -127,7 +294,8 @@ void neon_client_free(NeonClientHandle* client);
 NeonHostHandle* neon_host_new(uint32_t session_id, const char* relay_addr);
 
 /**
- * Starts the host (blocking call - run in a separate thread).
+ * Starts the host: registers the session with the relay and returns without blocking.
+ * The host then runs in neon_host_process_packets(), called regularly by the game loop.
  *
  * @param host Host handle
  * @return true if started successfully, false otherwise
@@ -135,7 +303,7 @@ NeonHostHandle* neon_host_new(uint32_t session_id, const char* relay_addr);
 bool neon_host_start(NeonHostHandle* host);
 
 /**
- * Processes incoming packets (alternative to start() for manual control).
+ * Processes incoming packets. Call regularly after neon_host_start().
  *
  * @param host Host handle
  * @return Number of packets processed, or -1 on error
@@ -152,18 +320,32 @@ uint32_t neon_host_get_session_id(NeonHostHandle* host);
 
 /**
  * Gets the number of connected clients.
+ * Reads the count cached at the last process_packets call; no JVM call is made.
  *
  * @param host Host handle
  * @return Client count
  */
 size_t neon_host_get_client_count(NeonHostHandle* host);
 
+/**
+ * Copies up to max queued events into out; see neon_client_poll_events.
+ */
+size_t neon_host_poll_events(NeonHostHandle* host, NeonEvent* out, size_t max);
+
 /* Callback setters */
 void neon_host_set_client_connect_callback(NeonHostHandle* host, ClientConnectCallback callback);
 void neon_host_set_client_deny_callback(NeonHostHandle* host, ClientDenyCallback callback);
 void neon_host_set_ping_received_callback(NeonHostHandle* host, PingReceivedCallback callback);
 void neon_host_set_unhandled_packet_callback(NeonHostHandle* host, HostUnhandledPacketCallback callback);
 
+/* Game messages; see the client functions above for semantics */
+bool neon_host_enable_messaging(NeonHostHandle* host, uint32_t ring_capacity);
+bool neon_host_send_message(NeonHostHandle* host, uint8_t packet_type, uint8_t destination_id, const void* data, size_t length);
+uint8_t* neon_host_begin_message(NeonHostHandle* host, size_t max_length);
+bool neon_host_commit_message(NeonHostHandle* host, uint8_t packet_type, uint8_t destination_id, size_t length);
+bool neon_host_peek_message(NeonHostHandle* host, NeonMessage* message);
+void neon_host_release_message(NeonHostHandle* host);
+
 /**
  * Frees the host and releases resources.
  *
@@ -0,0 +1,426 @@
+/*
+ * Project Neon - C++ Integration Header
+ *
+ * Header-only C++20 wrapper over project_neon.h. Clients and hosts are move-only
+ * owners of their native handle, messages are sent and received in batches through
+ * std::span, and events are dispatched to an overload set resolved at compile time.
+ * Every call is an inline forward to the C API: there are no virtual functions and
+ * nothing is allocated per message or event.
+ *
+ * The wrapper reports failure the way the C API does (false, -1 or an empty handle)
+ * so it can be used with exceptions disabled; neon::last_error() has the reason.
+ */
+
+#ifndef PROJECT_NEON_HPP
+#define PROJECT_NEON_HPP
+
+#include "project_neon.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace neon {
+
+/* ========== Runtime ========== */
+
+using RuntimeOptions = NeonRuntimeOptions;
+
+/**
+ * Gets the calling thread's last error, or an empty view if there is none.
+ */
+inline std::string_view last_error() noexcept {
+    const char* error = neon_get_last_error();
+    return error != nullptr ? std::string_view(error) : std::string_view();
+}
+
+/**
+ * Starts the embedded JVM on construction and destroys it when the scope ends.
+ * Declare it before any Client or Host so they are freed first.
+ */
+class Runtime {
+public:
+    explicit Runtime(const RuntimeOptions& options) noexcept
+        : started_(neon_runtime_init(&options)) {}
+
+    ~Runtime() {
+        if (started_) {
+            neon_runtime_shutdown();
+        }
+    }
+
+    Runtime(const Runtime&) = delete;
+    Runtime& operator=(const Runtime&) = delete;
+
+    explicit operator bool() const noexcept { return started_; }
+
+private:
+    bool started_;
+};
+
+/* ========== Messages ========== */
+
+/**
+ * A game message to queue for sending. destination_id 0 broadcasts to the session.
+ */
+struct OutgoingMessage {
+    std::uint8_t packet_type;
+    std::uint8_t destination_id;
+    std::span<const std::byte> payload;
+};
+
+/**
+ * A received game message. For Endpoint::receive the payload points into the caller's
+ * storage; inside an Endpoint::consume visitor it points into the receive ring and is
+ * only valid during the call.
+ */
+struct Message {
+    std::uint8_t packet_type;
+    std::uint8_t peer_id;
+    std::span<const std::byte> payload;
+};
+
+/* ========== Events ========== */
+
+struct Pong { std::uint64_t response_time_ms; std::uint64_t original_timestamp; };
+struct SessionConfig { std::uint8_t version; std::uint16_t tick_rate; std::uint16_t max_packet_size; };
+struct PacketTypeEntry { std::uint8_t id; std::string_view name; std::string_view description; };
+struct UnhandledPacket { std::uint8_t packet_type; std::uint8_t from_client_id; };
+struct WrongDestination { std::uint8_t my_id; std::uint8_t packet_destination_id; };
+struct Disconnect { std::uint8_t client_id; };
+struct ClientConnect { std::uint8_t client_id; std::uint32_t session_id; std::string_view name; };
+struct ClientDeny { std::string_view name; std::string_view reason; };
+struct PingReceived { std::uint8_t from_client_id; };
+struct ClientDisconnect { std::uint8_t client_id; };
+
+/**
+ * Builds an event handler from lambdas: overloaded{[](const Pong&) {...}, ...}.
+ */
+template <class... Fs>
+struct overloaded : Fs... {
+    using Fs::operator()...;
+};
+
+template <class... Fs>
+overloaded(Fs...) -> overloaded<Fs...>;
+
+namespace detail {
+
+inline std::string_view view(const char* s) noexcept {
+    return s != nullptr ? std::string_view(s) : std::string_view();
+}
+
+/* Calls handler(event) when the handler accepts that event type; other events are skipped */
+template <class Handler, class Event>
+inline void invoke_if(Handler& handler, const Event& event) {
+    if constexpr (std::is_invocable_v<Handler&, const Event&>) {
+        handler(event);
+    }
+}
+
+template <class Handler>
+inline void dispatch(Handler& handler, const NeonEvent& e) {
+    switch (e.type) {
+        case NEON_EVENT_PONG:
+            invoke_if(handler, Pong{e.data.pong.response_time_ms, e.data.pong.original_timestamp});
+            break;
+        case NEON_EVENT_SESSION_CONFIG:
+            invoke_if(handler, SessionConfig{e.data.session_config.version,
+                e.data.session_config.tick_rate, e.data.session_config.max_packet_size});
+            break;
+        case NEON_EVENT_PACKET_TYPE:
+            invoke_if(handler, PacketTypeEntry{e.data.packet_type.id,
+                view(e.data.packet_type.name), view(e.data.packet_type.description)});
+            break;
+        case NEON_EVENT_UNHANDLED_PACKET:
+            invoke_if(handler, UnhandledPacket{e.data.unhandled_packet.packet_type,
+                e.data.unhandled_packet.from_client_id});
+            break;
+        case NEON_EVENT_WRONG_DESTINATION:
+            invoke_if(handler, WrongDestination{e.data.wrong_destination.my_id,
+                e.data.wrong_destination.packet_destination_id});
+            break;
+        case NEON_EVENT_DISCONNECT:
+            invoke_if(handler, Disconnect{e.data.disconnect.client_id});
+            break;
+        case NEON_EVENT_CLIENT_CONNECT:
+            invoke_if(handler, ClientConnect{e.data.client_connect.client_id,
+                e.data.client_connect.session_id, view(e.data.client_connect.name)});
+            break;
+        case NEON_EVENT_CLIENT_DENY:
+            invoke_if(handler, ClientDeny{view(e.data.client_deny.name), view(e.data.client_deny.reason)});
+            break;
+        case NEON_EVENT_PING_RECEIVED:
+            invoke_if(handler, PingReceived{e.data.ping_received.from_client_id});
+            break;
+        case NEON_EVENT_CLIENT_DISCONNECT:
+            invoke_if(handler, ClientDisconnect{e.data.disconnect.client_id});
+            break;
+    }
+}
+
+/* Binds the handle-specific C functions so Endpoint can be written once */
+struct ClientApi {
+    using Handle = NeonClientHandle;
+    static void free(Handle* h) noexcept { neon_client_free(h); }
+    static int process_packets(Handle* h) noexcept { return neon_client_process_packets(h); }
+    static std::size_t poll_events(Handle* h, NeonEvent* out, std::size_t max) noexcept { return neon_client_poll_events(h, out, max); }
+    static bool enable_messaging(Handle* h, std::uint32_t capacity) noexcept { return neon_client_enable_messaging(h, capacity); }
+    static bool send_message(Handle* h, std::uint8_t type, std::uint8_t dest, const void* data, std::size_t length) noexcept {
+        return neon_client_send_message(h, type, dest, data, length);
+    }
+    static std::uint8_t* begin_message(Handle* h, std::size_t max_length) noexcept { return neon_client_begin_message(h, max_length); }
+    static bool commit_message(Handle* h, std::uint8_t type, std::uint8_t dest, std::size_t length) noexcept {
+        return neon_client_commit_message(h, type, dest, length);
+    }
+    static bool peek_message(Handle* h, NeonMessage* message) noexcept { return neon_client_peek_message(h, message); }
+    static void release_message(Handle* h) noexcept { neon_client_release_message(h); }
+};
+
+struct HostApi {
+    using Handle = NeonHostHandle;
+    static void free(Handle* h) noexcept { neon_host_free(h); }
+    static int process_packets(Handle* h) noexcept { return neon_host_process_packets(h); }
+    static std::size_t poll_events(Handle* h, NeonEvent* out, std::size_t max) noexcept { return neon_host_poll_events(h, out, max); }
+    static bool enable_messaging(Handle* h, std::uint32_t capacity) noexcept { return neon_host_enable_messaging(h, capacity); }
+    static bool send_message(Handle* h, std::uint8_t type, std::uint8_t dest, const void* data, std::size_t length) noexcept {
+        return neon_host_send_message(h, type, dest, data, length);
+    }
+    static std::uint8_t* begin_message(Handle* h, std::size_t max_length) noexcept { return neon_host_begin_message(h, max_length); }
+    static bool commit_message(Handle* h, std::uint8_t type, std::uint8_t dest, std::size_t length) noexcept {
+        return neon_host_commit_message(h, type, dest, length);
+    }
+    static bool peek_message(Handle* h, NeonMessage* message) noexcept { return neon_host_peek_message(h, message); }
+    static void release_message(Handle* h) noexcept { neon_host_release_message(h); }
+};
+
+} // namespace detail
+
+/* ========== Handles ========== */
+
+/**
+ * Shared part of Client and Host: ownership of the handle, packet processing, game
+ * messages and events. Not used directly.
+ */
+template <class Api>
+class Endpoint {
+public:
+    using Handle = typename Api::Handle;
+
+    /* Events polled per poll_events call inside dispatch_events */
+    static constexpr std::size_t EVENT_BATCH = 32;
+
+    Endpoint(const Endpoint&) = delete;
+    Endpoint& operator=(const Endpoint&) = delete;
+
+    /** Checks whether the handle was created successfully and not moved from. */
+    explicit operator bool() const noexcept { return handle_ != nullptr; }
+
+    /** Gets the underlying handle for C functions not wrapped here, such as callback setters. */
+    Handle* native_handle() const noexcept { return handle_; }
+
+    /** Gives up ownership of the handle; the caller must free it. */
+    Handle* release() noexcept { return std::exchange(handle_, nullptr); }
+
+    /** Processes incoming packets. Returns the number processed, or -1 on error. */
+    int process_packets() noexcept { return Api::process_packets(handle_); }
+
+    /** Allocates the message rings; see neon_client_enable_messaging. */
+    bool enable_messaging(std::uint32_t ring_capacity) noexcept {
+        return Api::enable_messaging(handle_, ring_capacity);
+    }
+
+    /** Queues one game message. Returns false if the send ring is full. */
+    bool send(std::uint8_t packet_type, std::uint8_t destination_id, std::span<const std::byte> payload) noexcept {
+        return Api::send_message(handle_, packet_type, destination_id, payload.data(), payload.size());
+    }
+
+    /**
+     * Queues messages in order until the send ring fills up.
+     *
+     * @return Number of messages queued; the rest can be retried after process_packets
+     */
+    std::size_t send(std::span<const OutgoingMessage> messages) noexcept {
+        std::size_t sent = 0;
+        for (const OutgoingMessage& m : messages) {
+            if (!Api::send_message(handle_, m.packet_type, m.destination_id, m.payload.data(), m.payload.size())) {
+                break;
+            }
+            sent++;
+        }
+        return sent;
+    }
+
+    /**
+     * Builds a message directly in the send ring: write(std::span<std::byte>) fills the
+     * reserved space and returns the bytes written.
+     *
+     * @return false if there was no room for max_length bytes
+     */
+    template <class Writer>
+    bool send_in_place(std::uint8_t packet_type, std::uint8_t destination_id, std::size_t max_length, Writer&& write) {
+        std::uint8_t* space = Api::begin_message(handle_, max_length);
+        if (space == nullptr) {
+            return false;
+        }
+        std::size_t length = std::forward<Writer>(write)(std::span<std::byte>(reinterpret_cast<std::byte*>(space), max_length));
+        return Api::commit_message(handle_, packet_type, destination_id, length);
+    }
+
+    /**
+     * Copies received messages into out, packing their payloads into storage. Stops early
+     * when either span is full; a message that does not fit stays queued.
+     *
+     * @return Number of messages written to out
+     */
+    std::size_t receive(std::span<Message> out, std::span<std::byte> storage) noexcept {
+        std::size_t count = 0;
+        std::size_t used = 0;
+        NeonMessage m;
+        while (count < out.size() && Api::peek_message(handle_, &m)) {
+            if (m.length > storage.size() - used) {
+                break;
+            }
+            std::byte* payload = storage.data() + used;
+            if (m.length > 0) {
+                std::memcpy(payload, m.data, m.length);
+            }
+            out[count++] = Message{m.packet_type, m.peer_id, std::span<const std::byte>(payload, m.length)};
+            used += m.length;
+            Api::release_message(handle_);
+        }
+        return count;
+    }
+
+    /**
+     * Passes up to max received messages to visit(const Message&) in place, consuming each
+     * after the call returns.
+     *
+     * @return Number of messages visited
+     */
+    template <class Visitor>
+    std::size_t consume(Visitor&& visit, std::size_t max = std::numeric_limits<std::size_t>::max()) {
+        std::size_t count = 0;
+        NeonMessage m;
+        while (count < max && Api::peek_message(handle_, &m)) {
+            visit(Message{m.packet_type, m.peer_id,
+                std::span<const std::byte>(reinterpret_cast<const std::byte*>(m.data), m.length)});
+            Api::release_message(handle_);
+            count++;
+        }
+        return count;
+    }
+
+    /** Copies up to out.size() queued events; see neon_client_poll_events. */
+    std::size_t poll_events(std::span<NeonEvent> out) noexcept {
+        return Api::poll_events(handle_, out.data(), out.size());
+    }
+
+    /**
+     * Delivers every queued event to the handler overload for its type, such as
+     * handler(const neon::Pong&). Event types the handler does not accept are skipped.
+     * Finds nothing if C callbacks are set on the handle.
+     *
+     * @return Number of events read
+     */
+    template <class Handler>
+    std::size_t dispatch_events(Handler&& handler) {
+        NeonEvent events[EVENT_BATCH];
+        std::size_t total = 0;
+        std::size_t n;
+        do {
+            n = Api::poll_events(handle_, events, EVENT_BATCH);
+            for (std::size_t i = 0; i < n; i++) {
+                detail::dispatch(handler, events[i]);
+            }
+            total += n;
+        } while (n == EVENT_BATCH);
+        return total;
+    }
+
+protected:
+    explicit Endpoint(Handle* handle) noexcept : handle_(handle) {}
+
+    Endpoint(Endpoint&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    Endpoint& operator=(Endpoint&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    ~Endpoint() { reset(); }
+
+    void reset() noexcept {
+        if (handle_ != nullptr) {
+            Api::free(std::exchange(handle_, nullptr));
+        }
+    }
+
+    Handle* handle_;
+};
+
+/**
+ * Owns a NeonClientHandle. Check with operator bool after construction.
+ */
+class Client : public Endpoint<detail::ClientApi> {
+public:
+    explicit Client(const char* name) noexcept : Endpoint(neon_client_new(name)) {}
+
+    /** Adopts a handle created with neon_client_new. */
+    static Client adopt(NeonClientHandle* handle) noexcept { return Client(handle, 0); }
+
+    Client(Client&&) noexcept = default;
+    Client& operator=(Client&&) noexcept = default;
+    ~Client() = default;
+
+    bool connect(std::uint32_t session_id, const char* relay_addr) noexcept {
+        return neon_client_connect(handle_, session_id, relay_addr);
+    }
+
+    std::uint8_t id() const noexcept { return neon_client_get_id(handle_); }
+    std::uint32_t session_id() const noexcept { return neon_client_get_session_id(handle_); }
+    bool is_connected() const noexcept { return neon_client_is_connected(handle_); }
+
+    bool send_ping() noexcept { return neon_client_send_ping(handle_); }
+    void set_auto_ping(bool enabled) noexcept { neon_client_set_auto_ping(handle_, enabled); }
+
+private:
+    Client(NeonClientHandle* handle, int) noexcept : Endpoint(handle) {}
+};
+
+/**
+ * Owns a NeonHostHandle. Check with operator bool after construction.
+ */
+class Host : public Endpoint<detail::HostApi> {
+public:
+    Host(std::uint32_t session_id, const char* relay_addr) noexcept
+        : Endpoint(neon_host_new(session_id, relay_addr)) {}
+
+    /** Adopts a handle created with neon_host_new. */
+    static Host adopt(NeonHostHandle* handle) noexcept { return Host(handle); }
+
+    Host(Host&&) noexcept = default;
+    Host& operator=(Host&&) noexcept = default;
+    ~Host() = default;
+
+    /** Registers the session with the relay and returns; call process_packets() to run the host. */
+    bool start() noexcept { return neon_host_start(handle_); }
+
+    std::uint32_t session_id() const noexcept { return neon_host_get_session_id(handle_); }
+    std::size_t client_count() const noexcept { return neon_host_get_client_count(handle_); }
+
+private:
+    explicit Host(NeonHostHandle* handle) noexcept : Endpoint(handle) {}
+};
+
+} // namespace neon
+
+#endif /* PROJECT_NEON_HPP */
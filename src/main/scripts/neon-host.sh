@@ -0,0 +1,8 @@
+#!/bin/sh
+# Launches neon-host.jar with its class-data-sharing archive (built by mvn -Pcds package).
+# If the archive is missing or was made by a different JDK, the JVM rebuilds it on exit.
+# Extra JVM options can be passed in JAVA_OPTS.
+DIR=$(cd "$(dirname "$0")" && pwd)
+JAVA="${JAVA_HOME:+$JAVA_HOME/bin/}java"
+exec "$JAVA" -XX:SharedArchiveFile="$DIR/neon-host.jsa" -XX:+AutoCreateSharedArchive $JAVA_OPTS \
+    -jar "$DIR/neon-host.jar" "$@"
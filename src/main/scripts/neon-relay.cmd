@@ -0,0 +1,7 @@
+@echo off
+rem Launches neon-relay.jar with its class-data-sharing archive (built by mvn -Pcds package).
+rem If the archive is missing or was made by a different JDK, the JVM rebuilds it on exit.
+rem Extra JVM options can be passed in JAVA_OPTS.
+set "JAVA=java"
+if defined JAVA_HOME set "JAVA=%JAVA_HOME%\bin\java"
+"%JAVA%" -XX:SharedArchiveFile="%~dp0neon-relay.jsa" -XX:+AutoCreateSharedArchive %JAVA_OPTS% -jar "%~dp0neon-relay.jar" %*
@@ -0,0 +1,59 @@
+package com.quietterminal.projectneon.core;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.net.InetSocketAddress;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Unit tests for AmplificationLimiter.
+ */
+class AmplificationLimiterTest {
+
+    private static final InetSocketAddress SOURCE = new InetSocketAddress("198.51.100.4", 5000);
+
+    @Test
+    @DisplayName("Unverified source may receive at most factor times the bytes it sent")
+    void testBudget() {
+        AmplificationLimiter limiter = new AmplificationLimiter(4, 3);
+        limiter.onReceived(0, 30);
+
+        assertTrue(limiter.trySend(0, SOURCE, 60));
+        assertTrue(limiter.trySend(0, SOURCE, 30));
+        assertFalse(limiter.trySend(0, SOURCE, 1));
+
+        limiter.onReceived(0, 10);
+        assertTrue(limiter.trySend(0, SOURCE, 30));
+    }
+
+    @Test
+    @DisplayName("Verified sources are unrestricted until their slot is reset")
+    void testVerification() {
+        AmplificationLimiter limiter = new AmplificationLimiter(4, 3);
+        limiter.markVerified(1, SOURCE);
+
+        assertTrue(limiter.trySend(1, SOURCE, 10_000));
+
+        limiter.reset(1);
+        assertFalse(limiter.isVerified(1));
+        assertFalse(limiter.trySend(1, SOURCE, 1));
+    }
+
+    @Test
+    @DisplayName("Sources without a slot need explicit verification")
+    void testUntrackedSources() {
+        AmplificationLimiter limiter = new AmplificationLimiter(4, 3);
+        limiter.onReceived(-1, 1000);
+
+        assertFalse(limiter.trySend(-1, SOURCE, 1));
+
+        limiter.markVerified(-1, SOURCE);
+        assertTrue(limiter.trySend(-1, SOURCE, 1000));
+
+        limiter.retainVerified(List.of());
+        assertFalse(limiter.trySend(-1, SOURCE, 1));
+    }
+}
@@ -0,0 +1,72 @@
+package com.quietterminal.projectneon.core;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.net.InetAddress;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Unit tests for CidrFilter.
+ */
+class CidrFilterTest {
+
+    @Test
+    @DisplayName("Block list drops matching IPv4 and IPv6 ranges only")
+    void testBlockList() throws Exception {
+        CidrFilter filter = CidrFilter.parse("", "203.0.113.0/24, 2001:db8::/32");
+
+        assertFalse(filter.allows(InetAddress.getByName("203.0.113.77")));
+        assertTrue(filter.allows(InetAddress.getByName("203.0.114.1")));
+        assertFalse(filter.allows(InetAddress.getByName("2001:db8:1::5")));
+        assertTrue(filter.allows(InetAddress.getByName("2001:db9::5")));
+        assertEquals(2, filter.size());
+    }
+
+    @Test
+    @DisplayName("Non-empty allow list drops everything it does not cover")
+    void testAllowList() throws Exception {
+        CidrFilter filter = CidrFilter.parse("10.0.0.0/8 192.168.1.5", "");
+
+        assertTrue(filter.allows(InetAddress.getByName("10.20.30.40")));
+        assertTrue(filter.allows(InetAddress.getByName("192.168.1.5")));
+        assertFalse(filter.allows(InetAddress.getByName("192.168.1.6")));
+        assertFalse(filter.allows(InetAddress.getByName("::1")));
+    }
+
+    @Test
+    @DisplayName("Longest prefix wins and block wins on equal prefixes")
+    void testLongestPrefix() throws Exception {
+        CidrFilter filter = CidrFilter.parse("10.1.0.0/16, 172.16.0.0/12", "10.0.0.0/8, 172.16.0.0/12");
+
+        assertFalse(filter.allows(InetAddress.getByName("10.2.0.1")));
+        assertTrue(filter.allows(InetAddress.getByName("10.1.200.1")));
+        assertFalse(filter.allows(InetAddress.getByName("172.16.0.1")));
+    }
+
+    @Test
+    @DisplayName("Invalid entries are rejected and empty lists allow everything")
+    void testParsing() throws Exception {
+        assertThrows(IllegalArgumentException.class, () -> CidrFilter.parse("", "10.0.0.0/33"));
+        assertThrows(IllegalArgumentException.class, () -> CidrFilter.parse("", "example.com/8"));
+        assertThrows(IllegalArgumentException.class, () -> CidrFilter.parse("/8", ""));
+
+        CidrFilter empty = CidrFilter.parse("", null);
+        assertTrue(empty.isEmpty());
+        assertTrue(empty.allows(InetAddress.getByName("198.51.100.1")));
+    }
+
+    @Test
+    @DisplayName("Raw address bytes match like the InetAddress they came from")
+    void testRawAddress() {
+        CidrFilter filter = CidrFilter.parse("", "203.0.113.0/24");
+        byte[] buffer = {(byte) 203, 0, 113, 9, 1, 2, 3, 4};
+
+        assertFalse(filter.allows(buffer, 4));
+        buffer[0] = (byte) 198;
+        assertTrue(filter.allows(buffer, 4));
+        assertThrows(IllegalArgumentException.class, () -> filter.allows(buffer, 8));
+        assertThrows(IllegalArgumentException.class, () -> filter.allows(buffer, 16));
+    }
+}
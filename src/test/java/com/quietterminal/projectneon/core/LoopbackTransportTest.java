@@ -0,0 +1,140 @@
+package com.quietterminal.projectneon.core;
+
+import com.quietterminal.projectneon.client.NeonClient;
+import com.quietterminal.projectneon.host.NeonHost;
+import com.quietterminal.projectneon.relay.NeonRelay;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.io.IOException;
+import java.net.BindException;
+import java.net.InetSocketAddress;
+import java.net.SocketAddress;
+import java.net.SocketTimeoutException;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Tests for {@link LoopbackTransport}: UDP-like addressing on a private network and the
+ * relay, host and client running over it.
+ */
+class LoopbackTransportTest {
+
+    private LoopbackTransport.Network network;
+
+    @BeforeEach
+    void setUp() {
+        network = new LoopbackTransport.Network();
+    }
+
+    @Test
+    @DisplayName("Should deliver a datagram with the sender's address as source")
+    void testRoundTrip() throws IOException {
+        try (LoopbackTransport sender = LoopbackTransport.bound(network, 0);
+             LoopbackTransport receiver = LoopbackTransport.bound(network, 7777)) {
+            byte[] message = "neon".getBytes(StandardCharsets.US_ASCII);
+            ByteBuffer data = ByteBuffer.wrap(message);
+            sender.send(data, new InetSocketAddress("127.0.0.1", 7777));
+            assertFalse(data.hasRemaining());
+
+            ByteBuffer buffer = ByteBuffer.allocateDirect(64);
+            SocketAddress source = receiver.receive(buffer);
+            assertEquals(sender.getLocalAddress(), source);
+            byte[] received = new byte[buffer.flip().remaining()];
+            buffer.get(received);
+            assertArrayEquals(message, received);
+            assertNull(receiver.receive(ByteBuffer.allocate(64)));
+        }
+    }
+
+    @Test
+    @DisplayName("Should reject a bound port until its endpoint closes")
+    void testPortBinding() throws IOException {
+        LoopbackTransport first = LoopbackTransport.bound(network, 9000);
+        assertThrows(BindException.class, () -> LoopbackTransport.bound(network, 9000));
+
+        LoopbackTransport ephemeral = LoopbackTransport.bound(network, 0);
+        assertTrue(((InetSocketAddress) ephemeral.getLocalAddress()).getPort() >= 49152);
+        assertEquals(2, network.size());
+
+        first.close();
+        ephemeral.close();
+        assertEquals(0, network.size());
+        LoopbackTransport.bound(network, 9000).close();
+    }
+
+    @Test
+    @DisplayName("Should time out in blocking mode and drop sends to unbound ports")
+    void testTimeoutAndUnboundDestination() throws IOException {
+        try (LoopbackTransport transport = LoopbackTransport.bound(network, 0)) {
+            transport.send(ByteBuffer.wrap(new byte[]{1}), new InetSocketAddress("127.0.0.1", 1234));
+
+            transport.setBlocking(true);
+            transport.setTimeout(50);
+            assertThrows(SocketTimeoutException.class, () -> transport.receive(ByteBuffer.allocate(64)));
+        }
+    }
+
+    @Test
+    @DisplayName("Relay, host and client should connect over a loopback network")
+    void testSessionOverLoopback() throws Exception {
+        NeonConfig config = new NeonConfig().setHostProcessingLoopSleepMs(1);
+        CountDownLatch connected = new CountDownLatch(1);
+
+        try (NeonRelay relay = new NeonRelay(LoopbackTransport.bound(network, 7777), config);
+             NeonHost host = new NeonHost(100, "127.0.0.1:7777", config, new LoopbackTransport(network));
+             NeonClient client = new NeonClient("loopback", config, new LoopbackTransport(network))) {
+            Thread relayThread = new Thread(() -> {
+                try {
+                    relay.startAndRun();
+                } catch (Exception e) {
+                    // Expected when relay is closed
+                }
+            });
+            relayThread.setDaemon(true);
+            relayThread.start();
+            host.setClientConnectCallback((clientId, name, sessionId) -> connected.countDown());
+            host.startAsync();
+
+            assertTrue(client.connect(100, "127.0.0.1:7777"));
+            assertTrue(connected.await(5, TimeUnit.SECONDS));
+        }
+    }
+
+    @Test
+    @DisplayName("Client should reconnect on a fresh transport from its factory")
+    void testReconnectWithTransportFactory() throws Exception {
+        NeonConfig config = new NeonConfig().setHostProcessingLoopSleepMs(1);
+
+        try (NeonRelay relay = new NeonRelay(LoopbackTransport.bound(network, 7777), config);
+             NeonHost host = new NeonHost(100, "127.0.0.1:7777", config, new LoopbackTransport(network));
+             NeonClient client = new NeonClient("factory", config, () -> new LoopbackTransport(network));
+             NeonClient fixed = new NeonClient("fixed", config, new LoopbackTransport(network))) {
+            Thread relayThread = new Thread(() -> {
+                try {
+                    relay.startAndRun();
+                } catch (Exception e) {
+                    // Expected when relay is closed
+                }
+            });
+            relayThread.setDaemon(true);
+            relayThread.start();
+            host.startAsync();
+
+            assertTrue(client.connect(100, "127.0.0.1:7777"));
+            byte clientId = client.getClientId().orElseThrow();
+            client.close();
+            assertTrue(client.reconnect(3));
+            assertEquals(clientId, client.getClientId().orElseThrow());
+
+            assertTrue(fixed.connect(100, "127.0.0.1:7777"));
+            fixed.close();
+            assertFalse(fixed.reconnect(3), "A single supplied transport cannot be reopened");
+        }
+    }
+}
@@ -9,6 +9,7 @@ import java.io.IOException;
 import java.net.InetSocketAddress;
 import java.net.SocketAddress;
 import java.net.SocketTimeoutException;
+import java.nio.ByteBuffer;
 import java.util.ArrayList;
 import java.util.List;
 
@@ -300,4 +301,26 @@ class NeonSocketTest {
         SocketAddress destination = new InetSocketAddress("127.0.0.1", 50000);
         assertDoesNotThrow(() -> socket.sendPacket(packet, destination));
     }
+
+    @Test
+    @DisplayName("Blocking buffer receive should skip rejected datagrams and truncate oversize ones")
+    void testBufferReceiveSkipsAndTruncates() throws IOException {
+        LoopbackTransport.Network network = new LoopbackTransport.Network();
+        socket = new NeonSocket(LoopbackTransport.bound(network, 7000), new NeonConfig());
+        socket.setBlocking(true);
+        socket.setSoTimeout(1000);
+
+        try (LoopbackTransport sender = LoopbackTransport.bound(network, 0)) {
+            byte[] packet = NeonPacket.create(PacketType.GAME_PACKET, (short) 1, (byte) 2, (byte) 1,
+                new PacketPayload.GamePacket(new byte[32])).toBytes();
+            sender.send(ByteBuffer.wrap(new byte[]{1, 2, 3, 4, 5, 6, 7, 8, 9}), socket.getLocalAddress());
+            sender.send(ByteBuffer.wrap(packet), socket.getLocalAddress());
+
+            ByteBuffer buffer = ByteBuffer.allocate(16);
+            assertEquals(sender.getLocalAddress(), socket.receive(buffer));
+            assertEquals(16, buffer.position());
+            assertEquals(1, socket.getRejectedDatagramCount());
+            assertThrows(SocketTimeoutException.class, () -> socket.receive(ByteBuffer.allocate(16)));
+        }
+    }
 }
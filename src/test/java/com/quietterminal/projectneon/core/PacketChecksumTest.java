@@ -0,0 +1,66 @@
+package com.quietterminal.projectneon.core;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Unit tests for PacketChecksum.
+ */
+class PacketChecksumTest {
+
+    private static byte[] samplePacket() {
+        return NeonPacket.create(
+            PacketType.GAME_PACKET, (short) 7, (byte) 2, (byte) 1,
+            new PacketPayload.GamePacket("hello".getBytes())
+        ).toBytes();
+    }
+
+    @Test
+    @DisplayName("Sealed packet verifies and unseals to the original bytes")
+    void testSealRoundTrip() {
+        byte[] plain = samplePacket();
+        byte[] sealed = PacketChecksum.seal(plain);
+
+        assertEquals(plain.length + PacketChecksum.TRAILER_SIZE, sealed.length);
+        assertEquals(PacketChecksum.Framing.CHECKSUMMED, PacketChecksum.inspect(sealed, sealed.length));
+        assertArrayEquals(plain, PacketChecksum.unseal(sealed, sealed.length));
+    }
+
+    @Test
+    @DisplayName("Plain packets are recognized without a trailer")
+    void testPlainFraming() {
+        byte[] plain = samplePacket();
+        assertEquals(PacketChecksum.Framing.PLAIN, PacketChecksum.inspect(plain, plain.length));
+    }
+
+    @Test
+    @DisplayName("A single flipped bit is rejected")
+    void testCorruptionDetected() {
+        byte[] sealed = PacketChecksum.seal(samplePacket());
+        sealed[10] ^= 0x04;
+        assertEquals(PacketChecksum.Framing.INVALID, PacketChecksum.inspect(sealed, sealed.length));
+    }
+
+    @Test
+    @DisplayName("Truncated datagrams and unknown magic are rejected without throwing")
+    void testGarbageRejected() {
+        byte[] sealed = PacketChecksum.seal(samplePacket());
+        assertEquals(PacketChecksum.Framing.INVALID, PacketChecksum.inspect(sealed, sealed.length - 1));
+        assertEquals(PacketChecksum.Framing.INVALID, PacketChecksum.inspect(new byte[16], 16));
+        assertEquals(PacketChecksum.Framing.INVALID, PacketChecksum.inspect(new byte[3], 3));
+    }
+
+    @Test
+    @DisplayName("SessionConfig carries the checksum flag and stays 5 bytes without it")
+    void testSessionConfigFlag() {
+        PacketPayload.SessionConfig plain = new PacketPayload.SessionConfig((byte) 1, (short) 60, (short) 1024);
+        PacketPayload.SessionConfig flagged = new PacketPayload.SessionConfig(
+            (byte) 1, (short) 60, (short) 1024, PacketPayload.SessionConfig.FLAG_CHECKSUM);
+
+        assertEquals(5, plain.toBytes().length);
+        assertTrue(PacketPayload.SessionConfig.fromBytes(flagged.toBytes())
+            .hasFlag(PacketPayload.SessionConfig.FLAG_CHECKSUM));
+    }
+}
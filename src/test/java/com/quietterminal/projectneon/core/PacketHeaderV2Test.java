@@ -0,0 +1,138 @@
+package com.quietterminal.projectneon.core;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.util.Arrays;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Unit tests for PacketHeaderV2 and version 2 packet framing.
+ */
+class PacketHeaderV2Test {
+
+    @Test
+    @DisplayName("Small v2 header encodes in 8 bytes and round-trips")
+    void testCompactRoundTrip() {
+        PacketHeaderV2 header = PacketHeaderV2.create((byte) 0x10, 5, 2, 1);
+        byte[] bytes = header.toBytes();
+
+        assertEquals(PacketHeaderV2.MIN_HEADER_SIZE, bytes.length);
+        assertEquals(PacketHeaderV2.VERSION, bytes[2]);
+        assertEquals(header, PacketHeaderV2.decode(bytes, 0, bytes.length));
+    }
+
+    @Test
+    @DisplayName("32-bit sequences, large ids, flags and extensions survive a round-trip")
+    void testFullRoundTrip() {
+        PacketHeaderV2 header = PacketHeaderV2.create((byte) 0x20, 0xFFFFFFFF, 300, 70000)
+            .withFlags(PacketHeaderV2.FLAG_FRAGMENT)
+            .withExtension(new PacketHeaderV2.Extension((byte) 1, new byte[]{1, 2, 3}));
+
+        byte[] bytes = header.toBytes();
+        PacketHeaderV2 decoded = PacketHeaderV2.decode(bytes, 0, bytes.length);
+
+        assertEquals(header, decoded);
+        assertEquals(0xFFFFFFFF, decoded.sequence());
+        assertTrue(decoded.hasFlag(PacketHeaderV2.FLAG_FRAGMENT));
+        assertTrue(decoded.hasFlag(PacketHeaderV2.FLAG_EXTENSIONS));
+        assertArrayEquals(new byte[]{1, 2, 3}, decoded.findExtension((byte) 1).data());
+        assertEquals(bytes.length, decoded.encodedSize());
+    }
+
+    @Test
+    @DisplayName("Connection id is carried only when set")
+    void testConnectionId() {
+        PacketHeaderV2 plain = PacketHeaderV2.create((byte) 0x10, 1, 2, 1);
+        PacketHeaderV2 withId = plain.withConnectionId(0x7EDC_BA98_1234_0005L);
+
+        byte[] bytes = withId.toBytes();
+        PacketHeaderV2 decoded = PacketHeaderV2.decode(bytes, 0, bytes.length);
+
+        assertFalse(plain.hasFlag(PacketHeaderV2.FLAG_CONNECTION_ID));
+        assertTrue(decoded.hasFlag(PacketHeaderV2.FLAG_CONNECTION_ID));
+        assertEquals(0x7EDC_BA98_1234_0005L, decoded.connectionId());
+        assertEquals(plain.encodedSize() + PacketHeaderV2.CONNECTION_ID_SIZE, withId.encodedSize());
+    }
+
+    @Test
+    @DisplayName("Truncated v2 headers are rejected")
+    void testTruncatedRejected() {
+        byte[] bytes = PacketHeaderV2.create((byte) 0x10, 1 << 28, 2, 1).toBytes();
+        byte[] truncated = Arrays.copyOf(bytes, bytes.length - 1);
+
+        assertThrows(IllegalArgumentException.class,
+            () -> PacketHeaderV2.decode(truncated, 0, truncated.length));
+    }
+
+    @Test
+    @DisplayName("Non-canonical v2 headers are rejected instead of shifting the payload")
+    void testNonCanonicalRejected() {
+        byte[] canonical = NeonPacket.createV2(PacketType.PING, 5, 2, 1, new PacketPayload.Ping(7L)).toBytes();
+
+        byte[] emptyExtensions = new byte[canonical.length + 1];
+        System.arraycopy(canonical, 0, emptyExtensions, 0, PacketHeaderV2.MIN_HEADER_SIZE);
+        emptyExtensions[4] |= PacketHeaderV2.FLAG_EXTENSIONS;
+        emptyExtensions[PacketHeaderV2.MIN_HEADER_SIZE] = 0;
+        System.arraycopy(canonical, PacketHeaderV2.MIN_HEADER_SIZE, emptyExtensions,
+            PacketHeaderV2.MIN_HEADER_SIZE + 1, canonical.length - PacketHeaderV2.MIN_HEADER_SIZE);
+
+        byte[] paddedVarint = new byte[canonical.length + 1];
+        System.arraycopy(canonical, 0, paddedVarint, 0, 5);
+        paddedVarint[5] = (byte) (canonical[5] | 0x80);
+        paddedVarint[6] = 0;
+        System.arraycopy(canonical, 6, paddedVarint, 7, canonical.length - 6);
+
+        assertEquals(new PacketPayload.Ping(7L), NeonPacket.fromBytes(canonical).payload());
+        assertThrows(IllegalArgumentException.class, () -> NeonPacket.fromBytes(emptyExtensions));
+        assertThrows(IllegalArgumentException.class, () -> NeonPacket.fromBytes(paddedVarint));
+        assertThrows(IllegalArgumentException.class,
+            () -> PacketHeaderV2.decode(new byte[]{0x45, 0x4E, 2, 0x0B, 0, (byte) 0xFF, (byte) 0xFF,
+                (byte) 0xFF, (byte) 0xFF, 0x7F, 0, 0}, 0, 12));
+    }
+
+    @Test
+    @DisplayName("NeonPacket decodes both header versions")
+    void testNeonPacketDispatch() {
+        PacketPayload.Ping ping = new PacketPayload.Ping(123L);
+        NeonPacket v1 = NeonPacket.create(PacketType.PING, (short) 9, (byte) 2, (byte) 1, ping);
+        NeonPacket v2 = NeonPacket.createV2(PacketType.PING, 100_000, 2, 1, ping);
+
+        NeonPacket decodedV1 = NeonPacket.fromBytes(v1.toBytes());
+        NeonPacket decodedV2 = NeonPacket.fromBytes(v2.toBytes());
+
+        assertFalse(decodedV1.isV2());
+        assertTrue(decodedV2.isV2());
+        assertEquals(100_000, decodedV2.fullSequence());
+        assertEquals(PacketHeader.VERSION, decodedV2.header().version());
+        assertEquals((byte) 1, decodedV2.header().destinationId());
+        assertEquals(ping, decodedV2.payload());
+    }
+
+    @Test
+    @DisplayName("Encoding a buffer slice matches serializing the copied payload")
+    void testEncodeSlice() {
+        byte[] buffer = {9, 9, 1, 2, 3, 9};
+        PacketPayload.GamePacket game = new PacketPayload.GamePacket(new byte[]{1, 2, 3});
+        NeonPacket v1 = NeonPacket.create(PacketType.GAME_PACKET, (short) 4, (byte) 2, (byte) 1, game);
+        NeonPacket v2 = NeonPacket.createV2(PacketType.GAME_PACKET, 4, 2, 1, game);
+
+        assertArrayEquals(v1.toBytes(), NeonPacket.encode(v1.header(), null, buffer, 2, 3));
+        assertArrayEquals(v2.toBytes(), NeonPacket.encode(null, v2.headerV2(), buffer, 2, 3));
+        assertThrows(IndexOutOfBoundsException.class, () -> NeonPacket.encode(v1.header(), null, buffer, 4, 3));
+    }
+
+    @Test
+    @DisplayName("Version negotiation picks the highest common version")
+    void testNegotiation() {
+        VersionMismatchHandler both = VersionMismatchHandler.lenient(PacketHeader.VERSION, PacketHeaderV2.VERSION)
+            .currentVersion(PacketHeaderV2.VERSION);
+        VersionMismatchHandler v1Only = VersionMismatchHandler.create();
+
+        assertEquals(PacketHeaderV2.VERSION, both.negotiate(PacketHeaderV2.VERSION).orElseThrow());
+        assertEquals(PacketHeader.VERSION, both.negotiate(PacketHeader.VERSION).orElseThrow());
+        assertEquals(PacketHeader.VERSION, v1Only.negotiate(PacketHeaderV2.VERSION).orElseThrow());
+        assertTrue(both.negotiate((byte) 0).isEmpty());
+    }
+}
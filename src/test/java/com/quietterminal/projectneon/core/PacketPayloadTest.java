@@ -509,6 +509,38 @@ class PacketPayloadTest {
         }
     }
 
+    @Nested
+    @DisplayName("MtuProbe Tests")
+    class MtuProbeTests {
+
+        @Test
+        @DisplayName("Padded PING and PONG should decode as probes and keep their size")
+        void testPaddedPingPongDecodeAsProbe() {
+            for (PacketType type : List.of(PacketType.PING, PacketType.PONG)) {
+                byte[] bytes = NeonPacket.create(type, (short) 1, (byte) 2, (byte) 1,
+                    new PacketPayload.MtuProbe(-7L, 1000)).toBytes();
+                NeonPacket decoded = NeonPacket.fromBytes(bytes);
+
+                PacketPayload.MtuProbe probe = assertInstanceOf(PacketPayload.MtuProbe.class, decoded.payload());
+                assertEquals(-7L, probe.probeId());
+                assertEquals(1000, probe.padding());
+                assertEquals(bytes.length, decoded.toBytes().length, "forwarding must not shrink the probe");
+            }
+        }
+
+        @Test
+        @DisplayName("Plain PING and PONG should still decode as timestamps")
+        void testPlainPingPongUnchanged() {
+            byte[] ping = NeonPacket.create(PacketType.PING, (short) 1, (byte) 2, (byte) 1,
+                new PacketPayload.Ping(42L)).toBytes();
+            byte[] pong = NeonPacket.create(PacketType.PONG, (short) 1, (byte) 1, (byte) 2,
+                new PacketPayload.Pong(42L)).toBytes();
+
+            assertInstanceOf(PacketPayload.Ping.class, NeonPacket.fromBytes(ping).payload());
+            assertInstanceOf(PacketPayload.Pong.class, NeonPacket.fromBytes(pong).payload());
+        }
+    }
+
     @Nested
     @DisplayName("DisconnectNotice Tests")
     class DisconnectNoticeTests {
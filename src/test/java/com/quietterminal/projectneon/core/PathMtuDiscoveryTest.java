@@ -0,0 +1,78 @@
+package com.quietterminal.projectneon.core;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Unit tests for PathMtuDiscovery.
+ */
+class PathMtuDiscoveryTest {
+
+    private static final long TIMEOUT = 100;
+    private static final long REVALIDATE = 10_000;
+
+    /**
+     * Drives discovery against a simulated path that delivers datagrams up to pathLimit.
+     */
+    private static long simulate(PathMtuDiscovery discovery, int pathLimit, long start, int rounds) {
+        long now = start;
+        long probeId = -1;
+        for (int i = 0; i < rounds; i++) {
+            int size = discovery.nextProbeSize(now);
+            if (size > 0) {
+                discovery.onProbeSent(probeId, now);
+                if (size <= pathLimit) {
+                    discovery.onProbeConfirmed(probeId);
+                }
+                probeId--;
+            }
+            now += TIMEOUT;
+        }
+        return now;
+    }
+
+    @Test
+    @DisplayName("Search converges just below the path limit")
+    void testConvergesToPathLimit() {
+        PathMtuDiscovery discovery = new PathMtuDiscovery(1472, 3, TIMEOUT, REVALIDATE);
+        simulate(discovery, 1400, 0, 100);
+
+        assertEquals(PathMtuDiscovery.State.SEARCH_COMPLETE, discovery.getState());
+        assertTrue(discovery.getPathMtu() <= 1400);
+        assertTrue(discovery.getPathMtu() > 1400 - PathMtuDiscovery.SEARCH_GRANULARITY);
+    }
+
+    @Test
+    @DisplayName("A path that drops every probe stays at the safe base")
+    void testBlackHoleStaysAtBase() {
+        PathMtuDiscovery discovery = new PathMtuDiscovery(1472, 3, TIMEOUT, REVALIDATE);
+        simulate(discovery, PathMtuDiscovery.BASE_MTU, 0, 100);
+
+        assertEquals(PathMtuDiscovery.BASE_MTU, discovery.getPathMtu());
+        assertEquals(PathMtuDiscovery.State.SEARCH_COMPLETE, discovery.getState());
+    }
+
+    @Test
+    @DisplayName("Failed revalidation falls back to the base and searches again")
+    void testFallbackWhenPathShrinks() {
+        PathMtuDiscovery discovery = new PathMtuDiscovery(1472, 3, TIMEOUT, REVALIDATE);
+        long now = simulate(discovery, 1472, 0, 100);
+        assertTrue(discovery.getPathMtu() > 1450);
+
+        simulate(discovery, 1300, now + REVALIDATE, 200);
+        assertTrue(discovery.getPathMtu() <= 1300);
+        assertTrue(discovery.getPathMtu() >= PathMtuDiscovery.BASE_MTU);
+    }
+
+    @Test
+    @DisplayName("Locally rejected probes shrink the search range immediately")
+    void testProbeTooLarge() {
+        PathMtuDiscovery discovery = new PathMtuDiscovery(9000, 3, TIMEOUT, REVALIDATE);
+        int first = discovery.nextProbeSize(0);
+        discovery.onProbeTooLarge();
+
+        assertTrue(discovery.nextProbeSize(0) < first);
+    }
+}
@@ -0,0 +1,86 @@
+package com.quietterminal.projectneon.core;
+
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Unit tests for PayloadRegistry and GamePacketRegistry.
+ */
+class PayloadRegistryTest {
+
+    private record Marker(byte[] bytes) implements PacketPayload {
+        @Override
+        public byte[] toBytes() {
+            return bytes;
+        }
+    }
+
+    @AfterEach
+    void tearDown() {
+        GamePacketRegistry.clearAll();
+    }
+
+    @Test
+    @DisplayName("Registered deserializer is used when decoding packets")
+    void testRegisteredDeserializerUsedForDecode() {
+        PayloadRegistry.register((byte) 0x42, Marker::new);
+
+        NeonPacket original = new NeonPacket(
+            PacketHeader.create((byte) 0x42, (short) 1, (byte) 2, (byte) 1),
+            new PacketPayload.GamePacket(new byte[]{1, 2, 3})
+        );
+        NeonPacket decoded = NeonPacket.fromBytes(original.toBytes());
+
+        assertInstanceOf(Marker.class, decoded.payload());
+        assertArrayEquals(new byte[]{1, 2, 3}, decoded.payload().toBytes());
+    }
+
+    @Test
+    @DisplayName("Unsigned packet types above 0x7F map to their own slots")
+    void testHighPacketTypes() {
+        PayloadRegistry.register((byte) 0xFF, Marker::new);
+
+        assertTrue(PayloadRegistry.isRegistered((byte) 0xFF));
+        assertFalse(PayloadRegistry.isRegistered((byte) 0x7F));
+        assertEquals(1, PayloadRegistry.registeredCount());
+    }
+
+    @Test
+    @DisplayName("Re-registering and unregistering keep the count consistent")
+    void testRegisteredCount() {
+        PayloadRegistry.register((byte) 0x20, Marker::new);
+        PayloadRegistry.register((byte) 0x20, PacketPayload.GamePacket::fromBytes);
+        PayloadRegistry.register((byte) 0x21, Marker::new);
+        assertEquals(2, PayloadRegistry.registeredCount());
+
+        assertTrue(PayloadRegistry.unregister((byte) 0x20));
+        assertFalse(PayloadRegistry.unregister((byte) 0x20));
+        assertEquals(1, PayloadRegistry.registeredCount());
+    }
+
+    @Test
+    @DisplayName("Core packet types cannot be registered")
+    void testCoreTypeRejected() {
+        assertThrows(IllegalArgumentException.class,
+            () -> PayloadRegistry.register((byte) 0x01, Marker::new));
+    }
+
+    @Test
+    @DisplayName("Game packet versions accumulate without replacing earlier ones")
+    void testGamePacketVersions() {
+        GamePacketDescriptor v1 = GamePacketDescriptor.builder((byte) 0x30).name("Move").version(1).build();
+        GamePacketDescriptor v2 = GamePacketDescriptor.builder((byte) 0x30).name("Move").version(2).build();
+
+        GamePacketRegistry.register(v1, Marker::new);
+        GamePacketRegistry.register(v2, PacketPayload.GamePacket::fromBytes);
+
+        assertEquals(2, GamePacketRegistry.getDescriptor((byte) 0x30).orElseThrow().getVersion());
+        assertEquals(2, GamePacketRegistry.getRegisteredVersions((byte) 0x30).size());
+        assertTrue(GamePacketRegistry.getDeserializer((byte) 0x30, 1).isPresent());
+        assertEquals(1, GamePacketRegistry.registeredCount());
+        assertThrows(IllegalStateException.class, () -> GamePacketRegistry.register(v2, Marker::new));
+    }
+}
@@ -0,0 +1,64 @@
+package com.quietterminal.projectneon.core;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.net.InetSocketAddress;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Unit tests for RetryCookie and the cookie fields of the connect payloads.
+ */
+class RetryCookieTest {
+
+    private static final long NOW = 1_700_000_000_000L;
+
+    @Test
+    @DisplayName("Cookie verifies for the issuing source within its lifetime")
+    void testIssueAndVerify() {
+        RetryCookie cookies = new RetryCookie(10_000);
+        InetSocketAddress source = new InetSocketAddress("203.0.113.7", 40000);
+
+        byte[] cookie = cookies.issue(source, NOW);
+
+        assertEquals(RetryCookie.COOKIE_LENGTH, cookie.length);
+        assertTrue(cookies.verify(cookie, source, NOW));
+        assertTrue(cookies.verify(cookie, source, NOW + 9_000));
+        assertFalse(cookies.verify(cookie, source, NOW + 12_000));
+    }
+
+    @Test
+    @DisplayName("Cookie is rejected for another address, port, key or when tampered")
+    void testRejectsMismatch() {
+        RetryCookie cookies = new RetryCookie(10_000);
+        InetSocketAddress source = new InetSocketAddress("203.0.113.7", 40000);
+        byte[] cookie = cookies.issue(source, NOW);
+
+        assertFalse(cookies.verify(cookie, new InetSocketAddress("203.0.113.8", 40000), NOW));
+        assertFalse(cookies.verify(cookie, new InetSocketAddress("203.0.113.7", 40001), NOW));
+        assertFalse(new RetryCookie(10_000).verify(cookie, source, NOW));
+        assertFalse(cookies.verify(new byte[0], source, NOW));
+
+        cookie[RetryCookie.COOKIE_LENGTH - 1] ^= 1;
+        assertFalse(cookies.verify(cookie, source, NOW));
+    }
+
+    @Test
+    @DisplayName("Connect payloads carry the cookie only when present")
+    void testPayloadRoundTrip() {
+        byte[] cookie = new RetryCookie(10_000).issue(new InetSocketAddress("127.0.0.1", 1), NOW);
+        PacketPayload.ConnectRequest plain = new PacketPayload.ConnectRequest((byte) 1, "Player", 5, 0);
+        PacketPayload.ConnectRequest withCookie = plain.withRetryCookie(cookie);
+        PacketPayload.ConnectDeny retry = new PacketPayload.ConnectDeny("Retry", cookie);
+
+        assertEquals(plain.toBytes().length + 1 + cookie.length, withCookie.toBytes().length);
+        assertEquals(withCookie, PacketPayload.ConnectRequest.fromBytes(withCookie.toBytes()));
+        assertEquals(plain, PacketPayload.ConnectRequest.fromBytes(plain.toBytes()));
+
+        PacketPayload.ConnectDeny decoded = PacketPayload.ConnectDeny.fromBytes(retry.toBytes());
+        assertTrue(decoded.isRetry());
+        assertArrayEquals(cookie, decoded.retryCookie());
+        assertFalse(new PacketPayload.ConnectDeny("Session is full").isRetry());
+    }
+}
@@ -0,0 +1,146 @@
+package com.quietterminal.projectneon.core;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.util.Arrays;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Unit tests for SessionCipher, KeyExchange and ReplayWindow.
+ */
+class SessionCipherTest {
+
+    private static final byte[] SECRET = new byte[KeyExchange.SECRET_LENGTH];
+
+    static {
+        for (int i = 0; i < SECRET.length; i++) {
+            SECRET[i] = (byte) i;
+        }
+    }
+
+    private static byte[] gamePacket(byte sender, byte[] payload) {
+        NeonPacket packet = new NeonPacket(
+            PacketHeader.create((byte) 0x10, (short) 7, sender, (byte) 0),
+            new PacketPayload.GamePacket(payload)
+        );
+        byte[] bytes = packet.toBytes();
+        return Arrays.copyOf(bytes, bytes.length + SessionCipher.OVERHEAD);
+    }
+
+    @Test
+    @DisplayName("Sealed game packets open to the original bytes")
+    void testRoundTrip() {
+        for (SessionCipher.Suite suite : SessionCipher.Suite.values()) {
+            assertRoundTrip(suite);
+        }
+    }
+
+    private static void assertRoundTrip(SessionCipher.Suite suite) {
+        SessionCipher sender = new SessionCipher(suite, SECRET);
+        SessionCipher receiver = new SessionCipher(suite, SECRET);
+        byte[] payload = "hello neon".getBytes();
+        byte[] buf = gamePacket((byte) 2, payload);
+        int plainLength = buf.length - SessionCipher.OVERHEAD;
+        byte[] plain = Arrays.copyOf(buf, plainLength);
+
+        int sealedLength = sender.seal(buf, plainLength);
+        assertEquals(plainLength + SessionCipher.OVERHEAD, sealedLength);
+        assertFalse(Arrays.equals(plain, Arrays.copyOf(buf, plainLength)));
+
+        assertEquals(plainLength, receiver.open(buf, sealedLength));
+        assertArrayEquals(plain, Arrays.copyOf(buf, plainLength));
+    }
+
+    @Test
+    @DisplayName("Replayed and tampered packets are rejected")
+    void testReplayAndTamper() {
+        SessionCipher sender = new SessionCipher(SessionCipher.Suite.AES_256_GCM, SECRET);
+        SessionCipher receiver = new SessionCipher(SessionCipher.Suite.AES_256_GCM, SECRET);
+        byte[] buf = gamePacket((byte) 2, new byte[32]);
+        int sealedLength = sender.seal(buf, buf.length - SessionCipher.OVERHEAD);
+        byte[] sealed = Arrays.copyOf(buf, sealedLength);
+
+        assertTrue(receiver.open(buf, sealedLength) > 0);
+        byte[] replay = sealed.clone();
+        assertEquals(-1, receiver.open(replay, sealedLength));
+
+        byte[] next = gamePacket((byte) 2, new byte[32]);
+        int nextLength = sender.seal(next, next.length - SessionCipher.OVERHEAD);
+        next[nextLength - 1] ^= 1;
+        assertEquals(-1, receiver.open(next, nextLength));
+
+        byte[] redirected = sealed.clone();
+        redirected[7] = 3;
+        assertEquals(-1, new SessionCipher(SessionCipher.Suite.AES_256_GCM, SECRET).open(redirected, sealedLength));
+        assertEquals(2, receiver.getRejectedCount());
+    }
+
+    @Test
+    @DisplayName("A joining sender starts with a fresh replay window")
+    void testResetSender() {
+        SessionCipher first = new SessionCipher(SessionCipher.Suite.AES_256_GCM, SECRET);
+        SessionCipher receiver = new SessionCipher(SessionCipher.Suite.AES_256_GCM, SECRET);
+        for (int i = 0; i < 3; i++) {
+            byte[] buf = gamePacket((byte) 2, new byte[8]);
+            assertTrue(receiver.open(buf, first.seal(buf, buf.length - SessionCipher.OVERHEAD)) > 0);
+        }
+
+        byte[] rejoined = gamePacket((byte) 2, new byte[8]);
+        int sealedLength = new SessionCipher(SessionCipher.Suite.AES_256_GCM, SECRET)
+            .seal(rejoined, rejoined.length - SessionCipher.OVERHEAD);
+        byte[] copy = Arrays.copyOf(rejoined, rejoined.length);
+        assertEquals(-1, receiver.open(copy, sealedLength), "Counter 0 was already seen for this sender");
+
+        receiver.resetSender((byte) 2);
+        assertTrue(receiver.open(rejoined, sealedLength) > 0);
+    }
+
+    @Test
+    @DisplayName("Core packets pass through unencrypted")
+    void testCorePacketsUntouched() {
+        SessionCipher cipher = new SessionCipher(SessionCipher.Suite.CHACHA20_POLY1305, SECRET);
+        byte[] ping = NeonPacket.create(PacketType.PING, (short) 1, (byte) 2, (byte) 1,
+            new PacketPayload.Ping(123L)).toBytes();
+
+        assertFalse(SessionCipher.covers(ping));
+        assertEquals(ping.length, cipher.open(ping.clone(), ping.length));
+    }
+
+    @Test
+    @DisplayName("Key exchange delivers the session secret to the client only")
+    void testKeyExchange() {
+        KeyExchange client = new KeyExchange();
+        KeyExchange host = new KeyExchange();
+
+        byte[] share = host.acceptShare(client.publicKey(), SessionCipher.Suite.AES_256_GCM, SECRET, 42, (byte) 2);
+        SessionCipher cipher = client.openAcceptShare(share, 42, (byte) 2);
+        assertEquals(SessionCipher.Suite.AES_256_GCM, cipher.getSuite());
+
+        assertThrows(IllegalArgumentException.class, () -> client.openAcceptShare(share, 42, (byte) 3));
+        assertThrows(IllegalArgumentException.class, () -> new KeyExchange().openAcceptShare(share, 42, (byte) 2));
+    }
+
+    @Test
+    @DisplayName("Replay window accepts reordering within the window only")
+    void testReplayWindow() {
+        ReplayWindow window = new ReplayWindow();
+        window.update(100);
+
+        assertTrue(window.check(99));
+        assertFalse(window.check(100));
+        assertFalse(window.check(100 - ReplayWindow.WINDOW_SIZE));
+        window.update(99);
+        assertFalse(window.check(99));
+
+        assertEquals(0x1_0000_0005L, expandAfter(0xFFFF_FFF0L, 5));
+        assertEquals(0xFFFF_FFF0L, expandAfter(0x1_0000_0005L, 0xFFFF_FFF0));
+    }
+
+    private static long expandAfter(long highest, int truncated) {
+        ReplayWindow window = new ReplayWindow();
+        window.update(highest);
+        return window.expand(truncated);
+    }
+}
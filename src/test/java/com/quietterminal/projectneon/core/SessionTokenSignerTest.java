@@ -0,0 +1,47 @@
+package com.quietterminal.projectneon.core;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Unit tests for SessionTokenSigner.
+ */
+class SessionTokenSignerTest {
+
+    private static final String KEY = "00112233445566778899aabbccddeeff";
+
+    @Test
+    @DisplayName("Token issued by the host verifies at a relay sharing the key")
+    void testSharedKey() {
+        SessionTokenSigner host = new SessionTokenSigner(SessionTokenSigner.parseKey(KEY));
+        SessionTokenSigner relay = new SessionTokenSigner(SessionTokenSigner.parseKey(KEY));
+
+        long token = host.issue(42, (byte) 3);
+
+        assertTrue(relay.verify(token, 42, (byte) 3));
+        assertFalse(relay.verify(token, 43, (byte) 3));
+        assertFalse(relay.verify(token, 42, (byte) 4));
+        assertFalse(relay.verify(token ^ 1, 42, (byte) 3));
+    }
+
+    @Test
+    @DisplayName("Tokens are not accepted under a different key")
+    void testDifferentKey() {
+        SessionTokenSigner host = new SessionTokenSigner(SessionTokenSigner.parseKey(KEY));
+        SessionTokenSigner other = new SessionTokenSigner(
+            SessionTokenSigner.parseKey("ffeeddccbbaa99887766554433221100"));
+
+        assertFalse(other.verify(host.issue(1, (byte) 2), 1, (byte) 2));
+    }
+
+    @Test
+    @DisplayName("Malformed keys are rejected")
+    void testParseKey() {
+        assertThrows(IllegalArgumentException.class, () -> SessionTokenSigner.parseKey("abcd"));
+        assertThrows(IllegalArgumentException.class,
+            () -> SessionTokenSigner.parseKey("zz112233445566778899aabbccddeeff"));
+        assertEquals(16, SessionTokenSigner.parseKey(KEY).length);
+    }
+}
@@ -0,0 +1,133 @@
+package com.quietterminal.projectneon.core;
+
+import com.quietterminal.projectneon.client.NeonClient;
+import com.quietterminal.projectneon.host.NeonHost;
+import com.quietterminal.projectneon.relay.NeonRelay;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.io.IOException;
+import java.net.InetSocketAddress;
+import java.net.SocketAddress;
+import java.net.SocketTimeoutException;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Arrays;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Tests for {@link SharedMemoryTransport}: both directions through the mapped rings,
+ * wake-ups of blocked receivers, UDP fallback routing, and a relay serving a host over
+ * shared memory while its client uses UDP.
+ */
+class SharedMemoryTransportTest {
+
+    @TempDir
+    Path dir;
+
+    @Test
+    @DisplayName("Should carry datagrams in both directions and report peer addresses")
+    void testRoundTrip() throws IOException {
+        Path file = dir.resolve("neon.shm");
+        try (SharedMemoryTransport relay = SharedMemoryTransport.create(file, 4096, null);
+             SharedMemoryTransport host = SharedMemoryTransport.open(file)) {
+            byte[] message = "neon".getBytes(StandardCharsets.US_ASCII);
+            host.send(ByteBuffer.wrap(message), new InetSocketAddress("127.0.0.1", 7777));
+
+            ByteBuffer buffer = ByteBuffer.allocate(64);
+            assertEquals(relay.getPeerAddress(), relay.receive(buffer));
+            assertArrayEquals(message, Arrays.copyOf(buffer.array(), buffer.position()));
+            assertNull(relay.receive(ByteBuffer.allocate(64)));
+
+            ByteBuffer direct = ByteBuffer.allocateDirect(64).put(message).flip();
+            relay.send(direct, relay.getPeerAddress());
+            assertFalse(direct.hasRemaining());
+            buffer.clear();
+            assertEquals(host.getPeerAddress(), host.receive(buffer));
+            assertEquals(message.length, buffer.position());
+        }
+        assertFalse(Files.exists(file));
+    }
+
+    @Test
+    @DisplayName("Should wake a blocked receiver and time out an idle one")
+    void testBlockingReceive() throws Exception {
+        Path file = dir.resolve("neon.shm");
+        try (SharedMemoryTransport relay = SharedMemoryTransport.create(file, 4096, null);
+             SharedMemoryTransport host = SharedMemoryTransport.open(file)) {
+            relay.setBlocking(true);
+            relay.setTimeout(50);
+            assertThrows(SocketTimeoutException.class, () -> relay.receive(ByteBuffer.allocate(64)));
+
+            relay.setTimeout(5000);
+            Thread sender = new Thread(() -> {
+                try {
+                    Thread.sleep(20);
+                    host.send(ByteBuffer.wrap(new byte[]{1, 2, 3}), relay.getLocalAddress());
+                } catch (Exception e) {
+                    throw new RuntimeException(e);
+                }
+            });
+            sender.start();
+            ByteBuffer buffer = ByteBuffer.allocate(64);
+            assertNotNull(relay.receive(buffer));
+            assertEquals(3, buffer.position());
+            sender.join();
+        }
+    }
+
+    @Test
+    @DisplayName("Should route other peers through the fallback transport")
+    void testFallbackRouting() throws IOException {
+        Path file = dir.resolve("neon.shm");
+        try (SharedMemoryTransport relay = SharedMemoryTransport.create(file, 4096, UdpTransport.bound(0, new NeonConfig()));
+             UdpTransport external = UdpTransport.bound(0, new NeonConfig())) {
+            relay.setBlocking(true);
+            relay.setTimeout(2000);
+            int relayPort = ((InetSocketAddress) relay.getLocalAddress()).getPort();
+            external.send(ByteBuffer.wrap(new byte[]{9}), new InetSocketAddress("127.0.0.1", relayPort));
+
+            SocketAddress source = relay.receive(ByteBuffer.allocate(64));
+            assertEquals(((InetSocketAddress) external.getLocalAddress()).getPort(), ((InetSocketAddress) source).getPort());
+            try (SharedMemoryTransport host = SharedMemoryTransport.open(file)) {
+                assertEquals(relayPort, host.getPeerAddress().getPort());
+            }
+        }
+    }
+
+    @Test
+    @DisplayName("Relay should serve a shared-memory host and a UDP client")
+    void testSessionOverSharedMemory() throws Exception {
+        Path file = dir.resolve("neon.shm");
+        NeonConfig config = new NeonConfig().setHostProcessingLoopSleepMs(1);
+        CountDownLatch connected = new CountDownLatch(1);
+
+        UdpTransport udp = UdpTransport.bound(0, config);
+        String relayAddress = "127.0.0.1:" + ((InetSocketAddress) udp.getLocalAddress()).getPort();
+        try (NeonRelay relay = new NeonRelay(SharedMemoryTransport.create(file, 1 << 16, udp), config);
+             NeonClient client = new NeonClient("udp-client", config)) {
+            try (NeonHost host = new NeonHost(100, relayAddress, config, SharedMemoryTransport.open(file))) {
+                Thread relayThread = new Thread(() -> {
+                    try {
+                        relay.startAndRun();
+                    } catch (Exception e) {
+                        // Expected when relay is closed
+                    }
+                });
+                relayThread.setDaemon(true);
+                relayThread.start();
+                host.setClientConnectCallback((clientId, name, sessionId) -> connected.countDown());
+                host.startAsync();
+
+                assertTrue(client.connect(100, relayAddress));
+                assertTrue(connected.await(5, TimeUnit.SECONDS));
+            }
+        }
+    }
+}
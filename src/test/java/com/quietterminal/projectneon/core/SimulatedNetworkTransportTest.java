@@ -0,0 +1,116 @@
+package com.quietterminal.projectneon.core;
+
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.io.IOException;
+import java.net.SocketAddress;
+import java.net.SocketTimeoutException;
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Tests for {@link SimulatedNetworkTransport} over a private loopback network.
+ */
+class SimulatedNetworkTransportTest {
+
+    private static final int DATAGRAMS = 200;
+
+    private LoopbackTransport.Network network;
+    private LoopbackTransport receiver;
+
+    @BeforeEach
+    void setUp() throws IOException {
+        network = new LoopbackTransport.Network();
+        receiver = LoopbackTransport.bound(network, 7000);
+        receiver.setBlocking(true);
+        receiver.setTimeout(200);
+    }
+
+    private List<Integer> exchange(SimulatedNetworkTransport.Conditions conditions) throws IOException {
+        try (SimulatedNetworkTransport sender = new SimulatedNetworkTransport(LoopbackTransport.bound(network, 0), conditions)) {
+            for (int i = 0; i < DATAGRAMS; i++) {
+                sender.send(ByteBuffer.allocate(4).putInt(0, i), receiver.getLocalAddress());
+            }
+            List<Integer> received = new ArrayList<>();
+            ByteBuffer buffer = ByteBuffer.allocate(4);
+            while (true) {
+                buffer.clear();
+                try {
+                    receiver.receive(buffer);
+                } catch (SocketTimeoutException e) {
+                    return received;
+                }
+                received.add(buffer.getInt(0));
+            }
+        }
+    }
+
+    @Test
+    @DisplayName("Same seed should lose the same datagrams")
+    void testSeededLossIsReproducible() throws IOException {
+        SimulatedNetworkTransport.Conditions conditions = new SimulatedNetworkTransport.Conditions()
+            .setLossRate(0.2).setSeed(42);
+
+        List<Integer> first = exchange(conditions);
+        List<Integer> second = exchange(conditions);
+        assertEquals(first, second);
+        assertTrue(first.size() > DATAGRAMS / 2 && first.size() < DATAGRAMS, "received " + first.size());
+        assertNotEquals(first, exchange(conditions.setSeed(43)));
+    }
+
+    @Test
+    @DisplayName("Jitter should reorder and duplication should repeat datagrams")
+    void testJitterAndDuplication() throws IOException {
+        List<Integer> reordered = exchange(new SimulatedNetworkTransport.Conditions()
+            .setLatencyMs(5).setJitterMs(20).setSeed(1));
+        assertEquals(DATAGRAMS, reordered.size());
+        assertNotEquals(reordered.stream().sorted().toList(), reordered);
+
+        List<Integer> duplicated = exchange(new SimulatedNetworkTransport.Conditions()
+            .setDuplicateRate(1.0).setSeed(1));
+        assertEquals(2 * DATAGRAMS, duplicated.size());
+    }
+
+    @Test
+    @DisplayName("Bandwidth cap should pace datagrams and drop beyond the queue limit")
+    void testBandwidthCap() throws IOException {
+        SimulatedNetworkTransport.Conditions conditions = new SimulatedNetworkTransport.Conditions()
+            .setBandwidthBytesPerSecond(4_000).setQueueLimitBytes(100);
+        try (SimulatedNetworkTransport sender = new SimulatedNetworkTransport(LoopbackTransport.bound(network, 0), conditions)) {
+            long start = System.nanoTime();
+            for (int i = 0; i < 50; i++) {
+                sender.send(ByteBuffer.allocate(20), receiver.getLocalAddress());
+            }
+            SimulatedNetworkTransport.Stats stats = sender.getStats();
+            assertEquals(50, stats.sent());
+            assertTrue(stats.overflowed() > 0);
+
+            int delivered = 0;
+            try {
+                while (true) {
+                    SocketAddress source = receiver.receive(ByteBuffer.allocate(20));
+                    assertEquals(sender.getLocalAddress(), source);
+                    delivered++;
+                }
+            } catch (SocketTimeoutException e) {
+                // Drained
+            }
+            assertEquals(stats.sent() - stats.overflowed(), delivered);
+            assertTrue(System.nanoTime() - start >= (delivered - 1) * 5_000_000L, "pacing too fast");
+        }
+    }
+
+    @Test
+    @DisplayName("Should reject invalid conditions")
+    void testInvalidConditions() {
+        SimulatedNetworkTransport.Conditions conditions = new SimulatedNetworkTransport.Conditions();
+        assertThrows(IllegalArgumentException.class, () -> conditions.setLossRate(1.5));
+        assertThrows(IllegalArgumentException.class, () -> conditions.setLatencyMs(-1));
+        assertThrows(IllegalArgumentException.class, () -> new SimulatedNetworkTransport(null, conditions));
+    }
+}
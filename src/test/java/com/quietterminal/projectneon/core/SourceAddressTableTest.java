@@ -0,0 +1,64 @@
+package com.quietterminal.projectneon.core;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Unit tests for SourceAddressTable.
+ */
+class SourceAddressTableTest {
+
+    @Test
+    @DisplayName("Same source interns to the same slot and canonical address")
+    void testInternIsStable() throws Exception {
+        SourceAddressTable table = new SourceAddressTable(8);
+        InetAddress loopback = InetAddress.getByName("127.0.0.1");
+
+        int first = table.intern(loopback, 7777);
+        int second = table.intern(InetAddress.getByName("127.0.0.1"), 7777);
+
+        assertEquals(first, second);
+        assertSame(table.addressOf(first), table.addressOf(second));
+        assertEquals(new InetSocketAddress(loopback, 7777), table.addressOf(first));
+        assertEquals(first, table.slotOf(new InetSocketAddress("127.0.0.1", 7777)));
+    }
+
+    @Test
+    @DisplayName("Different ports and address families get different slots")
+    void testDistinctSources() throws Exception {
+        SourceAddressTable table = new SourceAddressTable(8);
+
+        int a = table.intern(InetAddress.getByName("10.0.0.1"), 1000);
+        int b = table.intern(InetAddress.getByName("10.0.0.1"), 1001);
+        int c = table.intern(InetAddress.getByName("::1"), 1000);
+
+        assertNotEquals(a, b);
+        assertNotEquals(a, c);
+        assertNotEquals(b, c);
+        assertEquals(3, table.size());
+    }
+
+    @Test
+    @DisplayName("Full table rejects new sources until a slot is released")
+    void testCapacityAndRelease() throws Exception {
+        SourceAddressTable table = new SourceAddressTable(2);
+        InetAddress host = InetAddress.getByName("192.168.1.10");
+
+        int a = table.intern(host, 1);
+        int b = table.intern(host, 2);
+        assertEquals(-1, table.intern(host, 3));
+
+        table.release(a);
+        assertEquals(-1, table.slotOf(new InetSocketAddress(host, 1)));
+        assertEquals(b, table.slotOf(new InetSocketAddress(host, 2)));
+
+        int c = table.intern(host, 3);
+        assertEquals(a, c);
+        assertEquals(2, table.size());
+    }
+}
@@ -0,0 +1,126 @@
+package com.quietterminal.projectneon.core;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Unit tests for SpscByteRing and GameMessageRings.
+ */
+class SpscByteRingTest {
+
+    @Test
+    @DisplayName("Records come out in order across the wrap point")
+    void testWrapAround() {
+        SpscByteRing ring = SpscByteRing.allocate(256);
+        byte[] out = new byte[ring.maxRecordLength()];
+
+        for (int i = 0; i < 100; i++) {
+            byte[] record = new byte[i % 50];
+            Arrays.fill(record, (byte) i);
+            assertTrue(ring.offer(record, 0, record.length));
+            assertEquals(record.length, ring.peekLength());
+            assertEquals(record.length, ring.poll(out));
+            for (int j = 0; j < record.length; j++) {
+                assertEquals((byte) i, out[j]);
+            }
+        }
+        assertTrue(ring.isEmpty());
+        assertEquals(-1, ring.poll(out));
+    }
+
+    @Test
+    @DisplayName("A full ring refuses records until drained")
+    void testFullAndOversized() {
+        SpscByteRing ring = SpscByteRing.allocate(64);
+        byte[] record = new byte[12];
+
+        assertTrue(ring.offer(record, 0, record.length));
+        assertTrue(ring.offer(record, 0, record.length));
+        assertTrue(ring.offer(record, 0, record.length));
+        assertTrue(ring.offer(record, 0, record.length));
+        assertFalse(ring.offer(record, 0, record.length));
+        assertFalse(ring.offer(new byte[ring.maxRecordLength() + 1], 0, ring.maxRecordLength() + 1));
+
+        assertEquals(12, ring.poll(new byte[12]));
+        assertTrue(ring.offer(record, 0, record.length));
+    }
+
+    @Test
+    @DisplayName("Ring state lives in the buffer")
+    void testSharedBuffer() {
+        ByteBuffer memory = ByteBuffer.allocateDirect(SpscByteRing.HEADER_SIZE + 128);
+        SpscByteRing producer = new SpscByteRing(memory);
+        SpscByteRing consumer = new SpscByteRing(memory);
+
+        assertTrue(producer.offer((byte) 0x20, (byte) 3, new byte[]{7, 8}, 0, 2));
+        byte[] out = new byte[8];
+        assertEquals(4, consumer.poll(out));
+        assertArrayEquals(new byte[]{0x20, 3, 7, 8}, Arrays.copyOf(out, 4));
+
+        assertThrows(IllegalArgumentException.class, () -> new SpscByteRing(ByteBuffer.allocate(256)));
+        assertThrows(IllegalArgumentException.class, () -> new SpscByteRing(ByteBuffer.allocateDirect(SpscByteRing.HEADER_SIZE + 100)));
+    }
+
+    @Test
+    @DisplayName("Concurrent producer and consumer see every record once, in order")
+    void testConcurrent() throws InterruptedException {
+        SpscByteRing ring = SpscByteRing.allocate(1024);
+        int count = 50_000;
+        Thread producer = new Thread(() -> {
+            byte[] record = new byte[64];
+            for (int i = 0; i < count; ) {
+                int length = 4 + i % 60;
+                ByteBuffer.wrap(record).putInt(i);
+                if (ring.offer(record, 0, length)) {
+                    i++;
+                } else {
+                    Thread.yield();
+                }
+            }
+        });
+        producer.start();
+
+        byte[] out = new byte[ring.maxRecordLength()];
+        for (int i = 0; i < count; ) {
+            int length = ring.poll(out);
+            if (length < 0) {
+                Thread.yield();
+                continue;
+            }
+            assertEquals(4 + i % 60, length);
+            assertEquals(i, ByteBuffer.wrap(out).getInt());
+            i++;
+        }
+        producer.join();
+        assertTrue(ring.isEmpty());
+    }
+
+    @Test
+    @DisplayName("Message rings carry only game packets")
+    void testGameMessageRings() throws Exception {
+        GameMessageRings rings = GameMessageRings.allocate(256);
+        SpscByteRing engineOut = rings.getOutgoing();
+        engineOut.offer((byte) 0x10, (byte) 2, new byte[]{1, 2, 3}, 0, 3);
+        engineOut.offer((byte) 0x01, (byte) 2, new byte[0], 0, 0);
+
+        List<String> sent = new ArrayList<>();
+        assertEquals(1, rings.drainOutgoing((type, destination, buffer, offset, length) ->
+            sent.add(type + ":" + destination + ":" + buffer[offset] + ":" + length)));
+        assertEquals(List.of("16:2:1:3"), sent);
+
+        assertTrue(rings.deliver((byte) 0x11, (byte) 1, new byte[]{9}));
+        assertFalse(rings.deliver((byte) 0x05, (byte) 1, new byte[]{9}));
+        byte[] out = new byte[16];
+        assertEquals(3, rings.getIncoming().poll(out));
+        assertEquals(0x11, out[0]);
+        assertEquals(1, out[1]);
+        assertEquals(9, out[2]);
+    }
+}
@@ -0,0 +1,94 @@
+package com.quietterminal.projectneon.core;
+
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.io.IOException;
+import java.net.InetSocketAddress;
+import java.net.SocketAddress;
+import java.net.SocketTimeoutException;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Tests for the buffer-oriented {@link Transport} contract over UDP, and for
+ * {@link NeonSocket} layered on a supplied transport.
+ */
+class UdpTransportTest {
+
+    private UdpTransport sender;
+    private UdpTransport receiver;
+
+    @BeforeEach
+    void setUp() throws IOException {
+        sender = UdpTransport.bound(0, new NeonConfig());
+        receiver = UdpTransport.bound(0, new NeonConfig());
+        receiver.setBlocking(true);
+        receiver.setTimeout(2000);
+    }
+
+    @AfterEach
+    void tearDown() throws IOException {
+        sender.close();
+        receiver.close();
+    }
+
+    private static InetSocketAddress loopback(Transport transport) {
+        return new InetSocketAddress("127.0.0.1", ((InetSocketAddress) transport.getLocalAddress()).getPort());
+    }
+
+    @Test
+    @DisplayName("Should round-trip a datagram through heap and direct buffers")
+    void testBufferRoundTrip() throws IOException {
+        byte[] message = "neon".getBytes(StandardCharsets.US_ASCII);
+
+        for (ByteBuffer buffer : new ByteBuffer[]{ByteBuffer.allocate(64), ByteBuffer.allocateDirect(64)}) {
+            ByteBuffer data = ByteBuffer.wrap(message);
+            sender.send(data, loopback(receiver));
+            assertFalse(data.hasRemaining());
+
+            SocketAddress source = receiver.receive(buffer);
+            assertEquals(loopback(sender).getPort(), ((InetSocketAddress) source).getPort());
+            assertEquals(message.length, buffer.position());
+            byte[] received = new byte[message.length];
+            buffer.flip().get(received);
+            assertArrayEquals(message, received);
+        }
+    }
+
+    @Test
+    @DisplayName("Should return null without data in non-blocking mode and time out in blocking mode")
+    void testEmptyReceive() throws IOException {
+        receiver.setBlocking(false);
+        assertNull(receiver.receive(ByteBuffer.allocate(64)));
+
+        receiver.setBlocking(true);
+        receiver.setTimeout(50);
+        assertThrows(SocketTimeoutException.class, () -> receiver.receive(ByteBuffer.allocate(64)));
+    }
+
+    @Test
+    @DisplayName("NeonSocket over a supplied transport should deliver packets without framing")
+    void testNeonSocketOverTransport() throws IOException {
+        NeonConfig config = new NeonConfig();
+        config.setPacketChecksumEnabled(true);
+        try (NeonSocket from = new NeonSocket(UdpTransport.bound(0, config), config);
+             NeonSocket to = new NeonSocket(receiver, config)) {
+            to.setBlocking(true);
+            NeonPacket packet = NeonPacket.create(PacketType.GAME_PACKET, (short) 7, (byte) 2, (byte) 1,
+                new PacketPayload.GamePacket(new byte[]{1, 2, 3}));
+            from.sendPacket(packet, loopback(receiver));
+
+            ByteBuffer buffer = ByteBuffer.allocate(256);
+            assertNotNull(to.receive(buffer));
+            byte[] received = new byte[buffer.flip().remaining()];
+            buffer.get(received);
+            assertArrayEquals(packet.toBytes(), received);
+            assertSame(receiver, to.getTransport());
+        }
+    }
+}
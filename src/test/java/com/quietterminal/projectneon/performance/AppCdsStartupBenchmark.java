@@ -0,0 +1,54 @@
+package com.quietterminal.projectneon.performance;
+
+import org.junit.jupiter.api.Disabled;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Tag;
+import org.junit.jupiter.api.Test;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Arrays;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assumptions.assumeTrue;
+
+/**
+ * Measures relay startup as time from launch to the first forwarded packet, with class
+ * data sharing off, with the JDK's default archive, and with the application archive
+ * from {@code mvn -Pcds package}. Requires {@code target/neon-relay.jar} and
+ * {@code target/neon-relay.jsa}; skipped otherwise.
+ * Run with {@code mvn test -Dgroups=performance}.
+ */
+@Tag("performance")
+@Disabled("Benchmark - run explicitly with -Dgroups=performance")
+class AppCdsStartupBenchmark {
+
+    private static final int STARTUPS = 10;
+    private static final int SESSION_ID = 4343;
+    private static final long TIMEOUT_MS = 30_000;
+
+    @Test
+    @DisplayName("Relay time to first forwarded packet with and without AppCDS")
+    void benchmarkStartup() throws Exception {
+        Path jar = Path.of("target", "neon-relay.jar");
+        Path archive = Path.of("target", "neon-relay.jsa");
+        assumeTrue(Files.isRegularFile(jar) && Files.isRegularFile(archive),
+            "Relay JAR or CDS archive not found; build with mvn -Pcds package");
+
+        run("no CDS", RelayProcess.jarCommand(jar, List.of("-Xshare:off")));
+        run("JDK CDS", RelayProcess.jarCommand(jar, List.of()));
+        run("AppCDS", RelayProcess.jarCommand(jar, List.of("-XX:SharedArchiveFile=" + archive)));
+    }
+
+    private static void run(String label, List<String> command) throws Exception {
+        long[] startups = new long[STARTUPS];
+        for (int i = 0; i < STARTUPS; i++) {
+            try (RelayProcess relay = RelayProcess.launch(command, RelayProcess.freePort(), null)) {
+                startups[i] = relay.awaitFirstForwardedPacket(SESSION_ID + i, TIMEOUT_MS);
+            }
+        }
+        Arrays.sort(startups);
+        System.out.printf("%-8s first forwarded packet: %7.1f ms min, %7.1f ms median%n",
+            label + ":", startups[0] / 1e6, startups[STARTUPS / 2] / 1e6);
+    }
+}
@@ -0,0 +1,66 @@
+package com.quietterminal.projectneon.performance;
+
+import com.quietterminal.projectneon.jni.NeonClientJNI;
+import org.junit.jupiter.api.Disabled;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Tag;
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.*;
+import static org.junit.jupiter.api.Assumptions.assumeTrue;
+
+/**
+ * Measures the per-call cost of the JNI bridge. Requires libneon_jni on
+ * {@code java.library.path}; skipped otherwise.
+ * Run with {@code mvn test -Dgroups=performance -Djava.library.path=src/main/native/build}.
+ *
+ * <p>{@code neonClientSetAutoPing} makes one upcall into Java, so comparing it against a
+ * build from before method IDs were cached shows the saved {@code GetMethodID} lookup.
+ * {@code neonClientGetId} answers from the handle's cached state without any upcall.
+ */
+@Tag("performance")
+@Disabled("Benchmark - run explicitly with -Dgroups=performance")
+class JniCallBenchmark {
+
+    private static final int WARMUP = 200_000;
+    private static final int ITERATIONS = 2_000_000;
+
+    @Test
+    @DisplayName("Per-call overhead of JNI getters and upcalls")
+    void benchmarkCalls() {
+        long client;
+        try {
+            client = NeonClientJNI.neonClientNew("bench");
+        } catch (UnsatisfiedLinkError e) {
+            assumeTrue(false, "neon_jni library not available: " + e.getMessage());
+            return;
+        }
+        assertNotEquals(0, client, NeonClientJNI.neonGetLastError());
+
+        try {
+            long sink = 0;
+            for (int i = 0; i < WARMUP; i++) {
+                sink += NeonClientJNI.neonClientGetId(client);
+                NeonClientJNI.neonClientSetAutoPing(client, (i & 1) == 0);
+            }
+
+            long start = System.nanoTime();
+            for (int i = 0; i < ITERATIONS; i++) {
+                sink += NeonClientJNI.neonClientGetId(client);
+            }
+            long getter = System.nanoTime() - start;
+
+            start = System.nanoTime();
+            for (int i = 0; i < ITERATIONS; i++) {
+                NeonClientJNI.neonClientSetAutoPing(client, (i & 1) == 0);
+            }
+            long upcall = System.nanoTime() - start;
+
+            System.out.printf("neonClientGetId (cached state): %6.1f ns/call%n", getter / (double) ITERATIONS);
+            System.out.printf("neonClientSetAutoPing (upcall): %6.1f ns/call%n", upcall / (double) ITERATIONS);
+            assertEquals(-(long) (WARMUP + ITERATIONS), sink);
+        } finally {
+            NeonClientJNI.neonClientFree(client);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+package com.quietterminal.projectneon.performance;
+
+import org.junit.jupiter.api.Disabled;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Tag;
+import org.junit.jupiter.api.Test;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+
+import static org.junit.jupiter.api.Assertions.*;
+import static org.junit.jupiter.api.Assumptions.assumeTrue;
+
+/**
+ * Compares the relay as a GraalVM native image against the JVM build: time to first
+ * forwarded packet, resident memory after startup and under load, and steady-state
+ * forwarding rate for one client. Requires the image from {@code mvn -Pnative package};
+ * skipped otherwise.
+ * Run with {@code mvn test -Dgroups=performance -Dneon.relay.image=target/neon-relay}.
+ */
+@Tag("performance")
+@Disabled("Benchmark - run explicitly with -Dgroups=performance")
+class NativeImageBenchmark {
+
+    private static final int STARTUPS = 5;
+    private static final int SESSION_ID = 4242;
+    private static final long TIMEOUT_MS = 30_000;
+    private static final long WARMUP_MS = 2_000;
+    private static final long MEASURE_MS = 5_000;
+    private static final int PAYLOAD_SIZE = 64;
+
+    @Test
+    @DisplayName("Native image vs JVM relay startup, RSS and forwarding rate")
+    void benchmarkNativeImage() throws Exception {
+        Path image = Path.of(System.getProperty("neon.relay.image", "target/neon-relay"));
+        assumeTrue(Files.isExecutable(image), "Native relay image not found: " + image);
+
+        run("jvm", RelayProcess.jvmCommand(List.of()));
+        run("native", List.of(image.toString()));
+    }
+
+    private static void run(String label, List<String> command) throws Exception {
+        Path config = RelayProcess.unthrottledConfig();
+
+        long best = Long.MAX_VALUE;
+        long total = 0;
+        for (int i = 0; i < STARTUPS; i++) {
+            try (RelayProcess relay = RelayProcess.launch(command, RelayProcess.freePort(), config)) {
+                long startup = relay.awaitFirstForwardedPacket(SESSION_ID + i, TIMEOUT_MS);
+                best = Math.min(best, startup);
+                total += startup;
+            }
+        }
+
+        try (RelayProcess relay = RelayProcess.launch(command, RelayProcess.freePort(), config)) {
+            relay.awaitFirstForwardedPacket(SESSION_ID, TIMEOUT_MS);
+            long idleRss = relay.residentSetKb();
+            relay.measureForwardingRate(WARMUP_MS, PAYLOAD_SIZE);
+            double rate = relay.measureForwardingRate(MEASURE_MS, PAYLOAD_SIZE);
+            long loadedRss = relay.residentSetKb();
+
+            System.out.printf("%-7s first forwarded packet: %7.1f ms best, %7.1f ms mean%n",
+                label + ":", best / 1e6, total / 1e6 / STARTUPS);
+            System.out.printf("%-7s RSS: %7d KB idle, %7d KB under load%n", label + ":", idleRss, loadedRss);
+            System.out.printf("%-7s forwarding: %10.0f packets/s (%d-byte payload)%n", label + ":", rate, PAYLOAD_SIZE);
+            assertTrue(rate > 0, label + " relay forwarded no packets");
+        }
+    }
+}
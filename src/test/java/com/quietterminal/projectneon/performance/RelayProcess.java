@@ -0,0 +1,224 @@
+package com.quietterminal.projectneon.performance;
+
+import com.quietterminal.projectneon.client.NeonClient;
+import com.quietterminal.projectneon.core.Lifecycle;
+import com.quietterminal.projectneon.core.NeonConfig;
+import com.quietterminal.projectneon.host.NeonHost;
+
+import java.io.IOException;
+import java.net.DatagramPacket;
+import java.net.DatagramSocket;
+import java.net.InetSocketAddress;
+import java.net.PortUnreachableException;
+import java.net.SocketTimeoutException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.atomic.AtomicLong;
+
+/**
+ * A relay running in a child process, driven by an in-process host and client, for the
+ * benchmarks that compare relay builds. Not a test itself.
+ *
+ * <p>Startup is measured from process launch to the moment the host receives the first
+ * packet forwarded by the relay, the client's connect request, which is when a restarted
+ * relay is actually serving traffic.
+ */
+final class RelayProcess implements AutoCloseable {
+
+    static final String MAIN_CLASS = "com.quietterminal.projectneon.relay.RelayMain";
+    static final byte GAME_PACKET_TYPE = 0x10;
+
+    private static final byte HOST_ID = 1;
+    private static final int PROBE_INTERVAL_MS = 1;
+
+    private final Process process;
+    private final long launchedAt;
+    private final String address;
+    private final AtomicLong received = new AtomicLong();
+    private volatile long firstForwardedAt;
+    private NeonHost host;
+    private NeonClient client;
+
+    private RelayProcess(Process process, long launchedAt, String address) {
+        this.process = process;
+        this.launchedAt = launchedAt;
+        this.address = address;
+    }
+
+    /**
+     * Builds a command that runs the relay on this JVM with the test classpath.
+     */
+    static List<String> jvmCommand(List<String> jvmOptions) {
+        List<String> command = new ArrayList<>();
+        command.add(Path.of(System.getProperty("java.home"), "bin", "java").toString());
+        command.addAll(jvmOptions);
+        command.add("-cp");
+        command.add(System.getProperty("java.class.path"));
+        command.add(MAIN_CLASS);
+        return command;
+    }
+
+    /**
+     * Builds a command that runs the relay from a standalone JAR, as the launch scripts do.
+     */
+    static List<String> jarCommand(Path jar, List<String> jvmOptions) {
+        List<String> command = new ArrayList<>();
+        command.add(Path.of(System.getProperty("java.home"), "bin", "java").toString());
+        command.addAll(jvmOptions);
+        command.add("-jar");
+        command.add(jar.toString());
+        return command;
+    }
+
+    /**
+     * Writes a relay config that lifts the per-client rate limit, so throughput runs
+     * measure forwarding rather than the limiter.
+     */
+    static Path unthrottledConfig() throws IOException {
+        Path file = Files.createTempFile("neon-bench", ".properties");
+        file.toFile().deleteOnExit();
+        Files.writeString(file, "limits.maxPacketsPerSecond=100000000\n");
+        return file;
+    }
+
+    /**
+     * Picks a loopback UDP port that is free at the time of the call.
+     */
+    static int freePort() throws IOException {
+        try (DatagramSocket socket = new DatagramSocket(0)) {
+            return socket.getLocalPort();
+        }
+    }
+
+    /**
+     * Starts the relay command bound to the given loopback port.
+     */
+    static RelayProcess launch(List<String> command, int port, Path config) throws IOException {
+        List<String> full = new ArrayList<>(command);
+        full.add("--bind");
+        full.add("127.0.0.1:" + port);
+        if (config != null) {
+            full.add("--config");
+            full.add(config.toString());
+        }
+        ProcessBuilder builder = new ProcessBuilder(full)
+            .redirectErrorStream(true)
+            .redirectOutput(ProcessBuilder.Redirect.DISCARD);
+        long launchedAt = System.nanoTime();
+        return new RelayProcess(builder.start(), launchedAt, "127.0.0.1:" + port);
+    }
+
+    /**
+     * Waits for the relay to bind, registers a host, connects a client through it and
+     * returns the nanoseconds from launch until the host saw the first forwarded packet.
+     */
+    long awaitFirstForwardedPacket(int sessionId, long timeoutMs) throws Exception {
+        long deadline = System.nanoTime() + timeoutMs * 1_000_000L;
+        awaitBound(deadline);
+
+        NeonConfig hostConfig = new NeonConfig()
+            .setHostProcessingLoopSleepMs(1)
+            .setHostSocketTimeoutMs(1);
+        host = new NeonHost(sessionId, address, hostConfig);
+        host.setClientConnectCallback((clientId, name, session) -> {
+            if (firstForwardedAt == 0) {
+                firstForwardedAt = System.nanoTime();
+            }
+        });
+        host.setUnhandledPacketCallback((packetType, from) -> received.incrementAndGet());
+        host.startAsync();
+        while (host.getState() != Lifecycle.State.RUNNING) {
+            checkDeadline(deadline, "host registration");
+            Thread.onSpinWait();
+        }
+
+        client = new NeonClient("bench", new NeonConfig().setClientConnectionTimeoutMs((int) timeoutMs));
+        if (!client.connect(sessionId, address) || firstForwardedAt == 0) {
+            throw new IOException("Client failed to connect through relay at " + address);
+        }
+        return firstForwardedAt - launchedAt;
+    }
+
+    /**
+     * Sends game packets from the client to the host for the given time and returns the
+     * rate at which the host received them, in packets per second.
+     */
+    double measureForwardingRate(long durationMs, int payloadSize) throws IOException, InterruptedException {
+        byte[] payload = new byte[payloadSize];
+        received.set(0);
+        long start = System.nanoTime();
+        long end = start + durationMs * 1_000_000L;
+        while (System.nanoTime() < end) {
+            client.sendGamePacket(GAME_PACKET_TYPE, HOST_ID, payload);
+        }
+        Thread.sleep(100);
+        return received.get() * 1e9 / (System.nanoTime() - start - 100_000_000L);
+    }
+
+    /**
+     * Gets the relay's resident set size in kilobytes, or -1 where /proc is unavailable.
+     */
+    long residentSetKb() {
+        try {
+            for (String line : Files.readAllLines(Path.of("/proc", Long.toString(process.pid()), "status"))) {
+                if (line.startsWith("VmRSS:")) {
+                    return Long.parseLong(line.replaceAll("\\D", ""));
+                }
+            }
+        } catch (IOException | NumberFormatException e) {
+            return -1;
+        }
+        return -1;
+    }
+
+    @Override
+    public void close() throws Exception {
+        try {
+            if (client != null) {
+                client.close();
+            }
+            if (host != null) {
+                host.close();
+            }
+        } finally {
+            process.destroy();
+            process.waitFor();
+        }
+    }
+
+    /**
+     * Polls the relay port with a one-byte datagram until it stops answering with ICMP
+     * port unreachable. The relay drops the probe as malformed.
+     */
+    private void awaitBound(long deadline) throws IOException {
+        try (DatagramSocket probe = new DatagramSocket()) {
+            String[] parts = address.split(":");
+            probe.connect(new InetSocketAddress(parts[0], Integer.parseInt(parts[1])));
+            probe.setSoTimeout(PROBE_INTERVAL_MS);
+            DatagramPacket packet = new DatagramPacket(new byte[1], 1);
+            while (true) {
+                checkDeadline(deadline, "relay bind");
+                if (!process.isAlive()) {
+                    throw new IOException("Relay exited with status " + process.exitValue());
+                }
+                try {
+                    probe.send(packet);
+                    probe.receive(packet);
+                    return;
+                } catch (PortUnreachableException e) {
+                    continue;
+                } catch (SocketTimeoutException e) {
+                    return;
+                }
+            }
+        }
+    }
+
+    private static void checkDeadline(long deadline, String stage) throws IOException {
+        if (System.nanoTime() > deadline) {
+            throw new IOException("Timed out waiting for " + stage);
+        }
+    }
+}
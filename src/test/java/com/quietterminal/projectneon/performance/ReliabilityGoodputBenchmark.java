@@ -0,0 +1,389 @@
+package com.quietterminal.projectneon.performance;
+
+import com.quietterminal.projectneon.core.*;
+import org.junit.jupiter.api.Disabled;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Tag;
+import org.junit.jupiter.api.Test;
+
+import java.io.IOException;
+import java.net.SocketAddress;
+import java.nio.ByteBuffer;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Locale;
+import java.util.concurrent.locks.LockSupport;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Runs reliable traffic between two endpoints over {@link SimulatedNetworkTransport}-impaired
+ * loopback links for a matrix of loss rates, round-trip times and message sizes, once with
+ * {@link ReliablePacketManager} on both ends (one ACK per packet) and once with a host-style
+ * {@link AckStateMachine} sender and a {@link BatchAckManager} receiver.
+ *
+ * <p>For each cell it reports goodput (unique payload bytes delivered per second),
+ * retransmission ratio (extra data datagrams per message), ACK bytes sent per payload byte
+ * delivered, p50 and p99 delivery latency from first transmission, and messages that a
+ * {@code ReliablePacketManager} receiver discarded as duplicates although they were new.
+ * Results are printed and written to {@code target/reliability-goodput.csv} and
+ * {@code .json}; set {@code -Dneon.bench.report=<path prefix>} to write elsewhere.
+ *
+ * <p>Timeouts and retries come from {@link NeonConfig}, except that the retransmission
+ * timeout defaults to 250 ms instead of 2 s so the matrix finishes in minutes. Set
+ * {@code -Dneon.bench.timeoutMs} to override it. Loss is seeded per cell, so two runs see the
+ * same loss pattern and differences come from the code under test.
+ * Run with {@code mvn test -Dgroups=performance -Dtest=ReliabilityGoodputBenchmark}.
+ */
+@Tag("performance")
+@Disabled("Benchmark - run explicitly with -Dgroups=performance")
+class ReliabilityGoodputBenchmark {
+
+    private static final double[] LOSS_RATES = {0.0, 0.01, 0.05, 0.10, 0.20};
+    private static final int[] RTTS_MS = {2, 40, 150};
+    private static final int[] MESSAGE_SIZES = {64, 512, 1200};
+    private static final int MESSAGES = 300;
+    private static final int WINDOW = 32;
+    private static final long CELL_LIMIT_MS = 60_000;
+    private static final byte SENDER_ID = 1;
+    private static final byte RECEIVER_ID = 2;
+
+    private enum Variant { RELIABLE_PACKET_MANAGER, ACK_STATE_MACHINE }
+
+    private record Result(Variant variant, double lossRate, int rttMs, int messageSize, int delivered,
+                          int discarded, long elapsedNanos, long dataDatagrams, long ackBytes,
+                          double p50Ms, double p99Ms) {
+        double goodputBytesPerSecond() {
+            return delivered * (double) messageSize * 1e9 / elapsedNanos;
+        }
+
+        double retransmissionRatio() {
+            return (dataDatagrams - MESSAGES) / (double) MESSAGES;
+        }
+
+        double ackBytesPerPayloadByte() {
+            return delivered == 0 ? 0 : ackBytes / ((double) delivered * messageSize);
+        }
+    }
+
+    @Test
+    @DisplayName("Goodput, retransmissions, ACK overhead and latency versus loss")
+    void benchmarkGoodputVersusLoss() throws Exception {
+        NeonConfig config = new NeonConfig()
+            .setReliablePacketTimeoutMs(Integer.getInteger("neon.bench.timeoutMs", 250));
+
+        List<Result> results = new ArrayList<>();
+        long seed = 0;
+        for (Variant variant : Variant.values()) {
+            for (int rtt : RTTS_MS) {
+                for (int size : MESSAGE_SIZES) {
+                    for (double loss : LOSS_RATES) {
+                        Result result = run(variant, loss, rtt, size, config, ++seed);
+                        results.add(result);
+                        System.out.println(csvRow(result));
+                        if (loss == 0.0) {
+                            assertEquals(MESSAGES, result.delivered(), "lossless cell lost messages");
+                        }
+                    }
+                }
+            }
+        }
+
+        String prefix = System.getProperty("neon.bench.report", "target/reliability-goodput");
+        writeReport(Path.of(prefix + ".csv"), Path.of(prefix + ".json"), results);
+        System.out.println("Report written to " + prefix + ".csv and " + prefix + ".json");
+    }
+
+    private static Result run(Variant variant, double loss, int rttMs, int messageSize, NeonConfig config,
+                              long seed) throws IOException {
+        LoopbackTransport.Network network = new LoopbackTransport.Network();
+        SimulatedNetworkTransport.Conditions forward = new SimulatedNetworkTransport.Conditions()
+            .setLossRate(loss).setLatencyMs(rttMs / 2).setSeed(seed);
+        SimulatedNetworkTransport.Conditions reverse = new SimulatedNetworkTransport.Conditions()
+            .setLossRate(loss).setLatencyMs(rttMs - rttMs / 2).setSeed(~seed);
+
+        try (CountingTransport sender = new CountingTransport(
+                new SimulatedNetworkTransport(LoopbackTransport.bound(network, 0), forward));
+             CountingTransport receiver = new CountingTransport(
+                new SimulatedNetworkTransport(LoopbackTransport.bound(network, 0), reverse))) {
+            return new Exchange(variant, loss, rttMs, messageSize, config, sender, receiver).run();
+        }
+    }
+
+    /**
+     * One cell: a single thread drives both ends so that no scheduling noise is added
+     * beyond the simulated links.
+     */
+    private static final class Exchange {
+        private final Variant variant;
+        private final double loss;
+        private final int rttMs;
+        private final int messageSize;
+        private final CountingTransport sender;
+        private final CountingTransport receiver;
+        private final ReliablePacketManager reliableSender;
+        private final ReliablePacketManager reliableReceiver;
+        private final AckStateMachine ackStateMachine;
+        private final BatchAckManager batchAcks;
+        private final long[] firstSent = new long[MESSAGES];
+        private final long[] latency = new long[MESSAGES];
+        private final boolean[] received = new boolean[MESSAGES];
+        private final ByteBuffer buffer = ByteBuffer.allocate(2048);
+        private int delivered;
+        private int discarded;
+
+        Exchange(Variant variant, double loss, int rttMs, int messageSize, NeonConfig config,
+                 CountingTransport sender, CountingTransport receiver) {
+            this.variant = variant;
+            this.loss = loss;
+            this.rttMs = rttMs;
+            this.messageSize = messageSize;
+            this.sender = sender;
+            this.receiver = receiver;
+            SocketAddress senderAddress = sender.getLocalAddress();
+            SocketAddress receiverAddress = receiver.getLocalAddress();
+            if (variant == Variant.RELIABLE_PACKET_MANAGER) {
+                reliableSender = new ReliablePacketManager(sender, receiverAddress, SENDER_ID, config);
+                reliableReceiver = new ReliablePacketManager(receiver, senderAddress, RECEIVER_ID, config);
+                ackStateMachine = null;
+                batchAcks = null;
+            } else {
+                reliableSender = null;
+                reliableReceiver = null;
+                ackStateMachine = AckStateMachine.fromConfig(config, false);
+                batchAcks = new BatchAckManager(receiver, senderAddress, RECEIVER_ID,
+                    config.getBatchAckMaxSize(), config.getBatchAckMaxDelayMs());
+            }
+        }
+
+        Result run() throws IOException {
+            byte[] payload = new byte[messageSize];
+            long start = System.nanoTime();
+            long limit = start + CELL_LIMIT_MS * 1_000_000L;
+            int next = 0;
+
+            while (System.nanoTime() < limit) {
+                boolean progress = false;
+                while (next < MESSAGES && pending() < WINDOW) {
+                    firstSent[next] = System.nanoTime();
+                    send(next++, payload);
+                    progress = true;
+                }
+                progress |= drainReceiver();
+                progress |= drainSender();
+                retransmit();
+                if (next == MESSAGES && pending() == 0 && (batchAcks == null || batchAcks.getPendingCount() == 0)) {
+                    break;
+                }
+                if (!progress) {
+                    LockSupport.parkNanos(100_000);
+                }
+            }
+            long elapsed = System.nanoTime() - start;
+
+            long[] samples = new long[delivered];
+            for (int i = 0, j = 0; i < MESSAGES; i++) {
+                if (received[i]) {
+                    samples[j++] = latency[i];
+                }
+            }
+            Arrays.sort(samples);
+            return new Result(variant, loss, rttMs, messageSize, delivered, discarded, elapsed,
+                sender.datagrams, receiver.bytes, percentileMs(samples, 0.50), percentileMs(samples, 0.99));
+        }
+
+        private int pending() {
+            return reliableSender != null ? reliableSender.getPendingCount() : ackStateMachine.pendingCount();
+        }
+
+        private void send(int index, byte[] payload) throws IOException {
+            if (reliableSender != null) {
+                reliableSender.sendReliable(payload, RECEIVER_ID);
+                return;
+            }
+            NeonPacket packet = NeonPacket.create(PacketType.GAME_PACKET, (short) index, SENDER_ID, RECEIVER_ID,
+                new PacketPayload.GamePacket(payload));
+            sender.sendPacket(packet, receiver.getLocalAddress());
+            ackStateMachine.track((short) index, packet);
+        }
+
+        private boolean drainReceiver() throws IOException {
+            boolean any = false;
+            NeonPacket packet;
+            while ((packet = poll(receiver)) != null) {
+                any = true;
+                short sequence = packet.header().sequence();
+                boolean duplicate;
+                if (reliableReceiver != null) {
+                    duplicate = reliableReceiver.handleReceivedReliable(SENDER_ID, sequence);
+                } else {
+                    batchAcks.queueAck(sequence);
+                    duplicate = received[sequence];
+                }
+                if (!received[sequence]) {
+                    received[sequence] = true;
+                    latency[sequence] = System.nanoTime() - firstSent[sequence];
+                    delivered++;
+                    if (duplicate) {
+                        discarded++;
+                    }
+                }
+            }
+            if (batchAcks != null) {
+                batchAcks.flushIfNeeded();
+            }
+            return any;
+        }
+
+        private boolean drainSender() throws IOException {
+            boolean any = false;
+            NeonPacket packet;
+            while ((packet = poll(sender)) != null) {
+                any = true;
+                if (packet.payload() instanceof PacketPayload.Ack ack) {
+                    if (reliableSender != null) {
+                        reliableSender.handleAck(ack.acknowledgedSequences());
+                    } else {
+                        ackStateMachine.acknowledgeAll(ack.acknowledgedSequences());
+                    }
+                }
+            }
+            return any;
+        }
+
+        private void retransmit() throws IOException {
+            if (reliableSender != null) {
+                reliableSender.processRetransmissions();
+                return;
+            }
+            AckStateMachine.ProcessResult result = ackStateMachine.process();
+            for (AckStateMachine.PendingPacket retry : result.needsRetry()) {
+                sender.sendPacket(retry.packet(), receiver.getLocalAddress());
+                ackStateMachine.markResent(retry.sequence());
+            }
+        }
+
+        private NeonPacket poll(Transport transport) throws IOException {
+            buffer.clear();
+            if (transport.receive(buffer) == null) {
+                return null;
+            }
+            return NeonPacket.fromBytes(Arrays.copyOf(buffer.array(), buffer.position()));
+        }
+    }
+
+    private static double percentileMs(long[] sorted, double percentile) {
+        if (sorted.length == 0) {
+            return Double.NaN;
+        }
+        int index = (int) Math.ceil(percentile * sorted.length) - 1;
+        return sorted[Math.max(0, index)] / 1e6;
+    }
+
+    private static final String CSV_HEADER = "variant,loss_rate,rtt_ms,message_size,messages,delivered,discarded,"
+        + "elapsed_ms,goodput_bytes_per_s,retransmission_ratio,ack_bytes,ack_bytes_per_payload_byte,p50_ms,p99_ms";
+
+    private static String csvRow(Result r) {
+        return String.format(Locale.ROOT, "%s,%.2f,%d,%d,%d,%d,%d,%.1f,%.0f,%.3f,%d,%.4f,%.2f,%.2f",
+            r.variant(), r.lossRate(), r.rttMs(), r.messageSize(), MESSAGES, r.delivered(), r.discarded(),
+            r.elapsedNanos() / 1e6, r.goodputBytesPerSecond(), r.retransmissionRatio(), r.ackBytes(),
+            r.ackBytesPerPayloadByte(), r.p50Ms(), r.p99Ms());
+    }
+
+    private static void writeReport(Path csv, Path json, List<Result> results) throws IOException {
+        StringBuilder csvText = new StringBuilder(CSV_HEADER).append('\n');
+        StringBuilder jsonText = new StringBuilder("[\n");
+        for (int i = 0; i < results.size(); i++) {
+            Result r = results.get(i);
+            csvText.append(csvRow(r)).append('\n');
+            jsonText.append(String.format(Locale.ROOT,
+                "  {\"variant\": \"%s\", \"lossRate\": %.2f, \"rttMs\": %d, \"messageSize\": %d, \"messages\": %d, "
+                    + "\"delivered\": %d, \"discarded\": %d, \"elapsedMs\": %.1f, \"goodputBytesPerSecond\": %.0f, "
+                    + "\"retransmissionRatio\": %.3f, \"ackBytes\": %d, \"ackBytesPerPayloadByte\": %.4f, "
+                    + "\"p50Ms\": %s, \"p99Ms\": %s}%s%n",
+                r.variant(), r.lossRate(), r.rttMs(), r.messageSize(), MESSAGES, r.delivered(), r.discarded(),
+                r.elapsedNanos() / 1e6, r.goodputBytesPerSecond(), r.retransmissionRatio(), r.ackBytes(),
+                r.ackBytesPerPayloadByte(), jsonNumber(r.p50Ms()), jsonNumber(r.p99Ms()),
+                i + 1 < results.size() ? "," : ""));
+        }
+        jsonText.append("]\n");
+
+        if (csv.getParent() != null) {
+            Files.createDirectories(csv.getParent());
+        }
+        Files.writeString(csv, csvText);
+        Files.writeString(json, jsonText);
+    }
+
+    private static String jsonNumber(double value) {
+        return Double.isNaN(value) ? "null" : String.format(Locale.ROOT, "%.2f", value);
+    }
+
+    /**
+     * Counts datagrams and bytes handed to the simulated link, including ones it then loses.
+     */
+    private static final class CountingTransport implements Transport {
+        private final Transport transport;
+        private long datagrams;
+        private long bytes;
+
+        CountingTransport(Transport transport) {
+            this.transport = transport;
+        }
+
+        @Override
+        public Type getType() {
+            return transport.getType();
+        }
+
+        @Override
+        public void bind(int port) throws IOException {
+            transport.bind(port);
+        }
+
+        @Override
+        public SocketAddress getLocalAddress() {
+            return transport.getLocalAddress();
+        }
+
+        @Override
+        public void send(ByteBuffer data, SocketAddress address) throws IOException {
+            datagrams++;
+            bytes += data.remaining();
+            transport.send(data, address);
+        }
+
+        @Override
+        public SocketAddress receive(ByteBuffer buffer) throws IOException {
+            return transport.receive(buffer);
+        }
+
+        @Override
+        public void setBlocking(boolean blocking) throws IOException {
+            transport.setBlocking(blocking);
+        }
+
+        @Override
+        public boolean isBlocking() {
+            return transport.isBlocking();
+        }
+
+        @Override
+        public void setTimeout(int timeoutMs) throws IOException {
+            transport.setTimeout(timeoutMs);
+        }
+
+        @Override
+        public boolean isClosed() {
+            return transport.isClosed();
+        }
+
+        @Override
+        public void close() throws IOException {
+            transport.close();
+        }
+    }
+}
@@ -0,0 +1,67 @@
+package com.quietterminal.projectneon.performance;
+
+import com.quietterminal.projectneon.core.*;
+import org.junit.jupiter.api.Disabled;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Tag;
+import org.junit.jupiter.api.Test;
+
+import java.util.Arrays;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Measures the per-packet cost of session encryption on a 200-byte game packet.
+ * Run with {@code mvn test -Dgroups=performance}.
+ */
+@Tag("performance")
+@Disabled("Benchmark - run explicitly with -Dgroups=performance")
+class SessionCipherBenchmark {
+
+    private static final int PACKET_SIZE = 200;
+    private static final int WARMUP = 200_000;
+    private static final int ITERATIONS = 1_000_000;
+
+    @Test
+    @DisplayName("Seal and open overhead per 200-byte packet")
+    void benchmarkSealOpen() {
+        byte[] secret = new byte[KeyExchange.SECRET_LENGTH];
+        Arrays.fill(secret, (byte) 0x5A);
+        byte[] payload = new byte[PACKET_SIZE - PacketHeader.HEADER_SIZE];
+        byte[] packet = NeonPacket.create(PacketType.GAME_PACKET, (short) 0, (byte) 2, (byte) 0,
+            new PacketPayload.GamePacket(payload)).toBytes();
+        assertEquals(PACKET_SIZE, packet.length);
+
+        long baseline = run(null, null, packet);
+        System.out.printf("copy only:           %6.1f ns/packet%n", baseline / (double) ITERATIONS);
+
+        for (SessionCipher.Suite suite : SessionCipher.Suite.values()) {
+            SessionCipher sender = new SessionCipher(suite, secret);
+            SessionCipher receiver = new SessionCipher(suite, secret);
+            long elapsed = run(sender, receiver, packet);
+            System.out.printf("%-20s %6.1f ns/packet (+%.1f ns, +%d bytes)%n", suite.getConfigName() + ":",
+                elapsed / (double) ITERATIONS, (elapsed - baseline) / (double) ITERATIONS, SessionCipher.OVERHEAD);
+            assertEquals(0, receiver.getRejectedCount());
+        }
+    }
+
+    private static long run(SessionCipher sender, SessionCipher receiver, byte[] packet) {
+        byte[] buf = new byte[packet.length + SessionCipher.OVERHEAD];
+        long checksum = 0;
+        long start = 0;
+        for (int i = 0; i < WARMUP + ITERATIONS; i++) {
+            if (i == WARMUP) {
+                start = System.nanoTime();
+            }
+            System.arraycopy(packet, 0, buf, 0, packet.length);
+            int length = packet.length;
+            if (sender != null) {
+                length = receiver.open(buf, sender.seal(buf, length));
+            }
+            checksum += length + buf[length - 1];
+        }
+        long elapsed = System.nanoTime() - start;
+        assertTrue(checksum != 0);
+        return elapsed;
+    }
+}
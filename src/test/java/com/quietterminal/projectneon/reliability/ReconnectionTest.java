@@ -1,11 +1,15 @@
 package com.quietterminal.projectneon.reliability;
 
 import com.quietterminal.projectneon.client.NeonClient;
+import com.quietterminal.projectneon.core.*;
 import com.quietterminal.projectneon.host.NeonHost;
 import com.quietterminal.projectneon.relay.NeonRelay;
 import org.junit.jupiter.api.*;
 
 import java.io.IOException;
+import java.net.InetSocketAddress;
+import java.nio.ByteBuffer;
+import java.util.Arrays;
 import java.util.concurrent.*;
 import java.util.concurrent.atomic.AtomicInteger;
 
@@ -325,4 +329,53 @@ public class ReconnectionTest {
         client.close();
         host.close();
     }
+
+    @Test
+    @DisplayName("Relay rebind by signed token rotates the token and rejects replays")
+    public void testSignedTokenRebindRejectsReplay() throws Exception {
+        NeonConfig config = new NeonConfig()
+            .setSessionTokenKey("00112233445566778899aabbccddeeff")
+            .setHostProcessingLoopSleepMs(1);
+        LoopbackTransport.Network network = new LoopbackTransport.Network();
+        InetSocketAddress relayAddr = new InetSocketAddress("127.0.0.1", 7777);
+
+        try (NeonRelay loopbackRelay = new NeonRelay(LoopbackTransport.bound(network, 7777), config);
+             NeonHost host = new NeonHost(TEST_SESSION_ID, "127.0.0.1:7777", config, new LoopbackTransport(network));
+             NeonClient client = new NeonClient("TestClient", config, new LoopbackTransport(network))) {
+            executor.submit(() -> {
+                try {
+                    loopbackRelay.startAndRun();
+                } catch (Exception e) {
+                    // Expected when relay is closed
+                }
+            });
+            host.startAsync();
+            assertTrue(client.connect(TEST_SESSION_ID, "127.0.0.1:7777"));
+
+            byte clientId = client.getClientId().orElseThrow();
+            long token = client.getSessionToken().orElseThrow();
+            byte[] request = NeonPacket.create(PacketType.RECONNECT_REQUEST, (short) 0, clientId, (byte) 1,
+                new PacketPayload.ReconnectRequest(token, TEST_SESSION_ID, clientId)).toBytes();
+
+            PacketPayload accepted = sendFromNewAddress(network, request, relayAddr);
+            PacketPayload.ConnectAccept accept = assertInstanceOf(PacketPayload.ConnectAccept.class, accepted,
+                "Current token should rebind the client at the relay");
+            assertNotEquals(token, accept.sessionToken(), "Rebind should issue a fresh token");
+
+            assertInstanceOf(PacketPayload.ConnectDeny.class, sendFromNewAddress(network, request, relayAddr),
+                "A replayed request with the superseded token must be denied");
+        }
+    }
+
+    private static PacketPayload sendFromNewAddress(LoopbackTransport.Network network, byte[] request,
+                                                    InetSocketAddress relayAddr) throws IOException {
+        try (LoopbackTransport transport = LoopbackTransport.bound(network, 0)) {
+            transport.setBlocking(true);
+            transport.setTimeout(2000);
+            transport.send(ByteBuffer.wrap(request), relayAddr);
+            ByteBuffer buffer = ByteBuffer.allocate(512);
+            transport.receive(buffer);
+            return NeonPacket.fromBytes(Arrays.copyOf(buffer.array(), buffer.position())).payload();
+        }
+    }
 }
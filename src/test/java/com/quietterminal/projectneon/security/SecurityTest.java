@@ -8,13 +8,19 @@ import org.junit.jupiter.api.*;
 
 import java.io.IOException;
 import java.net.InetSocketAddress;
+import java.net.SocketAddress;
 import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
 import java.nio.charset.StandardCharsets;
 import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.HashSet;
 import java.util.List;
+import java.util.Set;
+import java.util.concurrent.CopyOnWriteArrayList;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.Executors;
+import java.util.concurrent.atomic.AtomicInteger;
 
 import static org.junit.jupiter.api.Assertions.*;
 
@@ -361,4 +367,258 @@ class SecurityTest {
             legitimateClient.close();
         }
     }
+
+    @Test
+    @Order(14)
+    @DisplayName("Should migrate a connection id only after the new address answers a path challenge")
+    void testConnectionMigrationRequiresPathChallenge() throws Exception {
+        NeonConfig config = new NeonConfig().setMaxHeaderVersion(2).setHostProcessingLoopSleepMs(1);
+        LoopbackTransport.Network network = new LoopbackTransport.Network();
+        RecordingTransport clientTransport = new RecordingTransport(new LoopbackTransport(network));
+        InetSocketAddress relayAddr = new InetSocketAddress("127.0.0.1", 7777);
+        AtomicInteger pongs = new AtomicInteger();
+
+        try (NeonRelay loopbackRelay = new NeonRelay(LoopbackTransport.bound(network, 7777), config);
+             NeonHost loopbackHost = new NeonHost(100, "127.0.0.1:7777", config, new LoopbackTransport(network));
+             NeonClient client = new NeonClient("victim", config, clientTransport);
+             LoopbackTransport attacker = LoopbackTransport.bound(network, 0)) {
+            Thread relayThread = new Thread(() -> {
+                try {
+                    loopbackRelay.startAndRun();
+                } catch (Exception e) {
+                    // Expected when relay is closed
+                }
+            });
+            relayThread.setDaemon(true);
+            relayThread.start();
+            loopbackHost.startAsync();
+
+            client.setAutoPing(false);
+            client.setPongCallback((rtt, timestamp) -> pongs.incrementAndGet());
+            assertTrue(client.connect(100, "127.0.0.1:7777"));
+            pump(client);
+            client.sendPing();
+            pump(client);
+            assertEquals(1, pongs.get(), "Client should receive the host's pong");
+
+            NeonPacket captured = clientTransport.lastSent();
+            assertTrue(captured.isV2() && captured.headerV2().connectionId() != 0,
+                "Client should send its connection id in a v2 header");
+            long connectionId = captured.headerV2().connectionId();
+
+            attacker.setBlocking(true);
+            attacker.setTimeout(1000);
+            attacker.send(ByteBuffer.wrap(captured.toBytes()), relayAddr);
+            ByteBuffer buffer = ByteBuffer.allocate(256);
+            attacker.receive(buffer);
+            NeonPacket challenge = NeonPacket.fromBytes(java.util.Arrays.copyOf(buffer.array(), buffer.position()));
+            PacketPayload.Ping ping = assertInstanceOf(PacketPayload.Ping.class, challenge.payload(),
+                "Relay should challenge the new address instead of adopting it");
+
+            client.sendPing();
+            pump(client);
+            assertEquals(2, pongs.get(), "Unvalidated address must not take over the peer");
+
+            PacketHeaderV2 echoHeader = PacketHeaderV2.create(PacketType.PONG.getValue(), 0,
+                captured.header().clientId() & 0xFF, 1).withConnectionId(connectionId);
+            NeonPacket echo = new NeonPacket(echoHeader.toV1(), new PacketPayload.Pong(ping.timestamp()), echoHeader);
+            attacker.send(ByteBuffer.wrap(echo.toBytes()), relayAddr);
+            Thread.sleep(SETUP_DELAY_MS);
+
+            attacker.send(ByteBuffer.wrap(captured.toBytes()), relayAddr);
+            buffer.clear();
+            attacker.receive(buffer);
+            NeonPacket reply = NeonPacket.fromBytes(java.util.Arrays.copyOf(buffer.array(), buffer.position()));
+            assertInstanceOf(PacketPayload.Pong.class, reply.payload(),
+                "A validated address should be routed to as the peer");
+        }
+    }
+
+    @Test
+    @Order(15)
+    @DisplayName("A migrated connection should stay verified across relay cleanup")
+    void testMigratedConnectionSurvivesCleanup() throws Exception {
+        NeonConfig config = new NeonConfig().setMaxHeaderVersion(2).setHostProcessingLoopSleepMs(1)
+            .setRelayCleanupIntervalMs(50);
+        LoopbackTransport.Network network = new LoopbackTransport.Network();
+        RecordingTransport clientTransport = new RecordingTransport(new LoopbackTransport(network));
+        AtomicInteger pongs = new AtomicInteger();
+        AtomicInteger received = new AtomicInteger();
+
+        try (NeonRelay loopbackRelay = new NeonRelay(LoopbackTransport.bound(network, 7777), config);
+             NeonHost loopbackHost = new NeonHost(100, "127.0.0.1:7777", config, new LoopbackTransport(network));
+             NeonClient client = new NeonClient("rebinding", config, clientTransport)) {
+            Thread relayThread = new Thread(() -> {
+                try {
+                    loopbackRelay.startAndRun();
+                } catch (Exception e) {
+                    // Expected when relay is closed
+                }
+            });
+            relayThread.setDaemon(true);
+            relayThread.start();
+            loopbackHost.startAsync();
+
+            client.setAutoPing(false);
+            client.setPongCallback((rtt, timestamp) -> pongs.incrementAndGet());
+            client.setUnhandledPacketCallback((type, sender) -> received.incrementAndGet());
+            assertTrue(client.connect(100, "127.0.0.1:7777"));
+            byte clientId = client.getClientId().orElseThrow();
+
+            LoopbackTransport rebound = LoopbackTransport.bound(network, 0);
+            rebound.setBlocking(true);
+            rebound.setTimeout(config.getClientSocketTimeoutMs());
+            clientTransport.rebind(rebound);
+            client.sendPing();
+            pump(client);
+            client.sendPing();
+            pump(client);
+            assertTrue(pongs.get() >= 1, "Client should be reachable at its new address");
+
+            Thread.sleep(4 * config.getRelayCleanupIntervalMs());
+            loopbackHost.sendGamePacket((byte) 0x20, clientId, new byte[1000]);
+            pump(client);
+            assertEquals(1, received.get(),
+                "Cleanup must not reset the amplification verification of a migrated peer");
+        }
+    }
+
+    @Test
+    @Order(16)
+    @DisplayName("An encrypted session should never give a client id to a second client")
+    void testEncryptedSessionRetiresClientIds() throws Exception {
+        NeonConfig config = new NeonConfig().setSessionEncryption("aes-gcm").setHostReliabilityDelayMs(0)
+            .setHostProcessingLoopSleepMs(1).setHostSessionTokenTimeoutMs(1);
+        LoopbackTransport.Network network = new LoopbackTransport.Network();
+
+        try (LoopbackTransport fakeRelay = LoopbackTransport.bound(network, 7777);
+             NeonHost encryptedHost = new NeonHost(100, "127.0.0.1:7777", config, new LoopbackTransport(network))) {
+            fakeRelay.setBlocking(true);
+            fakeRelay.setTimeout(2000);
+            encryptedHost.startAsync();
+            SocketAddress hostAddr = fakeRelay.receive(ByteBuffer.allocate(2048));
+
+            Set<Byte> assigned = new HashSet<>();
+            for (int i = 0; i < 254; i++) {
+                PacketPayload.ConnectAccept accept = assertInstanceOf(PacketPayload.ConnectAccept.class,
+                    join(fakeRelay, hostAddr, "client" + i));
+                assertTrue((accept.assignedClientId() & 0xFF) >= 2, "Broadcast and host ids must not be assigned");
+                assertTrue(assigned.add(accept.assignedClientId()), "Client id handed out twice");
+            }
+
+            NeonPacket notice = NeonPacket.create(PacketType.DISCONNECT_NOTICE, (short) 0, (byte) 2, (byte) 1,
+                new PacketPayload.DisconnectNotice());
+            fakeRelay.send(ByteBuffer.wrap(notice.toBytes()), hostAddr);
+            Thread.sleep(SETUP_DELAY_MS);
+
+            assertInstanceOf(PacketPayload.ConnectDeny.class, join(fakeRelay, hostAddr, "late"),
+                "A released id must not be reused under the same session key");
+        }
+    }
+
+    /**
+     * Forwards a connect request to the host as the relay would and returns the host's answer.
+     */
+    private static PacketPayload join(LoopbackTransport relay, SocketAddress host, String name) throws IOException {
+        PacketPayload.ConnectRequest request = new PacketPayload.ConnectRequest(PacketHeader.VERSION, name, 100, 0,
+            PacketPayload.NO_COOKIE, new KeyExchange().publicKey());
+        NeonPacket packet = NeonPacket.create(PacketType.CONNECT_REQUEST, (short) 0, (byte) 0, (byte) 1, request);
+        relay.send(ByteBuffer.wrap(packet.toBytes()), host);
+
+        ByteBuffer buffer = ByteBuffer.allocate(2048);
+        while (true) {
+            buffer.clear();
+            relay.receive(buffer);
+            PacketPayload payload = NeonPacket.fromBytes(Arrays.copyOf(buffer.array(), buffer.position())).payload();
+            if (payload instanceof PacketPayload.ConnectAccept || payload instanceof PacketPayload.ConnectDeny) {
+                return payload;
+            }
+        }
+    }
+
+    private static void pump(NeonClient client) throws Exception {
+        for (int i = 0; i < 20; i++) {
+            client.processPackets();
+            Thread.sleep(10);
+        }
+    }
+
+    /**
+     * Transport decorator that keeps every datagram the client sends, standing in for an
+     * on-path observer, and can move the client to a new address.
+     */
+    private static final class RecordingTransport implements Transport {
+        private volatile Transport transport;
+        private final List<byte[]> sent = new CopyOnWriteArrayList<>();
+
+        RecordingTransport(Transport transport) {
+            this.transport = transport;
+        }
+
+        NeonPacket lastSent() {
+            return NeonPacket.fromBytes(sent.get(sent.size() - 1));
+        }
+
+        /**
+         * Moves to another transport, as a NAT rebinding moves a client to a new source port.
+         */
+        void rebind(Transport next) throws IOException {
+            Transport previous = transport;
+            transport = next;
+            previous.close();
+        }
+
+        @Override
+        public Type getType() {
+            return transport.getType();
+        }
+
+        @Override
+        public void bind(int port) throws IOException {
+            transport.bind(port);
+        }
+
+        @Override
+        public SocketAddress getLocalAddress() {
+            return transport.getLocalAddress();
+        }
+
+        @Override
+        public void send(ByteBuffer data, SocketAddress address) throws IOException {
+            byte[] copy = new byte[data.remaining()];
+            data.duplicate().get(copy);
+            sent.add(copy);
+            transport.send(data, address);
+        }
+
+        @Override
+        public SocketAddress receive(ByteBuffer buffer) throws IOException {
+            return transport.receive(buffer);
+        }
+
+        @Override
+        public void setBlocking(boolean blocking) throws IOException {
+            transport.setBlocking(blocking);
+        }
+
+        @Override
+        public boolean isBlocking() {
+            return transport.isBlocking();
+        }
+
+        @Override
+        public void setTimeout(int timeoutMs) throws IOException {
+            transport.setTimeout(timeoutMs);
+        }
+
+        @Override
+        public boolean isClosed() {
+            return transport.isClosed();
+        }
+
+        @Override
+        public void close() throws IOException {
+            transport.close();
+        }
+    }
 }